@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook;
 
@@ -87,6 +88,25 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  auto smallIntegerStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return std::to_string(row % 100); });
+  auto bigintStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return std::to_string(row * 7'919'000'001'237LL); });
+  auto bigintDictionaryStrings = BaseVector::wrapInDictionary(
+      nullptr,
+      test::makeIndicesInReverse(vectorSize, benchmarkBuilder.pool()),
+      vectorSize,
+      bigintStrings);
+  auto doubleStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return fmt::format("{}.125", row * 37); });
+  auto decimalStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return fmt::format("{}.{:06d}", row * 1'234'567, row); });
+  auto longDecimalStrings = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) {
+        return fmt::format("{}{:016d}.{:010d}", row, row * 99'991, row);
+      });
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -149,6 +169,34 @@ int main(int argc, char** argv) {
           "try_cast_invalid_infinity", "try_cast (invalid_infinity as double)")
       .addExpression("try_cast_space", "try_cast (space as double)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_number",
+          vectorMaker.rowVector(
+              {"small_integer",
+               "bigint",
+               "bigint_dictionary",
+               "fraction",
+               "decimal",
+               "long_decimal"},
+              {smallIntegerStrings,
+               bigintStrings,
+               bigintDictionaryStrings,
+               doubleStrings,
+               decimalStrings,
+               longDecimalStrings}))
+      .addExpression("cast_small_integer", "cast(small_integer as integer)")
+      .addExpression("cast_bigint", "cast(bigint as bigint)")
+      .addExpression("try_cast_bigint", "try_cast(bigint as bigint)")
+      .addExpression(
+          "cast_bigint_dictionary", "cast(bigint_dictionary as bigint)")
+      .addExpression("cast_double", "cast(fraction as double)")
+      .addExpression("cast_real", "cast(decimal as real)")
+      .addExpression("cast_short_decimal", "cast(decimal as decimal(18, 6))")
+      .addExpression(
+          "cast_long_decimal", "cast(long_decimal as decimal(38, 10))")
+      .disableTesting();
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast",
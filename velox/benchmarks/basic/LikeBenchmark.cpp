@@ -15,6 +15,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
@@ -117,6 +118,48 @@ int main(int argc, char** argv) {
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
       .addExpression("generic", R"(like(col0, '%a%b%c'))");
 
+  // OR-lists of LIKE and regexp_like on the same column. 'one_at_a_time'
+  // evaluates every pattern separately, 'multi_pattern' evaluates all of them
+  // in one pass over each string.
+  auto logInput = vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+    return fmt::format(
+        "{} host{} request {} took {}ms",
+        row % 5 == 0 ? "ERROR" : "INFO",
+        row % 97,
+        row * 7919 % 10007,
+        row % 1000);
+  });
+  for (auto numPatterns : {10, 100, 1000}) {
+    std::vector<std::string> conditions;
+    for (auto i = 0; i < numPatterns; ++i) {
+      switch (i % 4) {
+        case 0:
+          conditions.push_back(fmt::format("col0 like '%host{}9 %'", i));
+          break;
+        case 1:
+          conditions.push_back(fmt::format("col0 like 'WARN{}%'", i));
+          break;
+        case 2:
+          conditions.push_back(fmt::format("col0 like '%took {}ms'", i));
+          break;
+        default:
+          conditions.push_back(
+              fmt::format("regexp_like(col0, 'request {}[0-9]+ ')", i));
+      }
+    }
+    const auto expression = folly::join(" OR ", conditions);
+
+    auto& benchmarkSet = benchmarkBuilder.addBenchmarkSet(
+        fmt::format("or_{}_patterns", numPatterns),
+        vectorMaker.rowVector({"col0"}, {logInput}));
+
+    auto rewrites = std::move(exec::expressionRewrites());
+    exec::expressionRewrites().clear();
+    benchmarkSet.addExpression("one_at_a_time", expression);
+    exec::expressionRewrites() = std::move(rewrites);
+    benchmarkSet.addExpression("multi_pattern", expression);
+  }
+
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
   folly::runBenchmarks();
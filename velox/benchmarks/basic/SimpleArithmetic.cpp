@@ -19,12 +19,25 @@
 
 #include <gflags/gflags.h>
 
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/CheckedArithmeticImpl.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/ArithmeticImpl.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
+/// Benchmark for simple arithmetic functions.
+///
+/// The arithmeticTree* and multiplyNestedDeep* benchmarks compare trees of
+/// floating point arithmetic evaluated call by call with the same trees
+/// compiled into a single FusedArithmeticExpr. The BENCHMARK_RELATIVE rows
+/// run with expression.fuse_arithmetic enabled and report the speedup over
+/// the unfused row above them. To compare, build with
+/// 'make benchmarks-basic-build' and run:
+///
+///   _build/release/velox/benchmarks/basic/velox_benchmark_basic_simple_arithmetic
+///       --bm_regex='arithmeticTree.*|multiplyNestedDeep.*'
+
 DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
 
 using namespace facebook::velox;
@@ -72,6 +85,24 @@ struct PlusFunction {
   }
 };
 
+template <typename T>
+struct MinusFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(TInput& result, const TInput& a, const TInput& b) {
+    result = functions::minus(a, b);
+  }
+};
+
+template <typename T>
+struct DivideFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(TInput& result, const TInput& a, const TInput& b) {
+    result = functions::divide(a, b);
+  }
+};
+
 template <typename T>
 struct CheckedPlusFunction {
   template <typename TInput>
@@ -96,6 +127,17 @@ class SimpleArithmeticBenchmark
     registerFunction<CheckedPlusFunction, int64_t, int64_t, int64_t>(
         {"checked_plus"});
 
+    // Floating point arithmetic that may be fused into a single expression.
+    registerFunction<PlusFunction, double, double, double>({"plus"});
+    registerFunction<MinusFunction, double, double, double>({"minus"});
+    registerFunction<DivideFunction, double, double, double>({"divide"});
+    exec::registerFusedArithmeticOp("plus", exec::FusedArithmeticOp::kPlus);
+    exec::registerFusedArithmeticOp("minus", exec::FusedArithmeticOp::kMinus);
+    exec::registerFusedArithmeticOp(
+        "multiply", exec::FusedArithmeticOp::kMultiply);
+    exec::registerFusedArithmeticOp(
+        "divide", exec::FusedArithmeticOp::kDivide);
+
     // Set input schema.
     inputType_ = ROW({
         {"a", DOUBLE()},
@@ -137,22 +179,29 @@ class SimpleArithmeticBenchmark
   static constexpr auto kIterationsMeduim = 1000;
   static constexpr auto kIterationsLarge = 100;
 
-  void runSmall(const std::string& expression) {
-    run(expression, kIterationsSmall, smallRowVector_);
+  void runSmall(const std::string& expression, bool fuse = false) {
+    run(expression, kIterationsSmall, smallRowVector_, fuse);
   }
 
-  void runMedium(const std::string& expression) {
-    run(expression, kIterationsMeduim, mediumRowVector_);
+  void runMedium(const std::string& expression, bool fuse = false) {
+    run(expression, kIterationsMeduim, mediumRowVector_, fuse);
   }
 
-  void runLarge(const std::string& expression) {
-    run(expression, kIterationsLarge, largeRowVector_);
+  void runLarge(const std::string& expression, bool fuse = false) {
+    run(expression, kIterationsLarge, largeRowVector_, fuse);
   }
 
-  // Runs `expression` `times` thousand times.
-  size_t
-  run(const std::string& expression, size_t times, const RowVectorPtr& input) {
+  // Runs `expression` `times` thousand times. If 'fuse' is true, trees of
+  // floating point arithmetic are compiled into a single fused expression.
+  size_t run(
+      const std::string& expression,
+      size_t times,
+      const RowVectorPtr& input,
+      bool fuse) {
     folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFuseArithmetic, fuse ? "true" : "false"},
+    });
     auto exprSet = compileExpression(expression, inputType_);
     suspender.dismiss();
 
@@ -226,6 +275,30 @@ BENCHMARK(plusCheckedSmall) {
   benchmark->runSmall("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(arithmeticTreeSmall) {
+  benchmark->runSmall("minus(divide(plus(multiply(a, constant), b), a), b)");
+}
+
+BENCHMARK_RELATIVE(arithmeticTreeFusedSmall) {
+  benchmark->runSmall(
+      "minus(divide(plus(multiply(a, constant), b), a), b)", true);
+}
+
+BENCHMARK(multiplyNestedDeepSmallUnfused) {
+  benchmark->runSmall(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))");
+}
+
+BENCHMARK_RELATIVE(multiplyNestedDeepFusedSmall) {
+  benchmark->runSmall(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))",
+      true);
+}
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_DRAW_LINE();
 
@@ -283,6 +356,30 @@ BENCHMARK(plusCheckedMedium) {
   benchmark->runMedium("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(arithmeticTreeMedium) {
+  benchmark->runMedium("minus(divide(plus(multiply(a, constant), b), a), b)");
+}
+
+BENCHMARK_RELATIVE(arithmeticTreeFusedMedium) {
+  benchmark->runMedium(
+      "minus(divide(plus(multiply(a, constant), b), a), b)", true);
+}
+
+BENCHMARK(multiplyNestedDeepMediumUnfused) {
+  benchmark->runMedium(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))");
+}
+
+BENCHMARK_RELATIVE(multiplyNestedDeepFusedMedium) {
+  benchmark->runMedium(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))",
+      true);
+}
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_DRAW_LINE();
 
@@ -340,6 +437,30 @@ BENCHMARK(plusCheckedLarge) {
   benchmark->runLarge("checked_plus(c, d)");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(arithmeticTreeLarge) {
+  benchmark->runLarge("minus(divide(plus(multiply(a, constant), b), a), b)");
+}
+
+BENCHMARK_RELATIVE(arithmeticTreeFusedLarge) {
+  benchmark->runLarge(
+      "minus(divide(plus(multiply(a, constant), b), a), b)", true);
+}
+
+BENCHMARK(multiplyNestedDeepLargeUnfused) {
+  benchmark->runLarge(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))");
+}
+
+BENCHMARK_RELATIVE(multiplyNestedDeepFusedLarge) {
+  benchmark->runLarge(
+      "multiply(multiply(multiply(a, b), a), "
+      "multiply(a, multiply(a, b)))",
+      true);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SpillDirectories.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#include <folly/futures/Future.h>
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::common {
+namespace {
+// Returns the id of the device that holds 'path'. The directory may not be
+// created yet, so this checks the nearest existing ancestor. Returns 'path'
+// itself if it is not on a local file system.
+std::string lookupDeviceId(const std::string& path) {
+  std::filesystem::path current(path);
+  while (!current.empty()) {
+    struct stat st;
+    if (::stat(current.c_str(), &st) == 0) {
+      return fmt::format("dev:{}", st.st_dev);
+    }
+    if (current == current.parent_path()) {
+      break;
+    }
+    current = current.parent_path();
+  }
+  return path;
+}
+} // namespace
+
+SpillDirectoryPlacement spillDirectoryPlacementFromString(
+    const std::string& placement) {
+  if (placement == "round_robin") {
+    return SpillDirectoryPlacement::kRoundRobin;
+  }
+  if (placement == "least_loaded") {
+    return SpillDirectoryPlacement::kLeastLoaded;
+  }
+  VELOX_USER_FAIL("Unsupported spill directory placement: {}", placement);
+}
+
+std::string spillDirectoryPlacementToString(
+    SpillDirectoryPlacement placement) {
+  switch (placement) {
+    case SpillDirectoryPlacement::kRoundRobin:
+      return "round_robin";
+    case SpillDirectoryPlacement::kLeastLoaded:
+      return "least_loaded";
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+SpillDirectories::SpillDirectories(
+    std::vector<std::string> paths,
+    SpillDirectoryPlacement placement,
+    uint32_t maxQueueDepth,
+    uint64_t maxWaitMs,
+    const std::vector<std::string>& deviceIds)
+    : placement_(placement),
+      maxQueueDepth_(maxQueueDepth),
+      maxWaitMs_(maxWaitMs) {
+  VELOX_CHECK(!paths.empty(), "No spill directory specified");
+  VELOX_CHECK(deviceIds.empty() || deviceIds.size() == paths.size());
+  directories_.reserve(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    VELOX_CHECK(!paths[i].empty(), "Empty spill directory path");
+    auto device = getDevice(
+        deviceIds.empty() ? lookupDeviceId(paths[i]) : deviceIds[i]);
+    directories_.push_back(
+        std::make_unique<Directory>(std::move(paths[i]), std::move(device)));
+  }
+}
+
+// static
+std::shared_ptr<SpillDirectories::Device> SpillDirectories::getDevice(
+    const std::string& id) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<Device>> devices;
+  std::lock_guard<std::mutex> l(mutex);
+  auto& entry = devices[id];
+  auto device = entry.lock();
+  if (device == nullptr) {
+    device = std::make_shared<Device>(id);
+    entry = device;
+  }
+  return device;
+}
+
+uint32_t SpillDirectories::selectDirectory() {
+  const uint32_t numDirectories = directories_.size();
+  const uint32_t start = nextDirectory_++ % numDirectories;
+  uint32_t selected = start;
+  if (placement_ == SpillDirectoryPlacement::kLeastLoaded) {
+    // Scans from the round-robin start so that ties are spread evenly.
+    uint32_t minQueueDepth = directories_[start]->device->queueDepth;
+    for (uint32_t i = 1; i < numDirectories && minQueueDepth > 0; ++i) {
+      const uint32_t index = (start + i) % numDirectories;
+      const uint32_t queueDepth = directories_[index]->device->queueDepth;
+      if (queueDepth < minQueueDepth) {
+        minQueueDepth = queueDepth;
+        selected = index;
+      }
+    }
+  } else if (saturated(start)) {
+    // Skips the saturated directories if there is any unsaturated one.
+    for (uint32_t i = 1; i < numDirectories; ++i) {
+      const uint32_t index = (start + i) % numDirectories;
+      if (!saturated(index)) {
+        selected = index;
+        break;
+      }
+    }
+  }
+  ++directories_[selected]->numFiles;
+  return selected;
+}
+
+bool SpillDirectories::allSaturated() const {
+  for (const auto& directory : directories_) {
+    if (!saturated(*directory->device)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SpillDirectories::checkSaturated(ContinueFuture* future) {
+  if (maxQueueDepth_ == 0) {
+    return false;
+  }
+  std::vector<Device*> devices;
+  std::vector<ContinueFuture> futures;
+  for (const auto& directory : directories_) {
+    auto* device = directory->device.get();
+    if (std::find(devices.begin(), devices.end(), device) != devices.end()) {
+      continue;
+    }
+    // Checks under the device lock so that a write finishing after the check
+    // fulfills the promise. A promise left behind by an early return is
+    // fulfilled by the next finished write with no one waiting on it.
+    std::lock_guard<std::mutex> l(device->mutex);
+    if (!saturated(*device)) {
+      return false;
+    }
+    auto [promise, deviceFuture] = makeVeloxContinuePromiseContract(
+        fmt::format("SpillDirectories::checkSaturated {}", device->id));
+    device->promises.push_back(std::move(promise));
+    devices.push_back(device);
+    futures.push_back(std::move(deviceFuture));
+  }
+  for (auto* device : devices) {
+    ++device->numWaits;
+  }
+  *future = folly::collectAny(std::move(futures))
+                .deferValue([](auto&& /* unused */) {})
+                .within(std::chrono::milliseconds(maxWaitMs_))
+                .deferError(
+                    folly::tag_t<folly::FutureTimeout>{},
+                    [](const folly::FutureTimeout&) {});
+  return true;
+}
+
+uint32_t SpillDirectories::startWrite(uint32_t index) {
+  auto& device = *directories_[index]->device;
+  const uint32_t queueDepth = ++device.queueDepth;
+  uint32_t maxQueueDepth = device.maxQueueDepth;
+  while (queueDepth > maxQueueDepth &&
+         !device.maxQueueDepth.compare_exchange_weak(
+             maxQueueDepth, queueDepth)) {
+  }
+  return queueDepth;
+}
+
+void SpillDirectories::finishWrite(
+    uint32_t index,
+    uint64_t bytes,
+    uint64_t writeTimeNs) {
+  auto& device = *directories_[index]->device;
+  VELOX_CHECK_GT(device.queueDepth, 0);
+  --device.queueDepth;
+  ++device.numWrites;
+  device.writtenBytes += bytes;
+  device.writeTimeNanos += writeTimeNs;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(device.mutex);
+    promises.swap(device.promises);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::vector<SpillDirectories::Stats> SpillDirectories::stats() const {
+  std::vector<Stats> stats;
+  stats.reserve(directories_.size());
+  for (const auto& directory : directories_) {
+    const auto& device = *directory->device;
+    stats.push_back(Stats{
+        directory->path,
+        device.id,
+        directory->numFiles,
+        device.numWrites,
+        device.writtenBytes,
+        device.writeTimeNanos,
+        device.queueDepth,
+        device.maxQueueDepth,
+        device.numWaits});
+  }
+  return stats;
+}
+
+uint64_t SpillDirectories::Stats::bytesPerSecond() const {
+  if (writeTimeNanos == 0) {
+    return 0;
+  }
+  return writtenBytes * 1'000'000'000.0 / writeTimeNanos;
+}
+
+std::string SpillDirectories::Stats::toString() const {
+  return fmt::format(
+      "path[{}] device[{}] numFiles[{}] numWrites[{}] writtenBytes[{}] "
+      "writeTimeNanos[{}] bandwidth[{}/s] queueDepth[{}] maxQueueDepth[{}] "
+      "numWaits[{}]",
+      path,
+      deviceId,
+      numFiles,
+      numWrites,
+      succinctBytes(writtenBytes),
+      succinctNanos(writeTimeNanos),
+      succinctBytes(bytesPerSecond()),
+      queueDepth,
+      maxQueueDepth,
+      numWaits);
+}
+} // namespace facebook::velox::common
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/future/VeloxPromise.h"
+
+namespace facebook::velox::common {
+
+/// Specifies how SpillDirectories places a new spill file.
+enum class SpillDirectoryPlacement {
+  /// Rotates through the directories file by file.
+  kRoundRobin,
+  /// Picks the directory with the fewest in-flight writes.
+  kLeastLoaded,
+};
+
+SpillDirectoryPlacement spillDirectoryPlacementFromString(
+    const std::string& placement);
+
+std::string spillDirectoryPlacementToString(SpillDirectoryPlacement placement);
+
+/// Stripes spill files across a set of directories, typically one per local
+/// disk, so that spill write throughput scales with the number of disks. It
+/// tracks the in-flight writes and the write bandwidth of the device of each
+/// directory. The device accounting is process wide, so the writes of all the
+/// tasks that spill to the same disk count towards its queue depth. When all
+/// the devices are saturated, drivers block on a future until a write
+/// finishes instead of starting more spill writes.
+///
+/// NOTE: this object is thread-safe and is shared by all the spilling
+/// operators of a task.
+class SpillDirectories {
+ public:
+  /// 'maxQueueDepth' is the max number of in-flight writes per device before
+  /// it is saturated. Zero means no limit. 'maxWaitMs' caps the time that a
+  /// driver blocks while all the devices are saturated. 'deviceIds'
+  /// identifies the device of each of 'paths'. If empty, the device is looked
+  /// up from the file system.
+  SpillDirectories(
+      std::vector<std::string> paths,
+      SpillDirectoryPlacement placement,
+      uint32_t maxQueueDepth = 0,
+      uint64_t maxWaitMs = 1'000,
+      const std::vector<std::string>& deviceIds = {});
+
+  size_t size() const {
+    return directories_.size();
+  }
+
+  const std::string& path(uint32_t index) const {
+    return directories_[index]->path;
+  }
+
+  SpillDirectoryPlacement placement() const {
+    return placement_;
+  }
+
+  /// Returns the index of the directory to place a new spill file.
+  uint32_t selectDirectory();
+
+  /// Returns true if the device of directory 'index' is saturated.
+  bool saturated(uint32_t index) const {
+    return saturated(*directories_[index]->device);
+  }
+
+  /// Returns true if the devices of all the directories are saturated.
+  bool allSaturated() const;
+
+  /// Returns true if the devices of all the directories are saturated, in
+  /// which case 'future' is set to a future that is fulfilled when a write to
+  /// any of them finishes or after the max wait time. A driver blocks on it
+  /// rather than running an operator that may spill.
+  bool checkSaturated(ContinueFuture* future);
+
+  /// Invoked before and after a write to directory 'index' to track the queue
+  /// depth and write bandwidth of its device. startWrite() returns the queue
+  /// depth including the started write.
+  uint32_t startWrite(uint32_t index);
+  void finishWrite(uint32_t index, uint64_t bytes, uint64_t writeTimeNs);
+
+  /// The per-directory write stats. Except for 'numFiles', they cover all the
+  /// writes to the device of the directory in the process.
+  struct Stats {
+    std::string path;
+    std::string deviceId;
+    uint64_t numFiles{0};
+    uint64_t numWrites{0};
+    uint64_t writtenBytes{0};
+    uint64_t writeTimeNanos{0};
+    uint32_t queueDepth{0};
+    /// The max observed number of in-flight writes.
+    uint32_t maxQueueDepth{0};
+    /// The number of times that a driver blocked as the device was saturated.
+    uint64_t numWaits{0};
+
+    /// Returns the average write bandwidth in bytes per second.
+    uint64_t bytesPerSecond() const;
+
+    std::string toString() const;
+  };
+
+  std::vector<Stats> stats() const;
+
+ private:
+  // The process wide write accounting of a device.
+  struct Device {
+    explicit Device(std::string _id) : id(std::move(_id)) {}
+
+    const std::string id;
+    std::atomic<uint64_t> numWrites{0};
+    std::atomic<uint64_t> writtenBytes{0};
+    std::atomic<uint64_t> writeTimeNanos{0};
+    std::atomic<uint32_t> queueDepth{0};
+    std::atomic<uint32_t> maxQueueDepth{0};
+    std::atomic<uint64_t> numWaits{0};
+
+    std::mutex mutex;
+    // Fulfilled when a write to the device finishes.
+    std::vector<ContinuePromise> promises;
+  };
+
+  struct Directory {
+    Directory(std::string _path, std::shared_ptr<Device> _device)
+        : path(std::move(_path)), device(std::move(_device)) {}
+
+    const std::string path;
+    const std::shared_ptr<Device> device;
+    std::atomic<uint64_t> numFiles{0};
+  };
+
+  // Returns the device with 'id', creating it if no directory in the process
+  // uses it.
+  static std::shared_ptr<Device> getDevice(const std::string& id);
+
+  bool saturated(const Device& device) const {
+    return maxQueueDepth_ != 0 && device.queueDepth >= maxQueueDepth_;
+  }
+
+  const SpillDirectoryPlacement placement_;
+  const uint32_t maxQueueDepth_;
+  const uint64_t maxWaitMs_;
+  std::vector<std::unique_ptr<Directory>> directories_;
+  std::atomic<uint32_t> nextDirectory_{0};
+};
+} // namespace facebook::velox::common
@@ -92,6 +92,9 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillReads += other.spillReads;
   spillReadTimeNanos += other.spillReadTimeNanos;
   spillDeserializationTimeNanos += other.spillDeserializationTimeNanos;
+  for (const auto& [path, directoryStats] : other.spillDirectoryStats) {
+    spillDirectoryStats[path] += directoryStats;
+  }
   return *this;
 }
 
@@ -121,6 +124,11 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillReadTimeNanos = spillReadTimeNanos - other.spillReadTimeNanos;
   result.spillDeserializationTimeNanos =
       spillDeserializationTimeNanos - other.spillDeserializationTimeNanos;
+  result.spillDirectoryStats = spillDirectoryStats;
+  for (const auto& [path, directoryStats] : other.spillDirectoryStats) {
+    auto& resultStats = result.spillDirectoryStats[path];
+    resultStats = resultStats - directoryStats;
+  }
   return result;
 }
 
@@ -194,7 +202,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos) ==
+             spillDeserializationTimeNanos,
+             spillDirectoryStats) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -213,7 +222,8 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillReadBytes,
              spillReads,
              spillReadTimeNanos,
-             spillDeserializationTimeNanos);
+             spillDeserializationTimeNanos,
+             other.spillDirectoryStats);
 }
 
 void SpillStats::reset() {
@@ -235,10 +245,11 @@ void SpillStats::reset() {
   spillReads = 0;
   spillReadTimeNanos = 0;
   spillDeserializationTimeNanos = 0;
+  spillDirectoryStats.clear();
 }
 
 std::string SpillStats::toString() const {
-  return fmt::format(
+  auto result = fmt::format(
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
       "spilledPartitions[{}] spilledFiles[{}] spillFillTimeNanos[{}] "
       "spillSortTimeNanos[{}] spillExtractVectorTime[{}] spillSerializationTimeNanos[{}] spillWrites[{}] "
@@ -263,6 +274,67 @@ std::string SpillStats::toString() const {
       spillReads,
       succinctNanos(spillReadTimeNanos),
       succinctNanos(spillDeserializationTimeNanos));
+  for (const auto& [path, directoryStats] : spillDirectoryStats) {
+    result += fmt::format(
+        " spillDirectory[{}: {}]", path, directoryStats.toString());
+  }
+  return result;
+}
+
+uint64_t SpillDirectoryStats::bytesPerSecond() const {
+  if (spillWriteTimeNanos == 0) {
+    return 0;
+  }
+  return spilledBytes * 1'000'000'000.0 / spillWriteTimeNanos;
+}
+
+SpillDirectoryStats& SpillDirectoryStats::operator+=(
+    const SpillDirectoryStats& other) {
+  spilledFiles += other.spilledFiles;
+  spillWrites += other.spillWrites;
+  spilledBytes += other.spilledBytes;
+  spillWriteTimeNanos += other.spillWriteTimeNanos;
+  maxQueueDepth = std::max(maxQueueDepth, other.maxQueueDepth);
+  return *this;
+}
+
+SpillDirectoryStats SpillDirectoryStats::operator-(
+    const SpillDirectoryStats& other) const {
+  SpillDirectoryStats result;
+  result.spilledFiles = spilledFiles - other.spilledFiles;
+  result.spillWrites = spillWrites - other.spillWrites;
+  result.spilledBytes = spilledBytes - other.spilledBytes;
+  result.spillWriteTimeNanos = spillWriteTimeNanos - other.spillWriteTimeNanos;
+  // The max is not a counter, so the delta keeps the latest value.
+  result.maxQueueDepth = maxQueueDepth;
+  return result;
+}
+
+bool SpillDirectoryStats::operator==(const SpillDirectoryStats& other) const {
+  return std::tie(
+             spilledFiles,
+             spillWrites,
+             spilledBytes,
+             spillWriteTimeNanos,
+             maxQueueDepth) ==
+      std::tie(
+             other.spilledFiles,
+             other.spillWrites,
+             other.spilledBytes,
+             other.spillWriteTimeNanos,
+             other.maxQueueDepth);
+}
+
+std::string SpillDirectoryStats::toString() const {
+  return fmt::format(
+      "spilledFiles[{}] spillWrites[{}] spilledBytes[{}] "
+      "spillWriteTimeNanos[{}] bandwidth[{}/s] maxQueueDepth[{}]",
+      spilledFiles,
+      spillWrites,
+      succinctBytes(spilledBytes),
+      succinctNanos(spillWriteTimeNanos),
+      succinctBytes(bytesPerSecond()),
+      maxQueueDepth);
 }
 
 void updateGlobalSpillRunStats(uint64_t numRuns) {
@@ -318,6 +390,15 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeNanos += writeTimeNs;
 }
 
+void updateGlobalSpillFooterWriteStats(
+    uint64_t spilledBytes,
+    uint64_t writeTimeNs) {
+  RECORD_METRIC_VALUE(kMetricSpilledBytes, spilledBytes);
+  auto statsLocked = localSpillStats().wlock();
+  statsLocked->spilledBytes += spilledBytes;
+  statsLocked->spillWriteTimeNanos += writeTimeNs;
+}
+
 void updateGlobalSpillReadStats(
     uint64_t spillReads,
     uint64_t spillReadBytes,
@@ -17,12 +17,38 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <map>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
+/// Provides the spill write stats of one spill directory when the spill files
+/// are striped across multiple directories.
+struct SpillDirectoryStats {
+  /// The number of spilled files placed in the directory.
+  uint64_t spilledFiles{0};
+  /// The number of writes to the directory.
+  uint64_t spillWrites{0};
+  /// The number of bytes written to the directory.
+  uint64_t spilledBytes{0};
+  /// The time spent on writing to the directory.
+  uint64_t spillWriteTimeNanos{0};
+  /// The max number of in-flight writes to the device of the directory,
+  /// including the writes of other operators, seen by a write.
+  uint32_t maxQueueDepth{0};
+
+  /// Returns the write bandwidth in bytes per second.
+  uint64_t bytesPerSecond() const;
+
+  SpillDirectoryStats& operator+=(const SpillDirectoryStats& other);
+  SpillDirectoryStats operator-(const SpillDirectoryStats& other) const;
+  bool operator==(const SpillDirectoryStats& other) const;
+
+  std::string toString() const;
+};
+
 /// Provides the fine-grained spill execution stats.
 struct SpillStats {
   /// The number of times that spilling runs on an operator.
@@ -68,6 +94,9 @@ struct SpillStats {
   uint64_t spillReadTimeNanos{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeNanos{0};
+  /// The write stats of each spill directory keyed by the directory path. Only
+  /// set if the spill files are striped across multiple directories.
+  std::map<std::string, SpillDirectoryStats> spillDirectoryStats;
 
   SpillStats(
       uint64_t _spillRuns,
@@ -147,6 +176,13 @@ void updateGlobalSpillWriteStats(
     uint64_t flushTimeNs,
     uint64_t writeTimeNs);
 
+/// Updates the written bytes and the time spent on disk writes for the spill
+/// file footer. Unlike updateGlobalSpillWriteStats(), this is not counted as a
+/// separate disk write.
+void updateGlobalSpillFooterWriteStats(
+    uint64_t spilledBytes,
+    uint64_t writeTimeNs);
+
 /// Updates the stats for disk read including the number of disk reads, the
 /// amount of data read in bytes, and the time it takes to read from the disk.
 void updateGlobalSpillReadStats(
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SpillDirectories.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+
+TEST(SpillDirectoriesTest, placement) {
+  ASSERT_EQ(
+      spillDirectoryPlacementFromString("round_robin"),
+      SpillDirectoryPlacement::kRoundRobin);
+  ASSERT_EQ(
+      spillDirectoryPlacementFromString("least_loaded"),
+      SpillDirectoryPlacement::kLeastLoaded);
+  VELOX_ASSERT_THROW(
+      spillDirectoryPlacementFromString("random"),
+      "Unsupported spill directory placement: random");
+  ASSERT_EQ(
+      spillDirectoryPlacementToString(SpillDirectoryPlacement::kLeastLoaded),
+      "least_loaded");
+
+  VELOX_ASSERT_THROW(
+      SpillDirectories({}, SpillDirectoryPlacement::kRoundRobin),
+      "No spill directory specified");
+  VELOX_ASSERT_THROW(
+      SpillDirectories({"/a", ""}, SpillDirectoryPlacement::kRoundRobin),
+      "Empty spill directory path");
+}
+
+TEST(SpillDirectoriesTest, roundRobin) {
+  SpillDirectories directories(
+      {"/disk0", "/disk1", "/disk2"},
+      SpillDirectoryPlacement::kRoundRobin,
+      1,
+      1'000,
+      {"roundRobin0", "roundRobin1", "roundRobin2"});
+  ASSERT_EQ(directories.size(), 3);
+  ASSERT_EQ(directories.path(1), "/disk1");
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(directories.selectDirectory(), i % 3);
+  }
+
+  // Skips the saturated directory.
+  directories.startWrite(0);
+  ASSERT_EQ(directories.selectDirectory(), 1);
+  ASSERT_EQ(directories.selectDirectory(), 1);
+  ASSERT_EQ(directories.selectDirectory(), 2);
+  directories.finishWrite(0, 1024, 1'000);
+  ASSERT_EQ(directories.selectDirectory(), 0);
+
+  const auto stats = directories.stats();
+  ASSERT_EQ(stats.size(), 3);
+  ASSERT_EQ(stats[0].numFiles, 3);
+  ASSERT_EQ(stats[1].numFiles, 4);
+  ASSERT_EQ(stats[2].numFiles, 3);
+  ASSERT_EQ(stats[0].numWrites, 1);
+  ASSERT_EQ(stats[0].writtenBytes, 1024);
+  ASSERT_EQ(stats[0].queueDepth, 0);
+  ASSERT_EQ(stats[0].maxQueueDepth, 1);
+  ASSERT_EQ(stats[0].bytesPerSecond(), 1024'000'000);
+  ASSERT_EQ(stats[1].bytesPerSecond(), 0);
+}
+
+TEST(SpillDirectoriesTest, leastLoaded) {
+  SpillDirectories directories(
+      {"/disk0", "/disk1", "/disk2"},
+      SpillDirectoryPlacement::kLeastLoaded,
+      0,
+      1'000,
+      {"leastLoaded0", "leastLoaded1", "leastLoaded2"});
+  directories.startWrite(0);
+  directories.startWrite(0);
+  directories.startWrite(1);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(directories.selectDirectory(), 2);
+  }
+  directories.startWrite(2);
+  directories.startWrite(2);
+  ASSERT_EQ(directories.selectDirectory(), 1);
+  directories.finishWrite(0, 0, 0);
+  directories.finishWrite(0, 0, 0);
+  ASSERT_EQ(directories.selectDirectory(), 0);
+  ASSERT_EQ(directories.stats()[0].maxQueueDepth, 2);
+}
+
+TEST(SpillDirectoriesTest, checkSaturated) {
+  ContinueFuture future;
+  SpillDirectories unlimited(
+      {"/disk0", "/disk1"},
+      SpillDirectoryPlacement::kRoundRobin,
+      0,
+      1'000,
+      {"unlimited0", "unlimited1"});
+  unlimited.startWrite(0);
+  unlimited.startWrite(1);
+  ASSERT_FALSE(unlimited.checkSaturated(&future));
+  unlimited.finishWrite(0, 0, 0);
+  unlimited.finishWrite(1, 0, 0);
+
+  SpillDirectories directories(
+      {"/disk0", "/disk1"},
+      SpillDirectoryPlacement::kRoundRobin,
+      1,
+      60'000,
+      {"saturated0", "saturated1"});
+  ASSERT_EQ(directories.startWrite(0), 1);
+  ASSERT_TRUE(directories.saturated(0));
+  ASSERT_FALSE(directories.allSaturated());
+  ASSERT_FALSE(directories.checkSaturated(&future));
+  ASSERT_FALSE(future.valid());
+
+  directories.startWrite(1);
+  ASSERT_TRUE(directories.allSaturated());
+  ASSERT_TRUE(directories.checkSaturated(&future));
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+  // A finished write to any of the devices unblocks the waiter.
+  directories.finishWrite(1, 0, 0);
+  std::move(future).get(std::chrono::seconds(10));
+  const auto stats = directories.stats();
+  ASSERT_EQ(stats[0].numWaits, 1);
+  ASSERT_EQ(stats[1].numWaits, 1);
+  directories.finishWrite(0, 0, 0);
+
+  // Gives up after the max wait time if the devices stay saturated.
+  SpillDirectories timeout(
+      {"/disk0"}, SpillDirectoryPlacement::kRoundRobin, 1, 10, {"timeout"});
+  timeout.startWrite(0);
+  ASSERT_TRUE(timeout.checkSaturated(&future));
+  std::move(future).get(std::chrono::seconds(10));
+  timeout.finishWrite(0, 0, 0);
+  ASSERT_FALSE(timeout.checkSaturated(&future));
+}
+
+TEST(SpillDirectoriesTest, sharedDevice) {
+  // The directories of different tasks on the same device share its queue
+  // depth.
+  SpillDirectories task1(
+      {"/disk0/task1"},
+      SpillDirectoryPlacement::kRoundRobin,
+      1,
+      1'000,
+      {"sharedDevice"});
+  SpillDirectories task2(
+      {"/disk0/task2", "/disk1/task2"},
+      SpillDirectoryPlacement::kRoundRobin,
+      1,
+      1'000,
+      {"sharedDevice", "otherDevice"});
+  task1.startWrite(0);
+  ASSERT_TRUE(task2.saturated(0));
+  ASSERT_FALSE(task2.saturated(1));
+  ASSERT_EQ(task2.selectDirectory(), 1);
+  ASSERT_EQ(task2.selectDirectory(), 1);
+  task1.finishWrite(0, 1024, 1'000);
+  ASSERT_FALSE(task2.saturated(0));
+
+  const auto stats = task2.stats();
+  ASSERT_EQ(stats[0].deviceId, "sharedDevice");
+  ASSERT_EQ(stats[0].numFiles, 0);
+  ASSERT_EQ(stats[0].numWrites, 1);
+  ASSERT_EQ(stats[0].writtenBytes, 1024);
+  ASSERT_EQ(stats[1].numFiles, 2);
+  ASSERT_EQ(stats[1].numWrites, 0);
+}
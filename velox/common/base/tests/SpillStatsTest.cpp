@@ -143,3 +143,48 @@ TEST(SpillStatsTest, spillStats) {
       "spillReadBytes[2.00KB] spillReads[10] spillReadTimeNanos[100ns] "
       "spillReadDeserializationTimeNanos[100ns]");
 }
+
+TEST(SpillStatsTest, spillDirectoryStats) {
+  SpillStats stats1;
+  stats1.spillDirectoryStats["/disk0"] = {1, 2, 1024, 1'000, 2};
+  SpillStats stats2;
+  stats2.spillDirectoryStats["/disk0"] = {2, 3, 3072, 2'000, 1};
+  stats2.spillDirectoryStats["/disk1"] = {1, 1, 1024, 0, 1};
+  ASSERT_EQ(
+      stats1.spillDirectoryStats.at("/disk0").bytesPerSecond(), 1024'000'000);
+  ASSERT_EQ(stats2.spillDirectoryStats.at("/disk1").bytesPerSecond(), 0);
+  ASSERT_FALSE(stats1 == stats2);
+
+  SpillStats delta = stats2 - stats1;
+  ASSERT_EQ(delta.spillDirectoryStats.size(), 2);
+  const auto& disk0 = delta.spillDirectoryStats.at("/disk0");
+  ASSERT_EQ(disk0.spilledFiles, 1);
+  ASSERT_EQ(disk0.spillWrites, 1);
+  ASSERT_EQ(disk0.spilledBytes, 2048);
+  ASSERT_EQ(disk0.spillWriteTimeNanos, 1'000);
+  ASSERT_EQ(disk0.maxQueueDepth, 1);
+
+  stats1 += stats2;
+  ASSERT_EQ(stats1.spillDirectoryStats.size(), 2);
+  ASSERT_EQ(stats1.spillDirectoryStats.at("/disk0").spilledBytes, 4096);
+  ASSERT_EQ(stats1.spillDirectoryStats.at("/disk0").maxQueueDepth, 2);
+  ASSERT_EQ(stats1.spillDirectoryStats.at("/disk1").spilledFiles, 1);
+  ASSERT_EQ(
+      stats2.toString(),
+      "spillRuns[0] spilledInputBytes[0B] spilledBytes[0B] spilledRows[0] "
+      "spilledPartitions[0] spilledFiles[0] spillFillTimeNanos[0ns] "
+      "spillSortTimeNanos[0ns] spillExtractVectorTime[0ns] "
+      "spillSerializationTimeNanos[0ns] spillWrites[0] "
+      "spillFlushTimeNanos[0ns] spillWriteTimeNanos[0ns] "
+      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
+      "spillReadTimeNanos[0ns] spillReadDeserializationTimeNanos[0ns] "
+      "spillDirectory[/disk0: spilledFiles[2] spillWrites[3] "
+      "spilledBytes[3.00KB] spillWriteTimeNanos[2.00us] "
+      "bandwidth[1.43GB/s] maxQueueDepth[1]] "
+      "spillDirectory[/disk1: spilledFiles[1] spillWrites[1] "
+      "spilledBytes[1.00KB] spillWriteTimeNanos[0ns] bandwidth[0B/s] "
+      "maxQueueDepth[1]]");
+
+  stats1.reset();
+  ASSERT_TRUE(stats1.spillDirectoryStats.empty());
+}
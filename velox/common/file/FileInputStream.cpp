@@ -141,10 +141,35 @@ void FileInputStream::doSeek(int64_t skipBytes) {
     if (skipBytes == 0) {
       return;
     }
-    readNextRange();
+    // Consumes the in-flight read-ahead if it covers the seek target.
+    if (readAheadWait_.valid() && skipBytes < readSize()) {
+      readNextRange();
+      continue;
+    }
+    skipRange(skipBytes);
+    return;
   }
 }
 
+void FileInputStream::skipRange(int64_t skipBytes) {
+  VELOX_CHECK_EQ(current_->availableBytes(), 0);
+  if (readAheadWait_.valid()) {
+    // The read-ahead buffer is reused by the next read so we must wait for it
+    // to finish even though its data is discarded.
+    std::move(readAheadWait_)
+        .via(&folly::QueuedImmediateExecutor::instance())
+        .wait();
+    VELOX_CHECK(!readAheadWait_.valid());
+  }
+  fileOffset_ += skipBytes;
+  if (fileOffset_ == fileSize_) {
+    ranges_.clear();
+    current_ = nullptr;
+    return;
+  }
+  readNextRange();
+}
+
 size_t FileInputStream::remainingSize() const {
   return fileSize_ - tellp();
 }
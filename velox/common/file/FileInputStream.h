@@ -74,6 +74,10 @@ class FileInputStream : public ByteInputStream {
  private:
   void doSeek(int64_t skipBytes);
 
+  // Advances the file offset by 'skipBytes' past the end of the current
+  // buffered range without reading the skipped bytes from the file.
+  void skipRange(int64_t skipBytes);
+
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
@@ -223,13 +223,46 @@ void addSortingKeys(
 }
 } // namespace
 
-bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
+namespace {
+// Returns true if all 'aggregates' are over the same unmasked, unsorted
+// distinct inputs. Such aggregations de-duplicate their inputs in a shared
+// hash table that can spill if
+// QueryConfig::kAggregationSharedDistinctHashEnabled is set. Must match the
+// conditions in exec::GroupingSet.
+bool allSameDistinctInputs(
+    const std::vector<AggregationNode::Aggregate>& aggregates) {
+  for (const auto& aggregate : aggregates) {
+    if (!aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    const auto& inputs = aggregate.call->inputs();
+    const auto& firstInputs = aggregates[0].call->inputs();
+    if (inputs.size() != firstInputs.size()) {
       return false;
     }
+    for (auto i = 0; i < inputs.size(); ++i) {
+      if (inputs[i]->toString() != firstInputs[i]->toString()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
+  // TODO: Add spilling for aggregations over distinct inputs that are not
+  // de-duplicated in a shared hash table.
+  // https://github.com/facebookincubator/velox/issues/7454
+  const bool hasDistinct = std::any_of(
+      aggregates_.begin(), aggregates_.end(), [](const auto& aggregate) {
+        return aggregate.distinct;
+      });
+  if (hasDistinct &&
+      !(queryConfig.aggregationSharedDistinctHashEnabled() && isSingle() &&
+        !groupingKeys_.empty() && allSameDistinctInputs(aggregates_))) {
+    return false;
   }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
@@ -1740,8 +1773,40 @@ PlanNodePtr RowNumberNode::create(const folly::dynamic& obj, void* context) {
       source);
 }
 
+namespace {
+std::unordered_map<TopNRowNumberNode::RankFunction, std::string>
+rankFunctionNames() {
+  return {
+      {TopNRowNumberNode::RankFunction::kRowNumber, "row_number"},
+      {TopNRowNumberNode::RankFunction::kRank, "rank"},
+      {TopNRowNumberNode::RankFunction::kDenseRank, "dense_rank"},
+  };
+}
+} // namespace
+
+// static
+std::string TopNRowNumberNode::rankFunctionName(RankFunction function) {
+  static const auto kFunctionNames = rankFunctionNames();
+  auto it = kFunctionNames.find(function);
+  VELOX_CHECK(
+      it != kFunctionNames.end(),
+      "Invalid rank function {}",
+      static_cast<int>(function));
+  return it->second;
+}
+
+// static
+TopNRowNumberNode::RankFunction TopNRowNumberNode::rankFunctionFromName(
+    const std::string& name) {
+  static const auto kFunctions = invertMap(rankFunctionNames());
+  auto it = kFunctions.find(name);
+  VELOX_CHECK(it != kFunctions.end(), "Invalid rank function " + name);
+  return it->second;
+}
+
 TopNRowNumberNode::TopNRowNumberNode(
     PlanNodeId id,
+    RankFunction function,
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
     std::vector<FieldAccessTypedExprPtr> sortingKeys,
     std::vector<SortOrder> sortingOrders,
@@ -1749,6 +1814,7 @@ TopNRowNumberNode::TopNRowNumberNode(
     int32_t limit,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
+      function_{function},
       partitionKeys_{std::move(partitionKeys)},
       sortingKeys_{std::move(sortingKeys)},
       sortingOrders_{std::move(sortingOrders)},
@@ -1786,6 +1852,10 @@ TopNRowNumberNode::TopNRowNumberNode(
 }
 
 void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
+  if (function_ != RankFunction::kRowNumber) {
+    stream << rankFunctionName(function_) << " ";
+  }
+
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -1801,6 +1871,7 @@ void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
 
 folly::dynamic TopNRowNumberNode::serialize() const {
   auto obj = PlanNode::serialize();
+  obj["function"] = rankFunctionName(function_);
   obj["partitionKeys"] = ISerializable::serialize(partitionKeys_);
   obj["sortingKeys"] = ISerializable::serialize(sortingKeys_);
   obj["sortingOrders"] = serializeSortingOrders(sortingOrders_);
@@ -1826,8 +1897,16 @@ PlanNodePtr TopNRowNumberNode::create(
     rowNumberColumnName = obj["rowNumberColumnName"].asString();
   }
 
+  // Plans serialized before rank and dense_rank were supported don't have a
+  // 'function'.
+  auto function = RankFunction::kRowNumber;
+  if (obj.count("function")) {
+    function = rankFunctionFromName(obj["function"].asString());
+  }
+
   return std::make_shared<TopNRowNumberNode>(
       deserializePlanNodeId(obj),
+      function,
       partitionKeys,
       sortingKeys,
       sortingOrders,
@@ -1973,12 +2052,16 @@ void LocalPartitionNode::addDetails(std::stringstream& stream) const {
   if (type_ != Type::kGather) {
     stream << " " << partitionFunctionSpec_->toString();
   }
+  if (spreadSkewedPartitions_) {
+    stream << " spread skewed partitions";
+  }
 }
 
 folly::dynamic LocalPartitionNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["type"] = typeName(type_);
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
+  obj["spreadSkewedPartitions"] = spreadSkewedPartitions_;
   return obj;
 }
 
@@ -1986,12 +2069,15 @@ folly::dynamic LocalPartitionNode::serialize() const {
 PlanNodePtr LocalPartitionNode::create(
     const folly::dynamic& obj,
     void* context) {
+  const bool spreadSkewedPartitions = obj.count("spreadSkewedPartitions") &&
+      obj["spreadSkewedPartitions"].asBool();
   return std::make_shared<LocalPartitionNode>(
       deserializePlanNodeId(obj),
       typeFromName(obj["type"].asString()),
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"]),
-      deserializeSources(obj, context));
+      deserializeSources(obj, context),
+      spreadSkewedPartitions);
 }
 
 namespace {
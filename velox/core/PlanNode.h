@@ -1181,15 +1181,22 @@ class LocalPartitionNode : public PlanNode {
 
   static Type typeFromName(const std::string& name);
 
+  /// @param spreadSkewedPartitions If true, rows of partitions that receive
+  /// much more than their share of the rows are spread over all partitions.
+  /// Only valid if the consumers do not need all rows with the same keys in the
+  /// same partition, e.g. intermediate aggregations that are followed by
+  /// another repartitioning and a final aggregation.
   LocalPartitionNode(
       const PlanNodeId& id,
       Type type,
       PartitionFunctionSpecPtr partitionFunctionSpec,
-      std::vector<PlanNodePtr> sources)
+      std::vector<PlanNodePtr> sources,
+      bool spreadSkewedPartitions = false)
       : PlanNode(id),
         type_{type},
         sources_{std::move(sources)},
-        partitionFunctionSpec_{std::move(partitionFunctionSpec)} {
+        partitionFunctionSpec_{std::move(partitionFunctionSpec)},
+        spreadSkewedPartitions_{spreadSkewedPartitions} {
     VELOX_USER_CHECK_GT(
         sources_.size(),
         0,
@@ -1232,6 +1239,10 @@ class LocalPartitionNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  bool spreadSkewedPartitions() const {
+    return spreadSkewedPartitions_;
+  }
+
   std::string_view name() const override {
     return "LocalPartition";
   }
@@ -1246,6 +1257,7 @@ class LocalPartitionNode : public PlanNode {
   const Type type_;
   const std::vector<PlanNodePtr> sources_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
+  const bool spreadSkewedPartitions_;
 };
 
 class PartitionedOutputNode : public PlanNode {
@@ -2384,24 +2396,38 @@ class MarkDistinctNode : public PlanNode {
   const RowTypePtr outputType_;
 };
 
-/// Optimized version of a WindowNode for a single row_number function with a
-/// limit over sorted partitions.
+/// Optimized version of a WindowNode for a single row_number, rank or
+/// dense_rank function with a limit over sorted partitions.
 /// The output of this node contains all input columns followed by an optional
 /// 'rowNumberColumnName' BIGINT column.
 class TopNRowNumberNode : public PlanNode {
  public:
+  /// Window function computed by the node.
+  enum class RankFunction {
+    kRowNumber,
+    kRank,
+    kDenseRank,
+  };
+  static std::string rankFunctionName(RankFunction function);
+  static RankFunction rankFunctionFromName(const std::string& name);
+
+  /// @param function Ranking function. With kRank and kDenseRank all rows
+  /// tied with the 'limit'-th row are returned.
   /// @param partitionKeys Partitioning keys. May be empty.
   /// @param sortingKeys Sorting keys. May not be empty and may not intersect
   /// with 'partitionKeys'.
   /// @param sortingOrders Sorting orders, one per sorting key.
   /// @param rowNumberColumnName Optional name of the column containing row
-  /// numbers. If not specified, the output doesn't include 'row number'
-  /// column. This is used when computing partial results.
-  /// @param limit Per-partition limit. The number of
-  /// rows produced by this node will not exceed this value for any given
-  /// partition. Extra rows will be dropped.
+  /// numbers, or ranks for kRank and kDenseRank. If not specified, the output
+  /// doesn't include 'row number' column. This is used when computing partial
+  /// results.
+  /// @param limit Per-partition limit on the value of 'function'. Rows with a
+  /// larger row number or rank are dropped. For kRowNumber the number of rows
+  /// produced by this node will not exceed this value for any given
+  /// partition.
   TopNRowNumberNode(
       PlanNodeId id,
+      RankFunction function,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
       std::vector<FieldAccessTypedExprPtr> sortingKeys,
       std::vector<SortOrder> sortingOrders,
@@ -2409,6 +2435,25 @@ class TopNRowNumberNode : public PlanNode {
       int32_t limit,
       PlanNodePtr source);
 
+  /// Creates a node computing row_number.
+  TopNRowNumberNode(
+      PlanNodeId id,
+      std::vector<FieldAccessTypedExprPtr> partitionKeys,
+      std::vector<FieldAccessTypedExprPtr> sortingKeys,
+      std::vector<SortOrder> sortingOrders,
+      const std::optional<std::string>& rowNumberColumnName,
+      int32_t limit,
+      PlanNodePtr source)
+      : TopNRowNumberNode(
+            std::move(id),
+            RankFunction::kRowNumber,
+            std::move(partitionKeys),
+            std::move(sortingKeys),
+            std::move(sortingOrders),
+            rowNumberColumnName,
+            limit,
+            std::move(source)) {}
+
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
   }
@@ -2437,6 +2482,10 @@ class TopNRowNumberNode : public PlanNode {
     return sortingOrders_;
   }
 
+  RankFunction rankFunction() const {
+    return function_;
+  }
+
   int32_t limit() const {
     return limit_;
   }
@@ -2456,6 +2505,8 @@ class TopNRowNumberNode : public PlanNode {
  private:
   void addDetails(std::stringstream& stream) const override;
 
+  const RankFunction function_;
+
   const std::vector<FieldAccessTypedExprPtr> partitionKeys_;
 
   const std::vector<FieldAccessTypedExprPtr> sortingKeys_;
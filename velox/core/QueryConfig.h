@@ -84,6 +84,18 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to fuse trees of floating point arithmetic calls, e.g.
+  /// (a * 2 + b) / c - d, into a single expression that is evaluated without
+  /// materializing the intermediate results. False by default.
+  static constexpr const char* kExprFuseArithmetic =
+      "expression.fuse_arithmetic";
+
+  /// Whether FilterProject compiles its filter and projections into native
+  /// code using the compiler set by exec::registerFilterProjectCompiler(). Has
+  /// no effect if no compiler is registered. False by default.
+  static constexpr const char* kFilterProjectJitEnabled =
+      "filter_project_jit_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
@@ -108,6 +120,13 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, LocalPartition shares each input batch between all destination
+  /// queues instead of wrapping every column in a dictionary per destination.
+  /// Consumers copy small partitions into flat batches of up to
+  /// kPreferredOutputBatchRows rows and wrap large partitions in dictionaries.
+  static constexpr const char* kLocalExchangeCompactPartitions =
+      "local_exchange_compact_partitions";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -118,6 +137,13 @@ class QueryConfig {
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, the exchange serializer picks the compression codec for each
+  /// page based on the measured compression ratio and CPU cost instead of
+  /// using the codec of the OutputBufferManager. Applies to both the producer
+  /// and the consumer side of the exchange.
+  static constexpr const char* kExchangeAdaptiveCompression =
+      "exchange.adaptive_compression";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -130,6 +156,12 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of most frequent grouping keys that partial aggregation keeps
+  /// aggregating after it has been abandoned as non-reducing. Rows with other
+  /// keys are passed through unaggregated. 0 passes through all rows.
+  static constexpr const char* kAbandonPartialAggregationHeavyHitters =
+      "abandon_partial_aggregation_heavy_hitters";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -171,6 +203,27 @@ class QueryConfig {
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// If true, a 'group by' whose hash table is in array mode keeps fixed-width
+  /// accumulators in one contiguous column per aggregate indexed by the group's
+  /// array slot instead of inside the group rows. Applies only to aggregations
+  /// without spilling, sorted or distinct inputs.
+  static constexpr const char* kAggregationColumnarAccumulatorsEnabled =
+      "aggregation_columnar_accumulators_enabled";
+
+  /// If true, a 'group by' whose aggregates are all over the same distinct
+  /// inputs de-duplicates (grouping keys, inputs) pairs in one hash table
+  /// shared by all groups and feeds the unique pairs to the plain aggregates,
+  /// instead of keeping a set of inputs per group. This also allows the
+  /// aggregation to spill.
+  static constexpr const char* kAggregationSharedDistinctHashEnabled =
+      "aggregation_shared_distinct_hash_enabled";
+
+  /// If true, aggregations over sorted inputs sort the inputs of all groups in
+  /// an output batch at once by (group, sorting keys) using PrefixSort instead
+  /// of sorting the inputs of each group separately.
+  static constexpr const char* kAggregationSortedInputGlobalSortEnabled =
+      "aggregation_sorted_input_global_sort_enabled";
+
   /// If true, the conjunction expression can reorder inputs based on the time
   /// taken to calculate them.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
@@ -250,6 +303,26 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// Specifies how spill files are placed when a task has multiple spill
+  /// directories: 'round_robin' rotates through the directories file by file
+  /// and 'least_loaded' picks the directory with the fewest in-flight writes.
+  static constexpr const char* kSpillDirectoryPlacement =
+      "spill_directory_placement";
+
+  /// The max number of in-flight spill writes to the disk of a spill
+  /// directory, counted across all the queries in the process, before the disk
+  /// is saturated. New spill files skip saturated disks and drivers that may
+  /// spill block while all the disks of their task are saturated. It only
+  /// applies if a task has multiple spill directories. If it is zero, then
+  /// there is no limit.
+  static constexpr const char* kSpillDirectoryMaxQueueDepth =
+      "spill_directory_max_queue_depth";
+
+  /// The max time in milliseconds that a driver blocks while all the spill
+  /// directories of its task are saturated.
+  static constexpr const char* kSpillDirectoryMaxWaitMs =
+      "spill_directory_max_wait_ms";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -446,6 +519,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationHeavyHitters() const {
+    return get<int32_t>(kAbandonPartialAggregationHeavyHitters, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -490,6 +567,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localExchangeCompactPartitions() const {
+    return get<bool>(kLocalExchangeCompactPartitions, false);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -500,6 +581,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool exchangeAdaptiveCompression() const {
+    return get<bool>(kExchangeAdaptiveCompression, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -526,6 +611,18 @@ class QueryConfig {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  bool aggregationColumnarAccumulatorsEnabled() const {
+    return get<bool>(kAggregationColumnarAccumulatorsEnabled, false);
+  }
+
+  bool aggregationSharedDistinctHashEnabled() const {
+    return get<bool>(kAggregationSharedDistinctHashEnabled, false);
+  }
+
+  bool aggregationSortedInputGlobalSortEnabled() const {
+    return get<bool>(kAggregationSortedInputGlobalSortEnabled, false);
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -675,6 +772,18 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  std::string spillDirectoryPlacement() const {
+    return get<std::string>(kSpillDirectoryPlacement, "round_robin");
+  }
+
+  uint32_t spillDirectoryMaxQueueDepth() const {
+    return get<uint32_t>(kSpillDirectoryMaxQueueDepth, 0);
+  }
+
+  uint64_t spillDirectoryMaxWaitMs() const {
+    return get<uint64_t>(kSpillDirectoryMaxWaitMs, 1'000);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -763,6 +872,14 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFuseArithmetic() const {
+    return get<bool>(kExprFuseArithmetic, false);
+  }
+
+  bool filterProjectJitEnabled() const {
+    return get<bool>(kFilterProjectJitEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
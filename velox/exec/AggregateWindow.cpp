@@ -21,14 +21,35 @@
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/FlatVector.h"
 
+#include <numeric>
+
 namespace facebook::velox::exec {
 
 namespace {
 
+bool containsFloatingPoint(const TypePtr& type) {
+  if (type->kind() == TypeKind::REAL || type->kind() == TypeKind::DOUBLE) {
+    return true;
+  }
+  for (uint32_t i = 0; i < type->size(); ++i) {
+    if (containsFloatingPoint(type->childAt(i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Sliding frames over fixed-size accumulators are evaluated with a segment
+// tree of intermediate results built over the partition. Each frame is then
+// the merge of at most 2 * log2(partition size) tree nodes instead of all the
+// rows in the frame. If merging the nodes fails, e.g. a checked sum over the
+// whole partition overflows, the partition falls back to aggregating every
+// frame from scratch.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -101,6 +122,20 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    // The segment tree stores one intermediate result per node. This is only
+    // worthwhile when merging intermediate results is cheap and does not
+    // grow the accumulator. Floating point intermediate results are excluded
+    // as the tree adds them in a different order than row by row, which may
+    // change the rounding.
+    if (aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory()) {
+      auto intermediateType =
+          exec::Aggregate::intermediateType(name, argTypes_);
+      if (!containsFloatingPoint(intermediateType)) {
+        intermediateType_ = std::move(intermediateType);
+      }
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -116,6 +151,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.reset();
+    levelOffsets_.clear();
+    segmentTreeFailed_ = false;
   }
 
   void apply(
@@ -163,7 +201,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
-    } else {
+    } else if (
+        !useSegmentTree(validRows, rawFrameStarts, rawFrameEnds) ||
+        !segmentTreeAggregation(
+            validRows, rawFrameStarts, rawFrameEnds, resultOffset, result)) {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
           validRows,
@@ -345,6 +386,198 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are wide enough on average for
+  // the segment tree to beat aggregating every frame from scratch.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr || segmentTreeFailed_) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows >=
+        kMinSegmentTreeFrameSize * (int64_t)validRows.countSelected();
+  }
+
+  // Allocates and initializes 'numGroups' group rows in 'groups_'. The rows
+  // have the same layout as the single group row.
+  void initializeGroups(vector_size_t numGroups) {
+    const auto stride = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    const auto numBytes = (int64_t)stride * numGroups;
+    if (groupRowsBuffer_ == nullptr || groupRowsBuffer_->size() < numBytes) {
+      groupRowsBuffer_ = AlignedBuffer::allocate<char>(numBytes, pool_);
+    }
+    auto* rawGroupRows = groupRowsBuffer_->asMutable<char>();
+    std::memset(rawGroupRows, 0, numBytes);
+    groups_.resize(numGroups);
+    groupIndices_.resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups_[i] = rawGroupRows + (int64_t)i * stride;
+      groupIndices_[i] = i;
+    }
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(groups_.data(), groupIndices_);
+  }
+
+  void destroyGroups() {
+    aggregate_->destroy(folly::Range(groups_.data(), groups_.size()));
+    groups_.clear();
+  }
+
+  // Builds the segment tree over all rows of the current partition. Level 0
+  // holds the intermediate result of each row and each node of level k + 1
+  // merges 2 adjacent nodes of level k. The levels are concatenated in
+  // 'segmentTree_' starting at 'levelOffsets_'.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    fillArgVectors(0, numRows - 1);
+
+    initializeGroups(numRows);
+    aggregate_->addRawInput(
+        groups_.data(), SelectivityVector(numRows), argVectors_, false);
+    std::vector<VectorPtr> levels;
+    levels.push_back(BaseVector::create(intermediateType_, numRows, pool_));
+    aggregate_->extractAccumulators(groups_.data(), numRows, &levels.back());
+    destroyGroups();
+
+    std::vector<char*> parentGroups;
+    for (auto size = numRows; size > 1; size = (size + 1) / 2) {
+      const auto parentSize = (size + 1) / 2;
+      initializeGroups(parentSize);
+      parentGroups.resize(size);
+      for (auto i = 0; i < size; ++i) {
+        parentGroups[i] = groups_[i / 2];
+      }
+      aggregate_->addIntermediateResults(
+          parentGroups.data(), SelectivityVector(size), {levels.back()}, false);
+      levels.push_back(
+          BaseVector::create(intermediateType_, parentSize, pool_));
+      aggregate_->extractAccumulators(
+          groups_.data(), parentSize, &levels.back());
+      destroyGroups();
+    }
+
+    vector_size_t numNodes = 0;
+    levelOffsets_.clear();
+    for (const auto& level : levels) {
+      levelOffsets_.push_back(numNodes);
+      numNodes += level->size();
+    }
+    segmentTree_ = BaseVector::create(intermediateType_, numNodes, pool_);
+    for (auto i = 0; i < levels.size(); ++i) {
+      segmentTree_->copy(
+          levels[i].get(), levelOffsets_[i], 0, levels[i]->size());
+    }
+  }
+
+  // Computes the aggregate of each valid frame by merging the segment tree
+  // nodes covering the frame. Returns false if building the tree or merging
+  // the nodes raised an error, in which case the tree is not used for the
+  // rest of the partition and the caller aggregates every frame from scratch.
+  // A node may cover more rows than any frame, e.g. the root covers the whole
+  // partition, so merging nodes may overflow even if no frame does.
+  bool segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    try {
+      mergeSegmentTreeNodes(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
+    } catch (const VeloxUserError&) {
+      if (!groups_.empty()) {
+        destroyGroups();
+      }
+      segmentTree_.reset();
+      levelOffsets_.clear();
+      segmentTreeFailed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  // Merges the nodes of each frame in row order so that order sensitive
+  // aggregates see the same sequence of values as with simpleAggregation.
+  void mergeSegmentTreeNodes(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (segmentTree_ == nullptr) {
+      buildSegmentTree();
+    }
+
+    // Collects the nodes of each frame. 'frameNodes_' holds the nodes of the
+    // i-th frame at [nodeOffsets_[i], nodeOffsets_[i + 1]).
+    const auto numFrames = validRows.countSelected();
+    frameNodes_.clear();
+    nodeOffsets_.resize(numFrames + 1);
+    std::vector<vector_size_t> rightNodes;
+    vector_size_t frame = 0;
+    vector_size_t maxNodes = 0;
+    validRows.applyToSelected([&](auto i) {
+      nodeOffsets_[frame] = frameNodes_.size();
+      rightNodes.clear();
+      auto left = rawFrameStarts[i];
+      auto right = rawFrameEnds[i] + 1;
+      for (auto level = 0; left < right; ++level) {
+        if (left & 1) {
+          frameNodes_.push_back(levelOffsets_[level] + left++);
+        }
+        if (right & 1) {
+          rightNodes.push_back(levelOffsets_[level] + --right);
+        }
+        left >>= 1;
+        right >>= 1;
+      }
+      frameNodes_.insert(
+          frameNodes_.end(), rightNodes.rbegin(), rightNodes.rend());
+      maxNodes = std::max<vector_size_t>(
+          maxNodes, frameNodes_.size() - nodeOffsets_[frame]);
+      ++frame;
+    });
+    nodeOffsets_[numFrames] = frameNodes_.size();
+
+    // Merges the r-th node of every frame that has one in a single
+    // addIntermediateResults call over a dictionary of the tree.
+    initializeGroups(numFrames);
+    std::vector<char*> roundGroups(numFrames);
+    for (auto round = 0; round < maxNodes; ++round) {
+      auto indices = allocateIndices(numFrames, pool_);
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      vector_size_t numEntries = 0;
+      for (auto i = 0; i < numFrames; ++i) {
+        if (nodeOffsets_[i] + round < nodeOffsets_[i + 1]) {
+          rawIndices[numEntries] = frameNodes_[nodeOffsets_[i] + round];
+          roundGroups[numEntries++] = groups_[i];
+        }
+      }
+      auto nodes = BaseVector::wrapInDictionary(
+          nullptr, indices, numEntries, segmentTree_);
+      aggregate_->addIntermediateResults(
+          roundGroups.data(), SelectivityVector(numEntries), {nodes}, false);
+    }
+
+    auto values = BaseVector::create(result->type(), numFrames, pool_);
+    aggregate_->extractValues(groups_.data(), numFrames, &values);
+    destroyGroups();
+
+    frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      result->copy(values.get(), resultOffset + i, frame++, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +626,33 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // Sliding frames with at least this many rows on average are computed from
+  // the segment tree.
+  static constexpr int64_t kMinSegmentTreeFrameSize = 32;
+
+  // Intermediate type of 'aggregate_'. Null if the segment tree is not used
+  // for this aggregate.
+  TypePtr intermediateType_;
+
+  // Intermediate results of the segment tree nodes over the current
+  // partition. Built on first use. 'levelOffsets_[k]' is the offset of the
+  // first node of level k.
+  VectorPtr segmentTree_;
+  std::vector<vector_size_t> levelOffsets_;
+
+  // True if building or querying the segment tree failed for the current
+  // partition.
+  bool segmentTreeFailed_{false};
+
+  // Group rows used for building and querying the segment tree.
+  BufferPtr groupRowsBuffer_;
+  std::vector<char*> groups_;
+  std::vector<vector_size_t> groupIndices_;
+
+  // Segment tree nodes for each frame of the output block.
+  std::vector<vector_size_t> frameNodes_;
+  std::vector<vector_size_t> nodeOffsets_;
 };
 
 } // namespace
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ColumnarAccumulators.h"
+#include "velox/exec/Aggregate.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Returns true if values of 'type' are stored in a fixed number of bytes.
+bool isFixedWidthType(const TypePtr& type) {
+  if (type->isFixedWidth()) {
+    return true;
+  }
+  if (type->kind() != TypeKind::ROW) {
+    return false;
+  }
+  for (const auto& child : type->asRow().children()) {
+    if (!isFixedWidthType(child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The null flag of aggregate 'i' is bit 2 * i of the flags slot and the
+// initialized flag is the bit after it.
+int32_t nullBit(int32_t aggregateIndex) {
+  return aggregateIndex * RowContainer::kNumAccumulatorFlags;
+}
+
+int32_t initializedBit(int32_t aggregateIndex) {
+  return nullBit(aggregateIndex) + 1;
+}
+
+int32_t flagByte(int32_t bit) {
+  return bit / 8;
+}
+
+uint8_t flagMask(int32_t bit) {
+  return 1 << (bit % 8);
+}
+
+void copyFlag(
+    const char* from,
+    int32_t fromByte,
+    uint8_t fromMask,
+    char* to,
+    int32_t toByte,
+    uint8_t toMask) {
+  if (from[fromByte] & fromMask) {
+    to[toByte] |= toMask;
+  } else {
+    to[toByte] &= ~toMask;
+  }
+}
+} // namespace
+
+// static
+bool ColumnarAccumulators::canUse(
+    const std::vector<AggregateInfo>& aggregates) {
+  if (aggregates.empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    const auto& function = *aggregate.function;
+    if (!function.isFixedSize() || function.accumulatorUsesExternalMemory() ||
+        !isFixedWidthType(aggregate.intermediateType)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ColumnarAccumulators::ColumnarAccumulators(
+    const std::vector<AggregateInfo>& aggregates,
+    const RowContainer& rows,
+    memory::MemoryPool* pool)
+    : pool_(pool), rowSizeOffset_(rows.rowSizeOffset()) {
+  VELOX_CHECK(canUse(aggregates));
+  const auto numKeys = rows.keyTypes().size();
+  int32_t maxWidth = 0;
+  int32_t alignment = 1;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    auto* function = aggregates[i].function.get();
+    aggregates_.push_back(function);
+    rowColumns_.push_back(rows.columnAt(numKeys + i));
+    widths_.push_back(function->accumulatorFixedWidthSize());
+    maxWidth = std::max(maxWidth, widths_.back());
+    alignment = std::max(alignment, function->accumulatorAlignmentSize());
+  }
+  flagBytes_ =
+      bits::nbytes(aggregates_.size() * RowContainer::kNumAccumulatorFlags);
+  stride_ = bits::roundUp(std::max(maxWidth, flagBytes_), alignment);
+}
+
+void ColumnarAccumulators::prepare(const BaseHashTable& table) {
+  const bool isArray = table.hashMode() == BaseHashTable::HashMode::kArray;
+  if (active_) {
+    if (isArray && table.capacity() == static_cast<uint64_t>(capacity_) &&
+        table.stats().numRehashes == numRehashes_) {
+      return;
+    }
+    leave();
+  }
+  if (!isArray || table.capacity() == 0) {
+    return;
+  }
+
+  // The offsets given to the aggregates are 32 bit.
+  const uint64_t bytes = (aggregates_.size() + 1) * table.capacity() * stride_;
+  if (bytes > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+    return;
+  }
+  capacity_ = table.capacity();
+  numRehashes_ = table.stats().numRehashes;
+  if (columns_ == nullptr || columns_->capacity() < bytes) {
+    columns_.reset();
+    columns_ = AlignedBuffer::allocate<char>(bytes, pool_);
+  }
+  base_ = columns_->asMutable<char>();
+
+  const auto slots = table.arrayGroups();
+  VELOX_CHECK_EQ(slots.size(), table.capacity());
+  slotRows_.assign(slots.begin(), slots.end());
+  for (auto i = 0; i < capacity_; ++i) {
+    if (slotRows_[i] != nullptr) {
+      moveToSlot(slotRows_[i], i);
+    }
+  }
+  setOffsets(true);
+  active_ = true;
+}
+
+char** ColumnarAccumulators::groups(const HashLookup& lookup) {
+  VELOX_DCHECK(active_);
+  groups_.resize(lookup.hits.size());
+  for (auto row : lookup.newGroups) {
+    const auto index = lookup.hashes[row];
+    slotRows_[index] = lookup.hits[row];
+    auto* group = slot(index);
+    std::memset(group, 0, flagBytes_);
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      std::memset(group + columnOffset(i), 0, widths_[i]);
+    }
+  }
+  for (auto row : lookup.rows) {
+    groups_[row] = slot(lookup.hashes[row]);
+  }
+  return groups_.data();
+}
+
+void ColumnarAccumulators::leave() {
+  if (!active_) {
+    return;
+  }
+  for (auto i = 0; i < capacity_; ++i) {
+    if (slotRows_[i] != nullptr) {
+      moveToRow(i, slotRows_[i]);
+    }
+  }
+  clear();
+}
+
+void ColumnarAccumulators::clear() {
+  if (!active_) {
+    return;
+  }
+  setOffsets(false);
+  slotRows_.clear();
+  active_ = false;
+}
+
+void ColumnarAccumulators::setOffsets(bool columnar) {
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (columnar) {
+      aggregates_[i]->setOffsets(
+          columnOffset(i),
+          flagByte(nullBit(i)),
+          flagMask(nullBit(i)),
+          flagByte(initializedBit(i)),
+          flagMask(initializedBit(i)),
+          0);
+    } else {
+      const auto& column = rowColumns_[i];
+      aggregates_[i]->setOffsets(
+          column.offset(),
+          column.nullByte(),
+          column.nullMask(),
+          column.initializedByte(),
+          column.initializedMask(),
+          rowSizeOffset_);
+    }
+  }
+}
+
+void ColumnarAccumulators::moveToSlot(const char* row, int32_t index) {
+  auto* group = slot(index);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& column = rowColumns_[i];
+    std::memcpy(group + columnOffset(i), row + column.offset(), widths_[i]);
+    copyFlag(
+        row,
+        column.nullByte(),
+        column.nullMask(),
+        group,
+        flagByte(nullBit(i)),
+        flagMask(nullBit(i)));
+    copyFlag(
+        row,
+        column.initializedByte(),
+        column.initializedMask(),
+        group,
+        flagByte(initializedBit(i)),
+        flagMask(initializedBit(i)));
+  }
+}
+
+void ColumnarAccumulators::moveToRow(int32_t index, char* row) const {
+  const auto* group = slot(index);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& column = rowColumns_[i];
+    std::memcpy(row + column.offset(), group + columnOffset(i), widths_[i]);
+    copyFlag(
+        group,
+        flagByte(nullBit(i)),
+        flagMask(nullBit(i)),
+        row,
+        column.nullByte(),
+        column.nullMask());
+    copyFlag(
+        group,
+        flagByte(initializedBit(i)),
+        flagMask(initializedBit(i)),
+        row,
+        column.initializedByte(),
+        column.initializedMask());
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/AggregateInfo.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the accumulators of a group by in one contiguous column per aggregate
+/// while the hash table is in kArray mode. The normalized key of a group is
+/// its index in each column, so that updating sum, count, min, max and similar
+/// aggregates touches dense memory instead of scattering over wide group rows.
+///
+/// The aggregates see a group as 'base + index * stride'. The accumulator of
+/// aggregate 'i' is at offset '(i + 1) * capacity * stride' from the group and
+/// column 0 holds the null and initialized flags of all aggregates. This keeps
+/// the Aggregate interface unchanged: entering and leaving the columnar layout
+/// only changes the offsets given to Aggregate::setOffsets().
+///
+/// The accumulators are moved back into the group rows when the table is
+/// rehashed or leaves kArray mode, and before the groups are extracted.
+class ColumnarAccumulators {
+ public:
+  /// Returns true if all of 'aggregates' can be kept in columnar form. This
+  /// requires fixed width accumulators with no out of line state and no
+  /// sorted or distinct inputs.
+  static bool canUse(const std::vector<AggregateInfo>& aggregates);
+
+  /// 'rows' is the RowContainer of the hash table with the accumulators of
+  /// 'aggregates' after the keys.
+  ColumnarAccumulators(
+      const std::vector<AggregateInfo>& aggregates,
+      const RowContainer& rows,
+      memory::MemoryPool* pool);
+
+  /// Returns true if the accumulators are in columnar form.
+  bool active() const {
+    return active_;
+  }
+
+  /// Synchronizes the layout with 'table'. Moves the accumulators back to the
+  /// rows if 'table' was rehashed or changed mode since the last call and
+  /// moves them to columns if 'table' is in kArray mode. Must be called after
+  /// BaseHashTable::prepareForGroupProbe() and before groupProbe().
+  void prepare(const BaseHashTable& table);
+
+  /// Returns the group pointers for the rows of 'lookup' after
+  /// BaseHashTable::groupProbe(). The result is aligned with 'lookup.hits'
+  /// and is valid until the next call. Clears the accumulators of new groups.
+  char** groups(const HashLookup& lookup);
+
+  /// Moves the accumulators back into the group rows and restores the row
+  /// offsets of the aggregates. No-op if not active.
+  void leave();
+
+  /// Drops the columnar state without moving it back to the rows. Used when
+  /// the rows of the hash table are cleared.
+  void clear();
+
+  /// Returns the bytes held by the columns.
+  int64_t allocatedBytes() const {
+    return columns_ ? columns_->capacity() : 0;
+  }
+
+ private:
+  // Sets the offsets of the aggregates to the columns if 'columnar' is true
+  // and to the row columns otherwise.
+  void setOffsets(bool columnar);
+
+  // Copies the accumulators of 'row' into slot 'index' and back.
+  void moveToSlot(const char* row, int32_t index);
+  void moveToRow(int32_t index, char* row) const;
+
+  char* slot(int32_t index) const {
+    return base_ + index * stride_;
+  }
+
+  // Accumulator offset in the columns of the aggregate at 'aggregateIndex'.
+  int32_t columnOffset(int32_t aggregateIndex) const {
+    return (aggregateIndex + 1) * capacity_ * stride_;
+  }
+
+  std::vector<Aggregate*> aggregates_;
+  // Offsets of the accumulators in the group rows.
+  std::vector<RowColumn> rowColumns_;
+  // Fixed width of each accumulator.
+  std::vector<int32_t> widths_;
+  memory::MemoryPool* const pool_;
+  const int32_t rowSizeOffset_;
+
+  // Bytes of flags per slot, two bits per aggregate.
+  int32_t flagBytes_{0};
+  // Bytes between consecutive slots in every column. Fits the widest
+  // accumulator and the flags of all aggregates.
+  int32_t stride_{0};
+
+  bool active_{false};
+  // Number of slots per column. This is the capacity of the kArray table.
+  int32_t capacity_{0};
+  // Number of rehashes of the table when the columns were filled.
+  int64_t numRehashes_{0};
+
+  BufferPtr columns_;
+  char* base_{nullptr};
+
+  // Row of the group at each slot, nullptr for unused slots.
+  std::vector<char*> slotRows_;
+
+  // Group pointers returned by groups().
+  std::vector<char*> groups_;
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/CompiledFilterProject.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+folly::Synchronized<FilterProjectCompiler>& filterProjectCompiler() {
+  static folly::Synchronized<FilterProjectCompiler> compiler;
+  return compiler;
+}
+} // namespace
+
+void registerFilterProjectCompiler(FilterProjectCompiler compiler) {
+  *filterProjectCompiler().wlock() = std::move(compiler);
+}
+
+std::shared_ptr<const CompiledFilterProject> compileFilterProject(
+    const std::vector<core::TypedExprPtr>& exprs,
+    bool hasFilter,
+    const RowTypePtr& inputType) {
+  auto compiler = *filterProjectCompiler().rlock();
+  if (!compiler) {
+    return nullptr;
+  }
+  return compiler(exprs, hasFilter, inputType);
+}
+
+} // namespace facebook::velox::exec
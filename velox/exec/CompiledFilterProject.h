@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// The filter and projections of a FilterProject compiled into native code by
+/// an optional backend, e.g. the LLVM based JIT in velox/experimental/jit. The
+/// compiled code may support only a subset of the inputs, e.g. flat vectors
+/// without nulls. FilterProject falls back to the interpreter for inputs that
+/// are not supported. Instances are shared between drivers and must be thread
+/// safe.
+class CompiledFilterProject {
+ public:
+  virtual ~CompiledFilterProject() = default;
+
+  /// Evaluates the filter and the projections on all rows of 'input'. Returns
+  /// the number of rows that passed the filter and writes their indices to
+  /// 'selectedIndices', which has space for input.size() entries. Sets
+  /// 'results' to one vector per expression, with nullptr for the filter. The
+  /// projections are set for the rows that passed the filter. Returns
+  /// std::nullopt if the compiled code doesn't support 'input' or a row raised
+  /// an error. 'results' and 'selectedIndices' are undefined in this case and
+  /// the caller must evaluate 'input' with the interpreter, which also
+  /// reports the error.
+  virtual std::optional<vector_size_t> evaluate(
+      const RowVector& input,
+      vector_size_t* selectedIndices,
+      std::vector<VectorPtr>& results,
+      memory::MemoryPool* pool) const = 0;
+};
+
+/// Compiles the expressions of a FilterProject. If 'hasFilter' is true,
+/// exprs[0] is the filter and the rest are projections. Returns nullptr if
+/// any of the expressions is not supported.
+using FilterProjectCompiler =
+    std::function<std::shared_ptr<const CompiledFilterProject>(
+        const std::vector<core::TypedExprPtr>& exprs,
+        bool hasFilter,
+        const RowTypePtr& inputType)>;
+
+/// Sets the compiler used by FilterProject when
+/// QueryConfig::kFilterProjectJitEnabled is true. Replaces the previously
+/// registered compiler, if any.
+void registerFilterProjectCompiler(FilterProjectCompiler compiler);
+
+/// Returns the result of the registered compiler or nullptr if no compiler is
+/// registered.
+std::shared_ptr<const CompiledFilterProject> compileFilterProject(
+    const std::vector<core::TypedExprPtr>& exprs,
+    bool hasFilter,
+    const RowTypePtr& inputType);
+
+} // namespace facebook::velox::exec
@@ -141,7 +141,8 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      task->spillDirectories());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -475,6 +476,21 @@ bool Driver::checkUnderArbitration(ContinueFuture* future) {
   return task()->queryCtx()->checkUnderArbitration(future);
 }
 
+bool Driver::checkSpillDirectoriesSaturated(
+    size_t index,
+    ContinueFuture* future) {
+  auto* spillDirectories = task()->spillDirectories();
+  if (spillDirectories == nullptr) {
+    return false;
+  }
+  if (!operators_[index]->canSpill() &&
+      (index + 1 == operators_.size() ||
+       !operators_[index + 1]->canSpill())) {
+    return false;
+  }
+  return spillDirectories->checkSaturated(future);
+}
+
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
@@ -556,6 +572,14 @@ StopReason Driver::runInternal(
           return blockDriver(self, i, std::move(future), blockingState, guard);
         }
 
+        if (FOLLY_UNLIKELY(checkSpillDirectoriesSaturated(i, &future))) {
+          // Blocks the driver before running an operator that may spill while
+          // all the spill directories are saturated. This lets the in-flight
+          // spill writes drain without holding the driver thread.
+          blockingReason_ = BlockingReason::kWaitForSpill;
+          return blockDriver(self, i, std::move(future), blockingState, guard);
+        }
+
         withDeltaCpuWallTimer(op, &OperatorStats::isBlockedTiming, [&]() {
           CALL_OPERATOR(
               blockingReason_ = op->isBlocked(&future),
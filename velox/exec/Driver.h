@@ -204,7 +204,8 @@ enum class BlockingReason {
   kWaitForMemory,
   kWaitForConnector,
   /// Build operator is blocked waiting for all its peers to stop to run group
-  /// spill on all of them.
+  /// spill on all of them. Also used when a driver that may spill is blocked
+  /// as all the spill directories of its task are saturated.
   kWaitForSpill,
   /// Some operators (like Table Scan) may run long loops and can 'voluntarily'
   /// exit them because Task requested to yield or stop or after a certain time.
@@ -407,6 +408,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// the memory arbiration finishes.
   bool checkUnderArbitration(ContinueFuture* future);
 
+  /// Checks if operator 'index' or the next one can spill and all the spill
+  /// directories of the task are saturated. The function returns true if so
+  /// and sets future which is fulfilled when a spill write finishes.
+  bool checkSpillDirectoriesSaturated(size_t index, ContinueFuture* future);
+
   void initializeOperatorStats(std::vector<OperatorStats>& stats);
 
   /// Close operators and add operator stats to the task.
@@ -55,6 +55,8 @@ class Exchange : public SourceOperator {
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
+    options_.adaptiveCompression =
+        driverCtx->queryConfig().exchangeAdaptiveCompression();
   }
 
   ~Exchange() override {
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/CompiledFilterProject.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 
@@ -80,6 +81,12 @@ void FilterProject::initialize() {
     isIdentityProjection_ = true;
   }
   numExprs_ = allExprs.size();
+  if (numExprs_ > 0 &&
+      operatorCtx_->driverCtx()->queryConfig().filterProjectJitEnabled()) {
+    const auto& inputType = project_ ? project_->sources()[0]->outputType()
+                                     : filter_->sources()[0]->outputType();
+    compiled_ = compileFilterProject(allExprs, hasFilter_, inputType);
+  }
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
@@ -126,6 +133,12 @@ RowVectorPtr FilterProject::getOutput() {
     return nullptr;
   }
 
+  if (compiled_ != nullptr) {
+    if (auto output = evaluateCompiled()) {
+      return output.value();
+    }
+  }
+
   vector_size_t size = input_->size();
   LocalSelectivityVector localRows(*operatorCtx_->execCtx(), size);
   auto* rows = localRows.get();
@@ -172,6 +185,28 @@ RowVectorPtr FilterProject::getOutput() {
       results);
 }
 
+std::optional<RowVectorPtr> FilterProject::evaluateCompiled() {
+  const auto size = input_->size();
+  auto* rawIndices = filterEvalCtx_.getRawSelectedIndices(size, pool());
+  std::vector<VectorPtr> results;
+  const auto numOut = compiled_->evaluate(*input_, rawIndices, results, pool());
+  if (!numOut.has_value()) {
+    addRuntimeStat("jitFallbackBatches", RuntimeCounter(1));
+    return std::nullopt;
+  }
+  addRuntimeStat("jitBatches", RuntimeCounter(1));
+
+  numProcessedInputRows_ = size;
+  if (numOut.value() == 0) {
+    input_ = nullptr;
+    return nullptr;
+  }
+  return fillOutput(
+      numOut.value(),
+      numOut.value() == size ? nullptr : filterEvalCtx_.selectedIndices,
+      results);
+}
+
 std::vector<VectorPtr> FilterProject::project(
     const SelectivityVector& rows,
     EvalCtx& evalCtx) {
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/CompiledFilterProject.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
@@ -92,6 +93,11 @@ class FilterProject : public Operator {
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Evaluates the filter and projections on 'input_' with 'compiled_'.
+  // Returns the output like getOutput() or std::nullopt if the compiled code
+  // doesn't support 'input_'.
+  std::optional<RowVectorPtr> evaluateCompiled();
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
@@ -104,6 +110,11 @@ class FilterProject : public Operator {
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
+  // The filter and projections compiled to native code. Set if
+  // QueryConfig::filterProjectJitEnabled() is true and the expressions are
+  // supported by the registered compiler.
+  std::shared_ptr<const CompiledFilterProject> compiled_;
+
   FilterEvalCtx filterEvalCtx_;
 
   vector_size_t numProcessedInputRows_{0};
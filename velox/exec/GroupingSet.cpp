@@ -15,6 +15,7 @@
  */
 #include "velox/exec/GroupingSet.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -30,6 +31,22 @@ bool allAreSinglyReferenced(
   });
 }
 
+// Returns true if all 'aggregates' are over the same unmasked, unsorted
+// distinct inputs. Must match the conditions in AggregationNode::canSpill().
+bool allSameDistinctInputs(const std::vector<AggregateInfo>& aggregates) {
+  if (aggregates.empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregates) {
+    if (!aggregate.distinct || aggregate.mask.has_value() ||
+        !aggregate.sortingKeys.empty() ||
+        aggregate.inputs != aggregates[0].inputs) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Returns true if all vectors are Lazy vectors, possibly wrapped, that haven't
 // been loaded yet.
 bool areAllLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
@@ -89,14 +106,26 @@ GroupingSet::GroupingSet(
         allAreSinglyReferenced(aggregate.inputs, channelUseCount));
   }
 
-  sortedAggregations_ =
-      SortedAggregations::create(aggregates_, inputType, &pool_);
+  sortedAggregations_ = SortedAggregations::create(
+      aggregates_,
+      inputType,
+      &pool_,
+      queryConfig_.aggregationSortedInputGlobalSortEnabled()
+          ? std::make_optional(operatorCtx->driverCtx()->prefixSortConfig())
+          : std::nullopt);
   if (isPartial_) {
     VELOX_USER_CHECK_NULL(
         sortedAggregations_,
         "Partial aggregations over sorted inputs are not supported");
   }
 
+  if (!isGlobal_ && !isPartial_ && isRawInput_ &&
+      preGroupedKeyChannels_.empty() &&
+      queryConfig_.aggregationSharedDistinctHashEnabled() &&
+      allSameDistinctInputs(aggregates_)) {
+    createDistinctPairs(inputType, operatorCtx);
+  }
+
   for (auto& aggregate : aggregates_) {
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
@@ -110,10 +139,64 @@ GroupingSet::GroupingSet(
   }
 }
 
+void GroupingSet::createDistinctPairs(
+    const RowTypePtr& inputType,
+    OperatorCtx* operatorCtx) {
+  distinctInputType_ = inputType;
+  distinctPairChannels_ = keyChannels_;
+  for (auto channel : aggregates_[0].inputs) {
+    if (channel != kConstantChannel &&
+        std::find(
+            distinctPairChannels_.begin(),
+            distinctPairChannels_.end(),
+            channel) == distinctPairChannels_.end()) {
+      distinctPairChannels_.push_back(channel);
+    }
+  }
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto channel : distinctPairChannels_) {
+    hashers.push_back(
+        VectorHasher::create(inputType->childAt(channel), channel));
+  }
+
+  if (spillConfig_ != nullptr) {
+    // The pairs spill to their own files next to the spilled groups.
+    distinctPairsSpillConfig_ = *spillConfig_;
+    distinctPairsSpillConfig_->fileNamePrefix += "-distinct";
+  }
+
+  // Null grouping keys are dropped when the unique pairs are added to the
+  // groups, so that the pairs keep all rows.
+  distinctPairs_ = std::make_unique<GroupingSet>(
+      inputType,
+      std::move(hashers),
+      /*preGroupedKeys=*/std::vector<column_index_t>{},
+      /*aggregates=*/std::vector<AggregateInfo>{},
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/false,
+      /*isRawInput=*/false,
+      /*globalGroupingSets=*/std::vector<vector_size_t>{},
+      /*groupIdChannel=*/std::nullopt,
+      distinctPairsSpillConfig_.has_value() ? &distinctPairsSpillConfig_.value()
+                                            : nullptr,
+      nonReclaimableSection_,
+      operatorCtx,
+      spillStats_);
+
+  // The aggregates see each (grouping keys, inputs) pair once and are
+  // evaluated as plain aggregates.
+  for (auto& aggregate : aggregates_) {
+    aggregate.distinct = false;
+  }
+}
+
 GroupingSet::~GroupingSet() {
   if (isGlobal_) {
     destroyGlobalAggregations();
   }
+  // The table frees the accumulators of its remaining rows.
+  useHeavyHitterTableLayout();
 }
 
 std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
@@ -160,6 +243,11 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
     return;
   }
 
+  if (distinctPairs_ != nullptr) {
+    addDistinctPairsInput(input);
+    return;
+  }
+
   auto numRows = input->size();
   numInputRows_ += numRows;
   if (!preGroupedKeyChannels_.empty()) {
@@ -187,7 +275,85 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+void GroupingSet::addDistinctPairsInput(const RowVectorPtr& input) {
+  numInputRows_ += input->size();
+  if (!table_) {
+    createHashTable();
+  }
+
+  distinctPairs_->addInput(input, /*mayPushdown=*/false);
+  if (distinctPairs_->hasSpilled()) {
+    // Pairs added after spilling may have been seen before spilling. These
+    // are read back de-duplicated from the spilled pairs in noMoreInput().
+    return;
+  }
+
+  const auto& newPairs = distinctPairs_->hashLookup().newGroups;
+  if (newPairs.empty()) {
+    return;
+  }
+  const vector_size_t numNewPairs = newPairs.size();
+  auto indices = allocateIndices(numNewPairs, &pool_);
+  std::copy(
+      newPairs.begin(), newPairs.end(), indices->asMutable<vector_size_t>());
+  addUniqueInput(wrap(numNewPairs, std::move(indices), input));
+}
+
+void GroupingSet::addSpilledDistinctPairs() {
+  if (distinctPairs_ == nullptr) {
+    return;
+  }
+  if (!distinctPairs_->hasSpilled()) {
+    distinctPairs_.reset();
+    return;
+  }
+
+  distinctPairs_->noMoreInput();
+  std::vector<TypePtr> pairTypes;
+  for (auto channel : distinctPairChannels_) {
+    pairTypes.push_back(distinctInputType_->childAt(channel));
+  }
+  const auto pairType = ROW(std::move(pairTypes));
+  const auto maxPairs = queryConfig_.preferredOutputBatchRows();
+  RowContainerIterator iterator;
+  for (;;) {
+    auto pairs = BaseVector::create<RowVector>(pairType, maxPairs, &pool_);
+    if (!distinctPairs_->getOutput(
+            maxPairs,
+            queryConfig_.preferredOutputBatchBytes(),
+            iterator,
+            pairs)) {
+      break;
+    }
+
+    // Lays out the pairs as input rows. The columns that are neither grouping
+    // keys nor aggregate inputs are not read.
+    const auto numPairs = pairs->size();
+    std::vector<VectorPtr> children(distinctInputType_->size());
+    for (auto i = 0; i < distinctPairChannels_.size(); ++i) {
+      children[distinctPairChannels_[i]] = pairs->childAt(i);
+    }
+    for (auto i = 0; i < children.size(); ++i) {
+      if (children[i] == nullptr) {
+        children[i] = BaseVector::createNullConstant(
+            distinctInputType_->childAt(i), numPairs, &pool_);
+      }
+    }
+    addUniqueInput(std::make_shared<RowVector>(
+        &pool_, distinctInputType_, nullptr, numPairs, std::move(children)));
+  }
+  distinctPairs_.reset();
+}
+
+void GroupingSet::addUniqueInput(const RowVectorPtr& input) {
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+  addInputForActiveRows(input, /*mayPushdown=*/false);
+}
+
 void GroupingSet::noMoreInput() {
+  addSpilledDistinctPairs();
+
   noMoreInput_ = true;
 
   if (remainingInput_) {
@@ -229,6 +395,9 @@ void GroupingSet::addInputForActiveRows(
       input,
       activeRows_,
       BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->prepare(*table_);
+  }
   if (lookup_->rows.empty()) {
     // No rows to probe. Can happen when ignoreNullKeys_ is true and all rows
     // have null keys.
@@ -239,6 +408,9 @@ void GroupingSet::addInputForActiveRows(
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
+  if (columnarAccumulators_ != nullptr && columnarAccumulators_->active()) {
+    groups = columnarAccumulators_->groups(*lookup_);
+  }
   const auto& newGroups = lookup_->newGroups;
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
@@ -401,6 +573,15 @@ void GroupingSet::createHashTable() {
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode(BaseHashTable::kNoSpillInputStartPartitionBit);
   }
+
+  // Spilling reads the accumulators from the rows at any time, so the
+  // columnar layout is only used without spilling.
+  if (isAdaptive_ && spillConfig_ == nullptr &&
+      queryConfig_.aggregationColumnarAccumulatorsEnabled() &&
+      ColumnarAccumulators::canUse(aggregates_)) {
+    columnarAccumulators_ =
+        std::make_unique<ColumnarAccumulators>(aggregates_, rows, &pool_);
+  }
 }
 
 void GroupingSet::initializeGlobalAggregation() {
@@ -734,6 +915,11 @@ bool GroupingSet::getOutput(
   }
   VELOX_CHECK(!isDistinct());
 
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->leave();
+  }
+  useHeavyHitterTableLayout();
+
   // @lint-ignore CLANGTIDY
   char* groups[maxOutputRows];
   const int32_t numGroups = table_
@@ -790,9 +976,14 @@ void GroupingSet::extractGroups(
 }
 
 void GroupingSet::resetTable(bool freeTable) {
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->clear();
+  }
   if (table_ != nullptr) {
+    useHeavyHitterTableLayout();
     table_->clear(freeTable);
   }
+  heavyHitters_.clear();
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -819,7 +1010,9 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
-    return table_->allocatedBytes();
+    return table_->allocatedBytes() +
+        (columnarAccumulators_ ? columnarAccumulators_->allocatedBytes() : 0) +
+        (distinctPairs_ ? distinctPairs_->allocatedBytes() : 0);
   }
 
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
@@ -963,6 +1156,10 @@ RowTypePtr GroupingSet::makeSpillType() const {
 }
 
 void GroupingSet::spill() {
+  if (distinctPairs_ != nullptr) {
+    distinctPairs_->spill();
+  }
+
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
   // Correspondingly, 'table_' will not be initialized at that point.
@@ -1264,7 +1461,14 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
 }
 
-void GroupingSet::abandonPartialAggregation() {
+namespace {
+// Ratio of keys tracked in the key frequency summary to heavy hitter keys. The
+// summary tracks more keys than are admitted so that the counts of the top keys
+// are accurate.
+constexpr int32_t kKeyFrequencySummaryFactor = 4;
+} // namespace
+
+void GroupingSet::abandonPartialAggregation(int32_t numHeavyHitters) {
   abandonedPartialAggregation_ = true;
   allSupportToIntermediate_ = true;
   for (auto& aggregate : aggregates_) {
@@ -1285,9 +1489,90 @@ void GroupingSet::abandonPartialAggregation() {
       false,
       &pool_);
   initializeAggregates(aggregates_, *intermediateRows_, true);
+  // The columnar layout moves the accumulator offsets, which would conflict
+  // with switching the aggregates between 'table_' and 'intermediateRows_'.
+  columnarAccumulators_.reset();
+  if (numHeavyHitters > 0 && !isDistinct() &&
+      preGroupedKeyChannels_.empty()) {
+    // Keeps the table for the heavy hitters.
+    numHeavyHitters_ = numHeavyHitters;
+    keyFrequencies_ = std::make_unique<
+        functions::ApproxMostFrequentStreamSummary<uint64_t>>();
+    keyFrequencies_->setCapacity(numHeavyHitters * kKeyFrequencySummaryFactor);
+    return;
+  }
   table_.reset();
 }
 
+void GroupingSet::useHeavyHitterTableLayout() {
+  if (hasHeavyHitters()) {
+    initializeAggregates(aggregates_, *table_->rows(), false);
+  }
+}
+
+RowVectorPtr GroupingSet::addHeavyHitterInput(const RowVectorPtr& input) {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK(hasHeavyHitters());
+  const auto numRows = input->size();
+  activeRows_.resize(numRows);
+  activeRows_.setAll();
+
+  keyHashes_.resize(numRows);
+  const auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    auto& hasher = *hashers[i];
+    hasher.decode(*input->childAt(hasher.channel()), activeRows_);
+    hasher.hash(activeRows_, i > 0, keyHashes_);
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    keyFrequencies_->insert(keyHashes_[i]);
+  }
+  updateHeavyHitters();
+
+  BufferPtr passThroughIndices = allocateIndices(numRows, &pool_);
+  auto* rawPassThroughIndices = passThroughIndices->asMutable<vector_size_t>();
+  vector_size_t numPassThrough = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (!heavyHitters_.contains(keyHashes_[i])) {
+      activeRows_.setValid(i, false);
+      rawPassThroughIndices[numPassThrough++] = i;
+    }
+  }
+  activeRows_.updateBounds();
+  if (activeRows_.hasSelections()) {
+    useHeavyHitterTableLayout();
+    addInputForActiveRows(input, false);
+  }
+
+  if (numPassThrough == 0) {
+    return nullptr;
+  }
+  if (numPassThrough == numRows) {
+    return input;
+  }
+  return wrap(numPassThrough, std::move(passThroughIndices), input);
+}
+
+void GroupingSet::updateHeavyHitters() {
+  if (heavyHitters_.size() >= numHeavyHitters_) {
+    return;
+  }
+  // Once the summary is full, every count may be over-estimated by up to the
+  // smallest count. Only keys seen more often than that are admitted.
+  const auto numKeys = keyFrequencies_->size();
+  int64_t minCount = 1;
+  if (numKeys >= numHeavyHitters_ * kKeyFrequencySummaryFactor) {
+    const auto* counts = keyFrequencies_->counts();
+    minCount = *std::min_element(counts, counts + numKeys);
+  }
+  for (const auto& [hash, count] : keyFrequencies_->topK(numHeavyHitters_)) {
+    if (count <= minCount || heavyHitters_.size() >= numHeavyHitters_) {
+      break;
+    }
+    heavyHitters_.insert(hash);
+  }
+}
+
 namespace {
 // Recursive resize all children.
 
@@ -1313,6 +1598,10 @@ void GroupingSet::toIntermediate(
     result = input;
     return;
   }
+  if (hasHeavyHitters()) {
+    // The aggregates also accumulate into 'table_' in heavy hitter mode.
+    initializeAggregates(aggregates_, *intermediateRows_, true);
+  }
   auto numRows = input->size();
   activeRows_.resize(numRows);
   activeRows_.setAll();
@@ -1384,7 +1673,9 @@ void GroupingSet::toIntermediate(
   // It's unnecessary to call function->clear() to reset the internal states of
   // aggregation functions because toIntermediate() is already called at the end
   // of HashAggregation::getOutput(). When toIntermediate() is called, the
-  // aggregaiton function instances won't be reused after it returns.
+  // aggregaiton function instances won't be reused after it returns, except
+  // for the heavy hitter table, which points them back at its own layout
+  // first.
   tempVectors_.clear();
 }
 
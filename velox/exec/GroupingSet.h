@@ -17,12 +17,14 @@
 
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
+#include "velox/exec/ColumnarAccumulators.h"
 #include "velox/exec/DistinctAggregations.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/SortedAggregations.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/VectorHasher.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -134,8 +136,24 @@ class GroupingSet {
   }
 
   // Frees hash tables and other state when giving up partial aggregation as
-  // non-productive. Must be called before toIntermediate() is used.
-  void abandonPartialAggregation();
+  // non-productive. Must be called before toIntermediate() is used. If
+  // 'numHeavyHitters' is > 0, keeps the hash table for aggregating the rows
+  // whose keys are among the 'numHeavyHitters' most frequent keys. See
+  // addHeavyHitterInput().
+  void abandonPartialAggregation(int32_t numHeavyHitters = 0);
+
+  /// True if partial aggregation has been abandoned but the most frequent
+  /// keys are still aggregated.
+  bool hasHeavyHitters() const {
+    return numHeavyHitters_ > 0;
+  }
+
+  /// Aggregates the rows of 'input' whose keys are heavy hitters and returns
+  /// the remaining rows for toIntermediate(), or nullptr if there are none.
+  /// Key frequencies are tracked with a space-saving summary over key hashes.
+  /// Keys are admitted as heavy hitters while the table has fewer than
+  /// 'numHeavyHitters' keys. resetTable() starts over with no keys admitted.
+  RowVectorPtr addHeavyHitterInput(const RowVectorPtr& input);
 
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
@@ -162,6 +180,23 @@ class GroupingSet {
 
   void addInputForActiveRows(const RowVectorPtr& input, bool mayPushdown);
 
+  // Creates 'distinctPairs_' to de-duplicate (grouping keys, distinct inputs)
+  // pairs for all groups in one hash table.
+  void createDistinctPairs(
+      const RowTypePtr& inputType,
+      OperatorCtx* operatorCtx);
+
+  // Adds 'input' to 'distinctPairs_' and the rows with new pairs to the groups.
+  void addDistinctPairsInput(const RowVectorPtr& input);
+
+  // Adds the pairs that were not added to the groups because 'distinctPairs_'
+  // has spilled. Reads these from the spilled pairs, which excludes the pairs
+  // seen before the first spill. Frees 'distinctPairs_'.
+  void addSpilledDistinctPairs();
+
+  // Adds all rows of 'input' to the groups.
+  void addUniqueInput(const RowVectorPtr& input);
+
   void addRemainingInput();
 
   void initializeGlobalAggregation();
@@ -264,6 +299,17 @@ class GroupingSet {
   // groups.
   void extractSpillResult(const RowVectorPtr& result);
 
+  // Admits the most frequent keys in 'keyFrequencies_' to 'heavyHitters_'
+  // until there are 'numHeavyHitters_' of them.
+  void updateHeavyHitters();
+
+  // In heavy hitter mode the aggregate functions accumulate into both 'table_'
+  // and 'intermediateRows_', which have different row layouts and string
+  // allocators. Points the functions back at 'table_' before it is updated,
+  // read or cleared. toIntermediate() points them at 'intermediateRows_'.
+  // No-op outside of heavy hitter mode.
+  void useHeavyHitterTableLayout();
+
   // Returns a list of accumulators for 'aggregates_', plus one more accumulator
   // for 'sortedAggregations_', and one for each 'distinctAggregations_'.  When
   // 'excludeToIntermediate' is true, skip the functions that support
@@ -286,6 +332,18 @@ class GroupingSet {
   std::unique_ptr<SortedAggregations> sortedAggregations_;
   std::vector<std::unique_ptr<DistinctAggregations>> distinctAggregations_;
 
+  // Set if all aggregates are over the same distinct inputs and
+  // QueryConfig::kAggregationSharedDistinctHashEnabled is true. A distinct
+  // grouping set over the grouping keys and the distinct inputs. Only rows
+  // with a new (grouping keys, inputs) pair are added to the aggregates, which
+  // are evaluated as non-distinct.
+  std::unique_ptr<GroupingSet> distinctPairs_;
+  // Input columns of the pairs in 'distinctPairs_', grouping keys first.
+  std::vector<column_index_t> distinctPairChannels_;
+  RowTypePtr distinctInputType_;
+  // Spill config of 'distinctPairs_' with its own spill file names.
+  std::optional<common::SpillConfig> distinctPairsSpillConfig_;
+
   const bool ignoreNullKeys_;
 
   uint64_t numInputRows_ = 0;
@@ -311,6 +369,9 @@ class GroupingSet {
   std::vector<VectorPtr> tempVectors_;
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
+  // Set if accumulators are kept in columns while 'table_' is in kArray mode.
+  // See QueryConfig::kAggregationColumnarAccumulatorsEnabled.
+  std::unique_ptr<ColumnarAccumulators> columnarAccumulators_;
   SelectivityVector activeRows_;
 
   // Used to allocate memory for a single row accumulating results of global
@@ -370,6 +431,20 @@ class GroupingSet {
   // input to intermediate. Initialized in abandonPartialAggregation().
   bool allSupportToIntermediate_;
 
+  // Number of most frequent keys that are still aggregated after partial
+  // aggregation has been abandoned. 0 if all rows are passed through.
+  int32_t numHeavyHitters_{0};
+
+  // Approximate frequencies of key hashes. Set if 'numHeavyHitters_' > 0.
+  std::unique_ptr<functions::ApproxMostFrequentStreamSummary<uint64_t>>
+      keyFrequencies_;
+
+  // Hashes of the keys aggregated in 'table_' if 'numHeavyHitters_' > 0.
+  folly::F14FastSet<uint64_t> heavyHitters_;
+
+  // Temporary for the key hashes of the input rows in addHeavyHitterInput().
+  raw_vector<uint64_t> keyHashes_;
+
   // RowContainer for toIntermediate for aggregates that do not have a
   // toIntermediate() fast path
   std::unique_ptr<RowContainer> intermediateRows_;
@@ -45,6 +45,8 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationHeavyHitters_(
+          driverCtx->queryConfig().abandonPartialAggregationHeavyHitters()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -123,8 +125,17 @@ void HashAggregation::addInput(RowVectorPtr input) {
     pushdownChecked_ = true;
   }
   if (abandonedPartialAggregation_) {
-    input_ = input;
     numInputRows_ += input->size();
+    if (!groupingSet_->hasHeavyHitters()) {
+      input_ = input;
+      return;
+    }
+    input_ = groupingSet_->addHeavyHitterInput(input);
+    addRuntimeStat(
+        "heavyHitterRows",
+        RuntimeCounter(input->size() - (input_ ? input_->size() : 0)));
+    partialFull_ =
+        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_);
     return;
   }
   groupingSet_->addInput(input, mayPushdown_);
@@ -235,7 +246,8 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
+    groupingSet_->abandonPartialAggregation(
+        abandonPartialAggregationHeavyHitters_);
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
     abandonedPartialAggregation_ = true;
@@ -268,17 +280,20 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
   if (abandonedPartialAggregation_) {
+    if (input_) {
+      prepareOutput(input_->size());
+      groupingSet_->toIntermediate(input_, output_);
+      numOutputRows_ += input_->size();
+      input_ = nullptr;
+      return output_;
+    }
+    if (groupingSet_->hasHeavyHitters() && (noMoreInput_ || partialFull_)) {
+      return getHeavyHitterOutput();
+    }
     if (noMoreInput_) {
       finished_ = true;
     }
-    if (!input_) {
-      return nullptr;
-    }
-    prepareOutput(input_->size());
-    groupingSet_->toIntermediate(input_, output_);
-    numOutputRows_ += input_->size();
-    input_ = nullptr;
-    return output_;
+    return nullptr;
   }
 
   // Produce results if one of the following is true:
@@ -319,6 +334,27 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+RowVectorPtr HashAggregation::getHeavyHitterOutput() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  prepareOutput(maxOutputRows);
+  if (groupingSet_->getOutput(
+          maxOutputRows,
+          queryConfig.preferredOutputBatchBytes(),
+          resultIterator_,
+          output_)) {
+    numOutputRows_ += output_->size();
+    return output_;
+  }
+  resultIterator_.reset();
+  groupingSet_->resetTable(/*freeTable=*/false);
+  partialFull_ = false;
+  if (noMoreInput_) {
+    finished_ = true;
+  }
+  return nullptr;
+}
+
 RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(isDistinct_);
   VELOX_CHECK(!finished_);
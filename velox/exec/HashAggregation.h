@@ -72,6 +72,10 @@ class HashAggregation : public Operator {
 
   RowVectorPtr getDistinctOutput();
 
+  // Returns the next batch of heavy hitter groups after partial aggregation
+  // has been abandoned. Resets the table when all groups have been returned.
+  RowVectorPtr getHeavyHitterOutput();
+
   void updateEstimatedOutputRowSize();
 
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
@@ -86,6 +90,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of most frequent keys to keep aggregating after abandoning partial
+  // aggregation. 0 passes through all rows.
+  const int32_t abandonPartialAggregationHeavyHitters_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
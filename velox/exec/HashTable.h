@@ -319,6 +319,11 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Returns the slots of the table in kArray mode, one per value of the
+  /// normalized key. A slot is the row of the group with that key or nullptr.
+  /// The slots are valid until the next rehash or clear.
+  virtual folly::Range<char* const*> arrayGroups() const = 0;
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode(int8_t spillInputStartPartitionBit) {
     setHashMode(HashMode::kHash, 0, spillInputStartPartitionBit);
@@ -562,6 +567,11 @@ class HashTable : public BaseHashTable {
     return hashMode_;
   }
 
+  folly::Range<char* const*> arrayGroups() const override {
+    VELOX_CHECK(hashMode_ == HashMode::kArray);
+    return folly::Range<char* const*>(table_, capacity_);
+  }
+
   void decideHashMode(
       int32_t numNew,
       int8_t spillInputStartPartitionBit,
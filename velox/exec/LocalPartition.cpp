@@ -24,6 +24,19 @@ void notify(std::vector<ContinuePromise>& promises) {
     promise.setValue();
   }
 }
+
+RowVectorPtr
+wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
+  std::vector<VectorPtr> wrappedChildren;
+  wrappedChildren.reserve(input->type()->size());
+  for (auto i = 0; i < input->type()->size(); i++) {
+    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), indices, size, input->childAt(i)));
+  }
+
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
+}
 } // namespace
 
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
@@ -79,13 +92,32 @@ BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     int64_t inputBytes,
     ContinueFuture* future) {
+  const auto numRows = input->size();
+  return enqueue(Batch{std::move(input), nullptr, numRows, inputBytes}, future);
+}
+
+BlockingReason LocalExchangeQueue::enqueue(
+    RowVectorPtr input,
+    BufferPtr indices,
+    vector_size_t numRows,
+    int64_t inputBytes,
+    ContinueFuture* future) {
+  return enqueue(
+      Batch{std::move(input), std::move(indices), numRows, inputBytes},
+      future);
+}
+
+BlockingReason LocalExchangeQueue::enqueue(
+    Batch batch,
+    ContinueFuture* future) {
   std::vector<ContinuePromise> consumerPromises;
   bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.emplace(std::move(input), inputBytes);
+    const auto inputBytes = batch.bytes;
+    queue.emplace(std::move(batch));
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -125,6 +157,7 @@ BlockingReason LocalExchangeQueue::next(
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
   std::vector<ContinuePromise> memoryPromises;
+  std::vector<Batch> batches;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -138,18 +171,79 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    int64_t size;
-    std::tie(*data, size) = queue.front();
+    int64_t size = queue.front().bytes;
+    batches.push_back(std::move(queue.front()));
     queue.pop();
 
+    // Take more small partitions to copy into the same flat batch.
+    if (isCompactable(batches.back())) {
+      auto numRows = batches.back().numRows;
+      while (!queue.empty() && isCompactable(queue.front()) &&
+             numRows + queue.front().numRows <= maxCompactRows_) {
+        numRows += queue.front().numRows;
+        size += queue.front().bytes;
+        batches.push_back(std::move(queue.front()));
+        queue.pop();
+      }
+    }
+
     memoryPromises = memoryManager_->decreaseMemoryUsage(size);
 
     return BlockingReason::kNotBlocked;
   });
   notify(memoryPromises);
+
+  if (!batches.empty()) {
+    *data = materialize(batches, pool);
+  }
   return blockingReason;
 }
 
+// static
+RowVectorPtr LocalExchangeQueue::materialize(
+    std::vector<Batch>& batches,
+    memory::MemoryPool* pool) {
+  if (batches.size() == 1) {
+    auto& batch = batches[0];
+    if (batch.indices == nullptr) {
+      return std::move(batch.input);
+    }
+    if (!isCompactable(batch)) {
+      return wrapChildren(batch.input, batch.numRows, std::move(batch.indices));
+    }
+  }
+
+  vector_size_t numRows = 0;
+  for (const auto& batch : batches) {
+    numRows += batch.numRows;
+  }
+
+  auto result =
+      BaseVector::create<RowVector>(batches[0].input->type(), numRows, pool);
+
+  std::vector<BaseVector::CopyRange> ranges;
+  vector_size_t targetIndex = 0;
+  for (const auto& batch : batches) {
+    ranges.clear();
+    const auto* rawIndices = batch.indices->as<vector_size_t>();
+    for (auto i = 0; i < batch.numRows; ++i) {
+      if (!ranges.empty() &&
+          ranges.back().sourceIndex + ranges.back().count == rawIndices[i]) {
+        ++ranges.back().count;
+      } else {
+        ranges.push_back({
+            .sourceIndex = rawIndices[i],
+            .targetIndex = targetIndex + i,
+            .count = 1,
+        });
+      }
+    }
+    result->copyRanges(batch.input.get(), ranges);
+    targetIndex += batch.numRows;
+  }
+  return result;
+}
+
 bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
   if (closed_) {
     return true;
@@ -172,7 +266,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front().second;
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -249,8 +343,14 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      compactPartitions_{ctx->queryConfig().localExchangeCompactPartitions()},
+      spreadSkewedPartitions_{
+          planNode->spreadSkewedPartitions() && numPartitions_ > 1} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
+  if (spreadSkewedPartitions_) {
+    partitionRows_.resize(numPartitions_, 0);
+  }
 
   for (auto& queue : queues_) {
     queue->addProducer();
@@ -278,19 +378,6 @@ std::vector<vector_size_t*> getRawIndices(
   }
   return rawIndices;
 }
-
-RowVectorPtr
-wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
-  std::vector<VectorPtr> wrappedChildren;
-  wrappedChildren.reserve(input->type()->size());
-  for (auto i = 0; i < input->type()->size(); i++) {
-    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
-        BufferPtr(nullptr), indices, size, input->childAt(i)));
-  }
-
-  return std::make_shared<RowVector>(
-      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
-}
 } // namespace
 
 void LocalPartition::addInput(RowVectorPtr input) {
@@ -315,8 +402,14 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
-  const auto singlePartition =
-      partitionFunction_->partition(*input, partitions_);
+  auto singlePartition = partitionFunction_->partition(*input, partitions_);
+  if (spreadSkewedPartitions_) {
+    if (singlePartition.has_value()) {
+      partitions_.assign(input->size(), singlePartition.value());
+      singlePartition.reset();
+    }
+    spreadSkewedRows(input->size());
+  }
   if (singlePartition.has_value()) {
     ContinueFuture future;
     auto blockingReason = queues_[singlePartition.value()]->enqueue(
@@ -350,11 +443,21 @@ void LocalPartition::addInput(RowVectorPtr input) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
+    const int64_t partitionBytes = totalSize * partitionSize / numInput;
     ContinueFuture future;
-    auto reason = queues_[i]->enqueue(
-        partitionData, totalSize * partitionSize / numInput, &future);
+    BlockingReason reason;
+    if (compactPartitions_) {
+      reason = queues_[i]->enqueue(
+          input,
+          std::move(indexBuffers[i]),
+          partitionSize,
+          partitionBytes,
+          &future);
+    } else {
+      auto partitionData =
+          wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
+      reason = queues_[i]->enqueue(partitionData, partitionBytes, &future);
+    }
     if (reason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(reason);
       futures_.push_back(std::move(future));
@@ -362,6 +465,37 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 }
 
+void LocalPartition::spreadSkewedRows(vector_size_t numInput) {
+  for (auto i = 0; i < numInput; ++i) {
+    ++partitionRows_[partitions_[i]];
+  }
+  numRows_ += numInput;
+  if (numRows_ < kSkewedPartitionMinRows) {
+    return;
+  }
+
+  std::vector<bool> skewed(numPartitions_);
+  bool anySkewed = false;
+  for (auto i = 0; i < numPartitions_; ++i) {
+    skewed[i] = 100 * partitionRows_[i] * numPartitions_ >
+        kSkewedPartitionPct * numRows_;
+    anySkewed |= skewed[i];
+  }
+  if (!anySkewed) {
+    return;
+  }
+
+  int64_t numSpreadRows = 0;
+  for (auto i = 0; i < numInput; ++i) {
+    if (skewed[partitions_[i]]) {
+      partitions_[i] = nextSpreadPartition_;
+      nextSpreadPartition_ = (nextSpreadPartition_ + 1) % numPartitions_;
+      ++numSpreadRows;
+    }
+  }
+  addRuntimeStat("spreadSkewedRows", RuntimeCounter(numSpreadRows));
+}
+
 BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
   if (!futures_.empty()) {
     auto blockingReason = blockingReasons_.front();
@@ -51,10 +51,16 @@ class LocalExchangeMemoryManager {
 /// Consumers call 'next' repeatedly to fetch the data.
 class LocalExchangeQueue {
  public:
+  /// @param maxCompactRows Upper bound on the number of rows copied into a
+  /// single flat batch when compacting small partitions added via
+  /// 'enqueue(input, indices, ...)'.
   LocalExchangeQueue(
       std::shared_ptr<LocalExchangeMemoryManager> memoryManager,
-      int partition)
-      : memoryManager_{std::move(memoryManager)}, partition_{partition} {}
+      int partition,
+      vector_size_t maxCompactRows = 1'024)
+      : memoryManager_{std::move(memoryManager)},
+        partition_{partition},
+        maxCompactRows_{maxCompactRows} {}
 
   std::string toString() const {
     return fmt::format("LocalExchangeQueue({})", partition_);
@@ -70,6 +76,20 @@ class LocalExchangeQueue {
   BlockingReason
   enqueue(RowVectorPtr input, int64_t inputBytes, ContinueFuture* future);
 
+  /// Same as above, but adds only 'numRows' rows of 'input' at positions
+  /// specified in 'indices'. The producer shares 'input' between all queues
+  /// instead of wrapping each of its columns in a dictionary per partition.
+  /// The rows are materialized by the consumer in 'next': partitions that
+  /// hold a small fraction of 'input' are copied, possibly together with
+  /// other small partitions, into a flat batch; larger partitions are wrapped
+  /// in dictionaries.
+  BlockingReason enqueue(
+      RowVectorPtr input,
+      BufferPtr indices,
+      vector_size_t numRows,
+      int64_t inputBytes,
+      ContinueFuture* future);
+
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
 
@@ -90,12 +110,38 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  using Queue = std::queue<std::pair<RowVectorPtr, int64_t>>;
+  // Partitions holding at most 1 / kCompactRatio of the rows of the input
+  // batch are copied into flat batches rather than wrapped in dictionaries.
+  static constexpr int32_t kCompactRatio = 4;
+
+  // A batch of data buffered in the queue. If 'indices' is set, only
+  // 'numRows' rows of 'input' at these positions belong to this queue.
+  struct Batch {
+    RowVectorPtr input;
+    BufferPtr indices;
+    vector_size_t numRows;
+    int64_t bytes;
+  };
+
+  using Queue = std::queue<Batch>;
+
+  BlockingReason enqueue(Batch batch, ContinueFuture* future);
 
   bool isFinishedLocked(const Queue& queue) const;
 
+  static bool isCompactable(const Batch& batch) {
+    return batch.indices != nullptr &&
+        batch.numRows * kCompactRatio <= batch.input->size();
+  }
+
+  // Turns one or more batches dequeued together into a single RowVector.
+  static RowVectorPtr materialize(
+      std::vector<Batch>& batches,
+      memory::MemoryPool* pool);
+
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
+  const vector_size_t maxCompactRows_;
   folly::Synchronized<Queue> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
@@ -175,9 +221,32 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  // Counts the rows of the input batch per partition in 'partitions_' and
+  // reassigns the rows of skewed partitions to all partitions round-robin. A
+  // partition is skewed if it has received more than kSkewedPartitionPct % of
+  // its share of the rows so far.
+  void spreadSkewedRows(vector_size_t numInput);
+
+  // Minimum number of rows to receive before deciding that a partition is
+  // skewed.
+  static constexpr int64_t kSkewedPartitionMinRows = 10'000;
+  static constexpr int64_t kSkewedPartitionPct = 150;
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // If true, enqueues the shared input with per-partition indices instead of
+  // wrapping all columns in dictionaries for each partition. See
+  // QueryConfig::kLocalExchangeCompactPartitions.
+  const bool compactPartitions_;
+  // See core::LocalPartitionNode::spreadSkewedPartitions().
+  const bool spreadSkewedPartitions_;
+
+  // Number of rows received per partition before spreading skewed partitions.
+  std::vector<int64_t> partitionRows_;
+  int64_t numRows_{0};
+  // Partition that gets the next row of a skewed partition.
+  uint32_t nextSpreadPartition_{0};
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
@@ -304,7 +304,12 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange") {
+  serdeOptions_.compressionKind =
+      OutputBufferManager::getInstance().lock()->compressionKind();
+  serdeOptions_.adaptiveCompression =
+      driverCtx->queryConfig().exchangeAdaptiveCompression();
+}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
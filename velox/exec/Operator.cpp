@@ -533,6 +533,11 @@ void OperatorStats::add(const OperatorStats& other) {
   inputBytes += other.inputBytes;
   inputPositions += other.inputPositions;
   inputVectors += other.inputVectors;
+  if (other.driverInputPositions.count == 0) {
+    driverInputPositions.addValue(other.inputPositions);
+  } else {
+    driverInputPositions.merge(other.driverInputPositions);
+  }
 
   getOutputTiming.add(other.getOutputTiming);
   outputBytes += other.outputBytes;
@@ -579,6 +584,7 @@ void OperatorStats::clear() {
   addInputTiming.clear();
   inputBytes = 0;
   inputPositions = 0;
+  driverInputPositions = RuntimeMetric();
 
   getOutputTiming.clear();
   outputBytes = 0;
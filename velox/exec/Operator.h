@@ -130,6 +130,10 @@ struct OperatorStats {
   uint64_t inputBytes = 0;
   uint64_t inputPositions = 0;
 
+  /// Distribution of 'inputPositions' over the drivers whose stats were added
+  /// up with add(). Empty for the stats of a single driver.
+  RuntimeMetric driverInputPositions;
+
   /// Contains the dynamic filters stats if applied.
   DynamicFilterStats dynamicFilterStats;
 
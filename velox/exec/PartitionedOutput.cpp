@@ -57,6 +57,7 @@ BlockingReason Destination::advance(
     serializer::presto::PrestoVectorSerde::PrestoOptions options;
     options.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
+    options.adaptiveCompression = adaptiveCompression_;
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
@@ -155,7 +156,10 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      adaptiveCompression_(ctx->task->queryCtx()
+                               ->queryConfig()
+                               .exchangeAdaptiveCompression()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -197,7 +201,12 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          adaptiveCompression_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
           }));
@@ -25,6 +25,8 @@ namespace facebook::velox::exec {
 namespace detail {
 class Destination {
  public:
+  /// @param adaptiveCompression If true, the codec is chosen for each page.
+  /// See PrestoVectorSerde::PrestoOptions::adaptiveCompression.
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
   Destination(
@@ -32,11 +34,13 @@ class Destination {
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
+      bool adaptiveCompression,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        adaptiveCompression_(adaptiveCompression),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -107,6 +111,7 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  const bool adaptiveCompression_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -220,6 +225,7 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool adaptiveCompression_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -35,6 +35,9 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   inputRows += stats.inputPositions;
   inputBytes += stats.inputBytes;
   inputVectors += stats.inputVectors;
+  if (stats.driverInputPositions.count > 0) {
+    inputRowsPerDriver.merge(stats.driverInputPositions);
+  }
 
   rawInputRows += stats.rawInputPositions;
   rawInputBytes += stats.rawInputBytes;
@@ -112,6 +115,11 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
     out << ", Threads: " << numDrivers;
   }
 
+  if (inputRowsPerDriver.count > 1) {
+    out << ", Input rows per thread: min " << inputRowsPerDriver.min
+        << " max " << inputRowsPerDriver.max;
+  }
+
   if (numSplits > 0) {
     out << ", Splits: " << numSplits;
   }
@@ -182,6 +190,8 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
       stat["physicalWrittenBytes"] = operatorStat.second->physicalWrittenBytes;
       stat["numDrivers"] = operatorStat.second->numDrivers;
+      stat["inputRowsPerDriver"] =
+          operatorStat.second->inputRowsPerDriver.toString();
       stat["numSplits"] = operatorStat.second->numSplits;
       stat["spilledInputBytes"] = operatorStat.second->spilledInputBytes;
       stat["spilledBytes"] = operatorStat.second->spilledBytes;
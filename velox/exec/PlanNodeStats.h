@@ -118,6 +118,10 @@ struct PlanNodeStats {
   /// Number of drivers that executed the pipeline.
   int numDrivers{0};
 
+  /// Distribution of input rows over the drivers of the corresponding
+  /// operators. 'min' and 'max' show how evenly the input is balanced.
+  RuntimeMetric inputRowsPerDriver;
+
   /// Number of total splits.
   int numSplits{0};
 
@@ -1758,10 +1758,24 @@ class RowComparator {
       RowContainer* rowContainer);
 
   /// Returns true if lhs < rhs, false otherwise.
-  bool operator()(const char* lhs, const char* rhs);
+  bool operator()(const char* lhs, const char* rhs) {
+    return compare(lhs, rhs) < 0;
+  }
 
   /// Returns true if decodeVectors[index] < rhs, false otherwise.
   bool operator()(
+      const std::vector<DecodedVector>& decodedVectors,
+      vector_size_t index,
+      const char* rhs) {
+    return compare(decodedVectors, index, rhs) < 0;
+  }
+
+  /// Returns a negative value if lhs < rhs, zero if lhs and rhs have equal
+  /// sorting keys and a positive value otherwise.
+  int32_t compare(const char* lhs, const char* rhs);
+
+  /// Compares decodeVectors[index] with rhs like compare(lhs, rhs).
+  int32_t compare(
       const std::vector<DecodedVector>& decodedVectors,
       vector_size_t index,
       const char* rhs);
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/SortedAggregations.h"
 #include "velox/common/base/RawVector.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -60,10 +61,28 @@ struct RowPointers {
 };
 } // namespace
 
+namespace {
+// Returns true if all 'aggregates' use the same sorting keys and orders.
+bool haveSameSortingKeys(const std::vector<const AggregateInfo*>& aggregates) {
+  for (const auto* aggregate : aggregates) {
+    if (aggregate->sortingKeys != aggregates[0]->sortingKeys ||
+        aggregate->sortingOrders != aggregates[0]->sortingOrders) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 SortedAggregations::SortedAggregations(
     const std::vector<const AggregateInfo*>& aggregates,
     const RowTypePtr& inputType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::optional<common::PrefixSortConfig>& globalSortConfig) {
+  if (globalSortConfig.has_value() && haveSameSortingKeys(aggregates)) {
+    globalSortConfig_.emplace(globalSortConfig.value());
+  }
+
   // Collect inputs and sorting keys from all aggregates.
   std::unordered_set<column_index_t> allInputs;
   for (const auto* aggregate : aggregates) {
@@ -88,15 +107,44 @@ SortedAggregations::SortedAggregations(
 
   inputMapping_.resize(inputType->size());
 
-  std::vector<TypePtr> types;
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  if (globalSortConfig_.has_value()) {
+    // The group ordinal and the sorting keys are the keys of 'inputData_' in
+    // this order so that PrefixSort can sort by (group, sorting keys).
+    firstInputColumn_ = 1;
+    keyTypes.push_back(INTEGER());
+    globalSortCompareFlags_.push_back({true, true, false});
+
+    const auto* aggregate = aggregates[0];
+    for (auto i = 0; i < aggregate->sortingKeys.size(); ++i) {
+      const auto sortingKey = aggregate->sortingKeys[i];
+      if (allInputs.erase(sortingKey) == 0) {
+        // Duplicate sorting key.
+        continue;
+      }
+      const auto& sortOrder = aggregate->sortingOrders[i];
+      keyTypes.push_back(inputType->childAt(sortingKey));
+      globalSortCompareFlags_.push_back(
+          {sortOrder.isNullsFirst(), sortOrder.isAscending(), false});
+
+      inputMapping_[sortingKey] = firstInputColumn_ + inputs_.size();
+      inputs_.push_back(sortingKey);
+    }
+  }
+
   for (auto input : allInputs) {
-    types.push_back(inputType->childAt(input));
+    if (globalSortConfig_.has_value()) {
+      dependentTypes.push_back(inputType->childAt(input));
+    } else {
+      keyTypes.push_back(inputType->childAt(input));
+    }
 
-    inputMapping_[input] = inputs_.size();
+    inputMapping_[input] = firstInputColumn_ + inputs_.size();
     inputs_.push_back(input);
   }
 
-  inputData_ = std::make_unique<RowContainer>(types, pool);
+  inputData_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool);
   decodedInputs_.resize(inputs_.size());
 
   for (const auto& aggregate : aggregates) {
@@ -112,7 +160,8 @@ SortedAggregations::SortedAggregations(
 std::unique_ptr<SortedAggregations> SortedAggregations::create(
     const std::vector<AggregateInfo>& aggregates,
     const RowTypePtr& inputType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::optional<common::PrefixSortConfig>& globalSortConfig) {
   std::vector<const AggregateInfo*> sortedAggs;
   for (auto& aggregate : aggregates) {
     if (!aggregate.sortingKeys.empty()) {
@@ -127,7 +176,8 @@ std::unique_ptr<SortedAggregations> SortedAggregations::create(
     return nullptr;
   }
 
-  return std::make_unique<SortedAggregations>(sortedAggs, inputType, pool);
+  return std::make_unique<SortedAggregations>(
+      sortedAggs, inputType, pool, globalSortConfig);
 }
 
 SortedAggregations::SortingSpec SortedAggregations::toSortingSpec(
@@ -223,7 +273,7 @@ void SortedAggregations::addInput(char** groups, const RowVectorPtr& input) {
     char* newRow = inputData_->newRow();
 
     for (auto i = 0; i < inputs_.size(); ++i) {
-      inputData_->store(decodedInputs_[i], row, newRow, i);
+      inputData_->store(decodedInputs_[i], row, newRow, firstInputColumn_ + i);
     }
 
     addNewRow(groups[row], newRow);
@@ -248,7 +298,7 @@ void SortedAggregations::addSingleGroupInput(
     char* newRow = inputData_->newRow();
 
     for (auto i = 0; i < inputs_.size(); ++i) {
-      inputData_->store(decodedInputs_[i], row, newRow, i);
+      inputData_->store(decodedInputs_[i], row, newRow, firstInputColumn_ + i);
     }
 
     addNewRow(group, newRow);
@@ -341,7 +391,9 @@ vector_size_t SortedAggregations::extractSingleGroup(
       const auto columnIndex = inputMapping_[aggregate.inputs[i]];
       if (inputVectors[i] == nullptr) {
         inputVectors[i] = BaseVector::create(
-            inputData_->keyTypes()[columnIndex], numRows, inputData_->pool());
+            inputData_->columnTypes()[columnIndex],
+            numRows,
+            inputData_->pool());
       } else {
         BaseVector::prepareForReuse(inputVectors[i], numRows);
       }
@@ -363,62 +415,159 @@ vector_size_t SortedAggregations::extractSingleGroup(
   return numRows;
 }
 
-void SortedAggregations::extractValues(
+void SortedAggregations::addSortedInputPerGroup(
     folly::Range<char**> groups,
-    const RowVectorPtr& result) {
-  raw_vector<int32_t> temp;
+    const SortingSpec& sortingSpec,
+    const std::vector<const AggregateInfo*>& aggregates) {
   SelectivityVector rows;
   std::vector<char*> groupRows;
-  for (const auto& [sortingSpec, aggregates] : aggregates_) {
-    std::vector<VectorPtr> inputVectors;
-    size_t numInputColumns = 0;
-    for (const auto& aggregate : aggregates) {
-      numInputColumns += aggregate->inputs.size();
+  std::vector<VectorPtr> inputVectors;
+  size_t numInputColumns = 0;
+  for (const auto& aggregate : aggregates) {
+    numInputColumns += aggregate->inputs.size();
+  }
+  inputVectors.resize(numInputColumns);
+
+  // For each group, sort inputs, add them to aggregate.
+  for (auto* group : groups) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+    if (accumulator->size == 0) {
+      continue;
     }
-    inputVectors.resize(numInputColumns);
 
-    // For each group, sort inputs, add them to aggregate.
-    for (auto* group : groups) {
-      auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-      if (accumulator->size == 0) {
+    groupRows.resize(accumulator->size);
+    accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
+
+    sortSingleGroup(groupRows, sortingSpec);
+
+    size_t firstInputColumn = 0;
+    for (const auto& aggregate : aggregates) {
+      std::vector<VectorPtr> aggregateInputs;
+      aggregateInputs.reserve(aggregate->inputs.size());
+      for (auto i = 0; i < aggregate->inputs.size(); ++i) {
+        aggregateInputs.push_back(
+            std::move(inputVectors[firstInputColumn + i]));
+      }
+
+      // TODO Process group rows in batches to avoid creating very large input
+      // vectors.
+      const auto numRows =
+          extractSingleGroup(groupRows, *aggregate, aggregateInputs);
+      if (numRows == 0) {
+        // Mask must be false for all 'groupRows'.
         continue;
       }
 
-      groupRows.resize(accumulator->size);
-      accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
+      rows.resize(numRows);
+      aggregate->function->addSingleGroupRawInput(
+          group, rows, aggregateInputs, false);
 
-      sortSingleGroup(groupRows, sortingSpec);
+      for (auto i = 0; i < aggregate->inputs.size(); ++i) {
+        inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
+      }
 
-      size_t firstInputColumn = 0;
-      for (const auto& aggregate : aggregates) {
-        std::vector<VectorPtr> aggregateInputs;
-        aggregateInputs.reserve(aggregate->inputs.size());
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          aggregateInputs.push_back(
-              std::move(inputVectors[firstInputColumn + i]));
-        }
+      firstInputColumn += aggregateInputs.size();
+    }
+  }
+}
 
-        // TODO Process group rows in batches to avoid creating very large input
-        // vectors.
-        const auto numRows =
-            extractSingleGroup(groupRows, *aggregate, aggregateInputs);
-        if (numRows == 0) {
-          // Mask must be false for all 'groupRows'.
-          continue;
-        }
+void SortedAggregations::addSortedInputGlobal(
+    folly::Range<char**> groups,
+    const std::vector<const AggregateInfo*>& aggregates) {
+  size_t numRows = 0;
+  for (auto* group : groups) {
+    numRows += reinterpret_cast<RowPointers*>(group + offset_)->size;
+  }
+  if (numRows == 0) {
+    return;
+  }
+  VELOX_CHECK_LE(numRows, std::numeric_limits<vector_size_t>::max());
 
-        rows.resize(numRows);
-        aggregate->function->addSingleGroupRawInput(
-            group, rows, aggregateInputs, false);
+  // Collect the rows of all groups and tag each row with the ordinal of its
+  // group.
+  const auto ordinalColumn = inputData_->columnAt(0);
+  std::vector<char*> sortedRows(numRows);
+  size_t offset = 0;
+  for (auto i = 0; i < groups.size(); ++i) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+    accumulator->read(
+        folly::Range(sortedRows.data() + offset, accumulator->size));
+    for (auto j = 0; j < accumulator->size; ++j) {
+      char* row = sortedRows[offset + j];
+      *reinterpret_cast<int32_t*>(row + ordinalColumn.offset()) = i;
+      row[ordinalColumn.nullByte()] &= ~ordinalColumn.nullMask();
+    }
+    offset += accumulator->size;
+  }
+
+  PrefixSort::sort(
+      sortedRows,
+      inputData_->pool(),
+      inputData_.get(),
+      globalSortCompareFlags_,
+      globalSortConfig_.value());
+
+  std::vector<char*> rowGroups(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    rowGroups[i] = groups[*reinterpret_cast<const int32_t*>(
+        sortedRows[i] + ordinalColumn.offset())];
+  }
 
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
+  SelectivityVector rows;
+  std::vector<VectorPtr> inputVectors;
+  for (const auto& aggregate : aggregates) {
+    rows.resizeFill(numRows, true);
+    if (aggregate->mask) {
+      FlatVectorPtr<bool> mask = BaseVector::create<FlatVector<bool>>(
+          BOOLEAN(), numRows, inputData_->pool());
+      inputData_->extractColumn(
+          sortedRows.data(),
+          numRows,
+          inputMapping_[aggregate->mask.value()],
+          mask);
+      for (auto i = 0; i < numRows; ++i) {
+        if (mask->isNullAt(i) || !mask->valueAt(i)) {
+          rows.setValid(i, false);
         }
+      }
+      rows.updateBounds();
+      if (!rows.hasSelections()) {
+        continue;
+      }
+    }
 
-        firstInputColumn += aggregateInputs.size();
+    const auto numInputs = aggregate->inputs.size();
+    inputVectors.resize(numInputs);
+    for (auto i = 0; i < numInputs; ++i) {
+      if (aggregate->inputs[i] == kConstantChannel) {
+        inputVectors[i] = aggregate->constantInputs[i];
+      } else {
+        const auto columnIndex = inputMapping_[aggregate->inputs[i]];
+        inputVectors[i] = BaseVector::create(
+            inputData_->columnTypes()[columnIndex],
+            numRows,
+            inputData_->pool());
+        inputData_->extractColumn(
+            sortedRows.data(), numRows, columnIndex, inputVectors[i]);
       }
     }
 
+    aggregate->function->addRawInput(
+        rowGroups.data(), rows, inputVectors, false);
+  }
+}
+
+void SortedAggregations::extractValues(
+    folly::Range<char**> groups,
+    const RowVectorPtr& result) {
+  raw_vector<int32_t> temp;
+  for (const auto& [sortingSpec, aggregates] : aggregates_) {
+    if (globalSortConfig_.has_value()) {
+      addSortedInputGlobal(groups, aggregates);
+    } else {
+      addSortedInputPerGroup(groups, sortingSpec, aggregates);
+    }
+
     for (const auto& aggregate : aggregates) {
       aggregate->function->extractValues(
           groups.data(), groups.size(), &result->childAt(aggregate->output));
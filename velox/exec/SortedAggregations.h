@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/RowContainer.h"
@@ -24,23 +25,37 @@ namespace facebook::velox::exec {
 
 /// Accumulates inputs for aggregations over sorted input, sorts these inputs
 /// and computes aggregates.
+///
+/// By default, the inputs of each group are sorted separately. In global sort
+/// mode, all inputs of the groups being extracted are sorted at once by
+/// (group, sorting keys) using PrefixSort and the contiguous group runs are
+/// added to the aggregates in one addRawInput call. This avoids many tiny sorts
+/// and per-group calls when there are many small groups. Global sort mode
+/// requires all aggregates to share the same sorting keys and orders and falls
+/// back to per-group sorting otherwise.
 class SortedAggregations {
  public:
   /// @param aggregates Non-empty list of aggregates that require inputs to be
   /// sorted.
   /// @param inputType Input row type for the aggregation operator.
   /// @param pool Memory pool.
+  /// @param globalSortConfig If set, enables global sort mode using the
+  /// specified PrefixSort config.
   SortedAggregations(
       const std::vector<const AggregateInfo*>& aggregates,
       const RowTypePtr& inputType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const std::optional<common::PrefixSortConfig>& globalSortConfig =
+          std::nullopt);
 
   /// Create a SortedAggregations instance using aggregation infos. Return null
   /// if there is no sorted aggregation.
   static std::unique_ptr<SortedAggregations> create(
       const std::vector<AggregateInfo>& aggregates,
       const RowTypePtr& inputType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      const std::optional<common::PrefixSortConfig>& globalSortConfig =
+          std::nullopt);
 
   /// Returns metadata about the accumulator used to store lists of input rows.
   Accumulator accumulator() const;
@@ -107,6 +122,19 @@ class SortedAggregations {
       const AggregateInfo& aggregate,
       std::vector<VectorPtr>& inputVectors);
 
+  // Sorts inputs of each group in 'groups' separately and adds these to
+  // 'aggregates' one group at a time.
+  void addSortedInputPerGroup(
+      folly::Range<char**> groups,
+      const SortingSpec& sortingSpec,
+      const std::vector<const AggregateInfo*>& aggregates);
+
+  // Sorts inputs of all 'groups' at once by (group, sorting keys) and adds
+  // these to 'aggregates' in a single addRawInput call per aggregate.
+  void addSortedInputGlobal(
+      folly::Range<char**> groups,
+      const std::vector<const AggregateInfo*>& aggregates);
+
   void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
   struct Hash {
@@ -143,13 +171,25 @@ class SortedAggregations {
       F14FastMap<SortingSpec, std::vector<const AggregateInfo*>, Hash, EqualTo>
           aggregates_;
 
+  // Set in global sort mode.
+  std::optional<common::PrefixSortConfig> globalSortConfig_;
+
+  // Compare flags for the key columns of 'inputData_' in global sort mode: the
+  // group ordinal followed by the sorting keys.
+  std::vector<CompareFlags> globalSortCompareFlags_;
+
+  // Index of the column of 'inputData_' that stores the first input. In global
+  // sort mode, column 0 is reserved for the group ordinal which is set right
+  // before sorting.
+  column_index_t firstInputColumn_{0};
+
   // Indices of all inputs for all aggregates.
   std::vector<column_index_t> inputs_;
 
   // Stores all input rows for all groups.
   std::unique_ptr<RowContainer> inputData_;
 
-  // Mapping from the input column index to an index into 'inputs_'.
+  // Mapping from the input column index to a column of 'inputData_'.
   std::vector<column_index_t> inputMapping_;
 
   std::vector<DecodedVector> decodedInputs_;
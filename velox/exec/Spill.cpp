@@ -76,7 +76,8 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    common::SpillDirectories* spillDirectories)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -87,6 +88,7 @@ SpillState::SpillState(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       fileCreateConfig_(fileCreateConfig),
+      spillDirectories_(spillDirectories),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -121,18 +123,24 @@ uint64_t SpillState::appendToPartition(
   VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
   // Ensure that partition exist before writing.
   if (partitionWriters_.at(partition) == nullptr) {
+    // With striped spill directories, the writer picks the directory of each
+    // file and the path prefix is relative to it.
+    const auto pathPrefix = spillDirectories_ != nullptr
+        ? fmt::format("{}-spill-{}", fileNamePrefix_, partition)
+        : fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition);
     partitionWriters_[partition] = std::make_unique<SpillWriter>(
         std::static_pointer_cast<const RowType>(rows->type()),
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
-        fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
+        pathPrefix,
         targetFileSize_,
         writeBufferSize_,
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        spillDirectories_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -278,6 +286,13 @@ uint32_t FileSpillMergeStream::id() const {
   return spillFile_->id();
 }
 
+uint32_t FileSpillMergeStream::skipBatchesWithCurrentKeys(uint32_t numKeys) {
+  VELOX_CHECK(hasData());
+  // The unread rows do not sort before the current row, so a batch whose last
+  // row does not sort after it on 'numKeys' keys has only equal keys.
+  return spillFile_->skipBatchesUpTo(*rowVector_, index_, numKeys);
+}
+
 void FileSpillMergeStream::nextBatch() {
   index_ = 0;
   if (!spillFile_->nextBatch(rowVector_)) {
@@ -68,6 +68,14 @@ class SpillMergeStream : public MergeStream {
     return index_;
   }
 
+  /// Skips the unread batches after the current one whose rows all have the
+  /// same first 'numKeys' sort keys as the current row, without reading them.
+  /// A merge consumer calls this to drop the rest of a key range. Returns the
+  /// number of skipped batches. Only file streams with a footer index skip.
+  virtual uint32_t skipBatchesWithCurrentKeys(uint32_t /*numKeys*/) {
+    return 0;
+  }
+
   /// Returns a DecodedVector set decoding the 'index'th child of 'rowVector_'
   DecodedVector& decoded(int32_t index) {
     ensureDecodedValid(index);
@@ -140,6 +148,8 @@ class FileSpillMergeStream : public SpillMergeStream {
 
   uint32_t id() const override;
 
+  uint32_t skipBatchesWithCurrentKeys(uint32_t numKeys) override;
+
  private:
   explicit FileSpillMergeStream(std::unique_ptr<SpillReadFile> spillFile)
       : spillFile_(std::move(spillFile)) {
@@ -345,7 +355,8 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      common::SpillDirectories* spillDirectories = nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -440,6 +451,8 @@ class SpillState {
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
   const std::string fileCreateConfig_;
+  // If set, spill files are striped across these directories.
+  common::SpillDirectories* const spillDirectories_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
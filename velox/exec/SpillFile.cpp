@@ -26,6 +26,108 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// The spill file footer index is written after the serialized batches:
+//
+//   [key bounds][batch index entries][trailer]
+//
+// 'key bounds' is a serialized row vector of the sort key columns holding the
+// first and last row of each batch. It is omitted if there are no sort keys.
+// Each batch index entry is the batch byte offset (uint64_t) followed by its
+// number of rows (uint32_t). The trailer is the byte size of the batch data
+// (uint64_t), the byte size of 'key bounds' (uint32_t), the number of batches
+// (uint32_t) and 'kFooterMagic' (uint32_t). Files without the trailer are read
+// sequentially.
+constexpr uint32_t kFooterMagic = 0x58444e49; // "INDX"
+constexpr uint32_t kIndexEntrySize = sizeof(uint64_t) + sizeof(uint32_t);
+constexpr uint32_t kTrailerSize = sizeof(uint64_t) + 3 * sizeof(uint32_t);
+
+template <typename T>
+void appendValue(T value, std::string& out) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(const char*& data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+  return value;
+}
+
+RowTypePtr sortKeyType(const RowTypePtr& type, uint32_t numSortKeys) {
+  if (numSortKeys == 0) {
+    return nullptr;
+  }
+  std::vector<std::string> names(
+      type->names().begin(), type->names().begin() + numSortKeys);
+  std::vector<TypePtr> types(
+      type->children().begin(), type->children().begin() + numSortKeys);
+  return ROW(std::move(names), std::move(types));
+}
+
+serializer::presto::PrestoVectorSerde::PrestoOptions keyBoundsOptions() {
+  return {
+      kDefaultUseLosslessTimestamp,
+      common::CompressionKind::CompressionKind_NONE,
+      /*nullsFirst=*/true};
+}
+
+// Exposes the serialized batch data of a spill file without the footer index
+// to the FileInputStream so that its buffering and read-ahead never touches
+// the footer.
+class SpillDataReadFile : public ReadFile {
+ public:
+  SpillDataReadFile(std::unique_ptr<ReadFile> file, uint64_t size)
+      : file_(std::move(file)), size_(size) {
+    VELOX_CHECK_LE(size_, file_->size());
+  }
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override {
+    return file_->pread(offset, length, buf);
+  }
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return file_->preadv(offset, buffers);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return file_->preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return file_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  const std::unique_ptr<ReadFile> file_;
+  const uint64_t size_;
+};
 } // namespace
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -82,7 +184,8 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    common::SpillDirectories* spillDirectories)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -91,9 +194,11 @@ SpillWriter::SpillWriter(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
+      sortKeyType_(sortKeyType(type_, numSortKeys_)),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      spillDirectories_(spillDirectories) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
@@ -104,11 +209,23 @@ SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
   }
+  // Moves on to a new file in another directory rather than adding to a
+  // saturated one. A sorted run may span any number of files as they are
+  // merged.
+  if ((currentFile_ != nullptr) && (spillDirectories_ != nullptr) &&
+      spillDirectories_->saturated(currentDirectory_) &&
+      !spillDirectories_->allSaturated()) {
+    closeFile();
+  }
   if (currentFile_ == nullptr) {
+    auto pathPrefix = fmt::format("{}-{}", pathPrefix_, finishedFiles_.size());
+    if (spillDirectories_ != nullptr) {
+      currentDirectory_ = spillDirectories_->selectDirectory();
+      pathPrefix = fmt::format(
+          "{}/{}", spillDirectories_->path(currentDirectory_), pathPrefix);
+    }
     currentFile_ = SpillWriteFile::create(
-        nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_);
+        nextFileId_++, pathPrefix, fileCreateConfig_);
   }
   return currentFile_.get();
 }
@@ -117,8 +234,13 @@ void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  writeFooter();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
+  if (spillDirectories_ != nullptr) {
+    const auto& path = spillDirectories_->path(currentDirectory_);
+    ++stats_->wlock()->spillDirectoryStats[path].spilledFiles;
+  }
   finishedFiles_.push_back(SpillFileInfo{
       .id = currentFile_->id(),
       .type = type_,
@@ -130,6 +252,109 @@ void SpillWriter::closeFile() {
   currentFile_.reset();
 }
 
+uint64_t SpillWriter::writeFooter() {
+  VELOX_CHECK_NOT_NULL(currentFile_);
+  VELOX_CHECK(!fileIndex_.empty());
+  const uint64_t dataSize = currentFile_->size();
+
+  std::unique_ptr<folly::IOBuf> iobuf;
+  uint32_t keyBoundsSize{0};
+  if (fileKeyBounds_ != nullptr) {
+    IOBufOutputStream out(*pool_);
+    auto options = keyBoundsOptions();
+    VectorStreamGroup keyBounds(pool_);
+    keyBounds.createStreamTree(sortKeyType_, fileKeyBounds_->size(), &options);
+    keyBounds.append(fileKeyBounds_);
+    keyBounds.flush(&out);
+    iobuf = out.getIOBuf();
+    keyBoundsSize = iobuf->computeChainDataLength();
+  }
+
+  std::string index;
+  index.reserve(fileIndex_.size() * kIndexEntrySize + kTrailerSize);
+  for (const auto& entry : fileIndex_) {
+    appendValue(entry.offset, index);
+    appendValue(entry.numRows, index);
+  }
+  appendValue(dataSize, index);
+  appendValue(keyBoundsSize, index);
+  appendValue<uint32_t>(fileIndex_.size(), index);
+  appendValue(kFooterMagic, index);
+  if (iobuf == nullptr) {
+    iobuf = folly::IOBuf::copyBuffer(index);
+  } else {
+    iobuf->prependChain(folly::IOBuf::copyBuffer(index));
+  }
+  fileIndex_.clear();
+  fileKeyBounds_.reset();
+
+  uint64_t writeTimeNs{0};
+  const uint64_t writtenBytes = writeToFile(std::move(iobuf), writeTimeNs);
+  {
+    auto statsLocked = stats_->wlock();
+    statsLocked->spilledBytes += writtenBytes;
+    statsLocked->spillWriteTimeNanos += writeTimeNs;
+  }
+  common::updateGlobalSpillFooterWriteStats(writtenBytes, writeTimeNs);
+  updateAndCheckSpillLimitCb_(writtenBytes);
+  return writtenBytes;
+}
+
+void SpillWriter::updateBatchIndex(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  const bool firstRows = batchNumRows_ == 0;
+  const IndexRange* firstRange{nullptr};
+  const IndexRange* lastRange{nullptr};
+  for (const auto& range : indices) {
+    if (range.size == 0) {
+      continue;
+    }
+    if (firstRange == nullptr) {
+      firstRange = &range;
+    }
+    lastRange = &range;
+    batchNumRows_ += range.size;
+  }
+  if (sortKeyType_ == nullptr || lastRange == nullptr) {
+    return;
+  }
+  if (batchKeyBounds_ == nullptr) {
+    batchKeyBounds_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(sortKeyType_, 2, pool_));
+  }
+  for (uint32_t i = 0; i < numSortKeys_; ++i) {
+    auto& bounds = batchKeyBounds_->childAt(i);
+    const auto* source = rows->childAt(i).get();
+    if (firstRows) {
+      bounds->copy(source, 0, firstRange->begin, 1);
+    }
+    bounds->copy(source, 1, lastRange->begin + lastRange->size - 1, 1);
+  }
+}
+
+void SpillWriter::addBatchIndex(uint64_t offset) {
+  fileIndex_.push_back(SpillBatchIndex{offset, batchNumRows_});
+  if (sortKeyType_ != nullptr) {
+    if (fileKeyBounds_ == nullptr) {
+      fileKeyBounds_ = std::static_pointer_cast<RowVector>(
+          BaseVector::create(sortKeyType_, 0, pool_));
+    }
+    const auto target = fileKeyBounds_->size();
+    fileKeyBounds_->resize(target + 2);
+    if (batchNumRows_ > 0) {
+      fileKeyBounds_->copy(batchKeyBounds_.get(), target, 0, 2);
+    } else {
+      // An empty batch has no key bounds and is always skippable.
+      for (auto& child : fileKeyBounds_->children()) {
+        child->setNull(target, true);
+        child->setNull(target + 1, true);
+      }
+    }
+  }
+  batchNumRows_ = 0;
+}
+
 size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
@@ -141,6 +366,7 @@ uint64_t SpillWriter::flush() {
 
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
+  const uint64_t batchOffset = file->size();
 
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
@@ -152,12 +378,8 @@ uint64_t SpillWriter::flush() {
   batch_.reset();
 
   uint64_t writeTimeNs{0};
-  uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
-  {
-    NanosecondTimer timer(&writeTimeNs);
-    writtenBytes = file->write(std::move(iobuf));
-  }
+  const uint64_t writtenBytes = writeToFile(out.getIOBuf(), writeTimeNs);
+  addBatchIndex(batchOffset);
   updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
@@ -181,6 +403,7 @@ uint64_t SpillWriter::write(
           &options);
     }
     batch_->append(rows, indices);
+    updateBatchIndex(rows, indices);
   }
   updateAppendStats(rows->size(), timeNs);
   if (batch_->size() < writeBufferSize_) {
@@ -189,6 +412,39 @@ uint64_t SpillWriter::write(
   return flush();
 }
 
+uint64_t SpillWriter::writeToFile(
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t& writeTimeNs) {
+  VELOX_CHECK_NOT_NULL(currentFile_);
+  if (spillDirectories_ == nullptr) {
+    NanosecondTimer timer(&writeTimeNs);
+    return currentFile_->write(std::move(iobuf));
+  }
+
+  const uint32_t queueDepth = spillDirectories_->startWrite(currentDirectory_);
+  uint64_t writtenBytes{0};
+  uint64_t fileWriteTimeNs{0};
+  {
+    auto finishGuard = folly::makeGuard([&]() {
+      spillDirectories_->finishWrite(
+          currentDirectory_, writtenBytes, fileWriteTimeNs);
+    });
+    NanosecondTimer timer(&fileWriteTimeNs);
+    writtenBytes = currentFile_->write(std::move(iobuf));
+  }
+  writeTimeNs += fileWriteTimeNs;
+
+  const auto& path = spillDirectories_->path(currentDirectory_);
+  auto statsLocked = stats_->wlock();
+  auto& directoryStats = statsLocked->spillDirectoryStats[path];
+  ++directoryStats.spillWrites;
+  directoryStats.spilledBytes += writtenBytes;
+  directoryStats.spillWriteTimeNanos += fileWriteTimeNs;
+  directoryStats.maxQueueDepth =
+      std::max(directoryStats.maxQueueDepth, queueDepth);
+  return writtenBytes;
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeNs) {
@@ -303,8 +559,68 @@ SpillReadFile::SpillReadFile(
       stats_(stats) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
+  const auto dataSize = readFooter(*file);
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::make_unique<SpillDataReadFile>(std::move(file), dataSize),
+      bufferSize,
+      pool_);
+}
+
+uint64_t SpillReadFile::readFooter(const ReadFile& file) {
+  const uint64_t fileSize = file.size();
+  if (fileSize < kTrailerSize) {
+    return fileSize;
+  }
+  const auto trailer = file.pread(fileSize - kTrailerSize, kTrailerSize);
+  const char* data = trailer.data();
+  const auto dataSize = readValue<uint64_t>(data);
+  const auto keyBoundsSize = readValue<uint32_t>(data);
+  const auto numBatches = readValue<uint32_t>(data);
+  const auto magic = readValue<uint32_t>(data);
+  if (magic != kFooterMagic ||
+      dataSize + keyBoundsSize +
+              static_cast<uint64_t>(numBatches) * kIndexEntrySize +
+              kTrailerSize !=
+          fileSize) {
+    return fileSize;
+  }
+
+  uint64_t readTimeNs{0};
+  std::string footer;
+  {
+    NanosecondTimer timer{&readTimeNs};
+    footer = file.pread(dataSize, fileSize - dataSize - kTrailerSize);
+  }
+  footerSize_ = fileSize - dataSize;
+  if (keyBoundsSize > 0) {
+    VELOX_CHECK_GT(numSortKeys_, 0);
+    auto options = keyBoundsOptions();
+    BufferInputStream input({ByteRange{
+        reinterpret_cast<uint8_t*>(footer.data()),
+        static_cast<int32_t>(keyBoundsSize),
+        0}});
+    VectorStreamGroup::read(
+        &input,
+        pool_,
+        sortKeyType(type_, numSortKeys_),
+        &keyBounds_,
+        &options);
+    VELOX_CHECK_EQ(keyBounds_->size(), 2 * numBatches);
+  }
+  data = footer.data() + keyBoundsSize;
+  index_.reserve(numBatches);
+  for (uint32_t i = 0; i < numBatches; ++i) {
+    const auto offset = readValue<uint64_t>(data);
+    const auto numRows = readValue<uint32_t>(data);
+    index_.push_back(SpillBatchIndex{offset, numRows});
+  }
+
+  auto lockedSpillStats = stats_->wlock();
+  ++lockedSpillStats->spillReads;
+  lockedSpillStats->spillReadTimeNanos += readTimeNs;
+  lockedSpillStats->spillReadBytes += footerSize_;
+  common::updateGlobalSpillReadStats(1, footerSize_, readTimeNs);
+  return dataSize;
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -319,11 +635,61 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
     VectorStreamGroup::read(
         input_.get(), pool_, type_, &rowVector, &readOptions_);
   }
+  ++nextBatchIndex_;
   stats_->wlock()->spillDeserializationTimeNanos += timeNs;
   common::updateGlobalSpillDeserializationTimeNs(timeNs);
   return true;
 }
 
+void SpillReadFile::seekToBatch(uint32_t batch) {
+  VELOX_CHECK(hasIndex(), "Spill file {} has no footer index", path_);
+  VELOX_CHECK_GE(
+      batch, nextBatchIndex_, "Backward seek is not supported by spill file");
+  VELOX_CHECK_LE(batch, index_.size());
+  if (batch == nextBatchIndex_) {
+    return;
+  }
+  const uint64_t offset =
+      batch == index_.size() ? input_->size() : index_[batch].offset;
+  input_->seekp(offset);
+  nextBatchIndex_ = batch;
+}
+
+uint32_t SpillReadFile::skipBatchesUpTo(
+    const RowVector& keys,
+    vector_size_t row,
+    uint32_t numKeys) {
+  if (keyBounds_ == nullptr) {
+    return 0;
+  }
+  VELOX_CHECK_LE(numKeys, numSortKeys_);
+  uint32_t batch = nextBatchIndex_;
+  for (; batch < index_.size(); ++batch) {
+    if (index_[batch].numRows == 0) {
+      continue;
+    }
+    // Stops at the first batch whose last row sorts after 'row'.
+    const vector_size_t lastRow = 2 * batch + 1;
+    int32_t result{0};
+    for (uint32_t key = 0; key < numKeys && result == 0; ++key) {
+      result = keyBounds_->childAt(key)
+                   ->compare(
+                       keys.childAt(key).get(),
+                       lastRow,
+                       row,
+                       sortCompareFlags_.empty() ? CompareFlags()
+                                                 : sortCompareFlags_[key])
+                   .value();
+    }
+    if (result > 0) {
+      break;
+    }
+  }
+  const uint32_t numSkipped = batch - nextBatchIndex_;
+  seekToBatch(batch);
+  return numSkipped;
+}
+
 void SpillReadFile::recordSpillStats() {
   VELOX_CHECK(input_->atEnd());
   const auto readStats = input_->stats();
@@ -33,6 +33,17 @@
 
 namespace facebook::velox::exec {
 
+/// Locates a serialized batch in a spill file. Spill files end with a footer
+/// index holding one entry per batch, followed by the sort key bounds of each
+/// batch when the spilled data is sorted. The footer lets the reader seek to a
+/// batch and skip the batches that a sorted merge has advanced past without
+/// reading them from disk.
+struct SpillBatchIndex {
+  /// The byte offset of the batch in the file.
+  uint64_t offset;
+  uint32_t numRows;
+};
+
 /// Represents a spill file for writing the serialized spilled data into a disk
 /// file.
 class SpillWriteFile {
@@ -106,7 +117,9 @@ class SpillWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'spillDirectories' is set, each new file is
+  /// placed in a directory selected from it and 'pathPrefix' is relative to
+  /// that directory.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -121,7 +134,8 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      common::SpillDirectories* spillDirectories = nullptr);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -156,12 +170,29 @@ class SpillWriter {
   // Returns an open spill file for write. If there is no open spill file, then
   // the function creates a new one. If the current open spill file exceeds the
   // target file size limit, then it first closes the current one and then
-  // creates a new one. 'currentFile_' points to the current open spill file.
+  // creates a new one. It also starts a new file if the directory of the
+  // current one is saturated and another directory is not. 'currentFile_'
+  // points to the current open spill file.
   SpillWriteFile* ensureFile();
 
-  // Closes the current open spill file pointed by 'currentFile_'.
+  // Closes the current open spill file pointed by 'currentFile_' after
+  // writing the footer index.
   void closeFile();
 
+  // Writes the footer index of the current open spill file and returns the
+  // written size.
+  uint64_t writeFooter();
+
+  // Records the row count and the sort key bounds of the rows appended to
+  // 'batch_' for the footer index.
+  void updateBatchIndex(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Adds the index entry of the flushed batch which was written at 'offset'
+  // of the current file.
+  void addBatchIndex(uint64_t offset);
+
   // Writes data from 'batch_' to the current output file. Returns the actual
   // written size.
   uint64_t flush();
@@ -172,6 +203,13 @@ class SpillWriter {
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
 
+  // Writes 'iobuf' to the current file and returns the written size. If the
+  // spill directories are striped, it tracks the write load of the directory
+  // in 'spillDirectories_' and 'stats_'.
+  uint64_t writeToFile(
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t& writeTimeNs);
+
   // Invoked to update the disk write stats.
   void updateWriteStats(
       uint64_t spilledBytes,
@@ -186,18 +224,33 @@ class SpillWriter {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
+  // The type of the leading sort key columns. Null if 'numSortKeys_' is 0.
+  const RowTypePtr sortKeyType_;
 
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  common::SpillDirectories* const spillDirectories_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The index of the spill directory of 'currentFile_' in
+  // 'spillDirectories_'.
+  uint32_t currentDirectory_{0};
   SpillFiles finishedFiles_;
+
+  // The number of rows in 'batch_'.
+  uint32_t batchNumRows_{0};
+  // The first and last sort key rows of 'batch_'.
+  RowVectorPtr batchKeyBounds_;
+  // The index entries of the batches in 'currentFile_'.
+  std::vector<SpillBatchIndex> fileIndex_;
+  // The sort key bounds of the batches in 'currentFile_'.
+  RowVectorPtr fileKeyBounds_;
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -229,6 +282,44 @@ class SpillReadFile {
 
   bool nextBatch(RowVectorPtr& rowVector);
 
+  /// Returns true if the file has a footer index. A file without one can only
+  /// be read sequentially.
+  bool hasIndex() const {
+    return !index_.empty();
+  }
+
+  /// Returns the footer index entries, one per batch in file order.
+  const std::vector<SpillBatchIndex>& index() const {
+    return index_;
+  }
+
+  /// Returns a row vector of the sort key columns holding the first and last
+  /// row of batch 'i' at positions 2 * i and 2 * i + 1. Null if the file has
+  /// no footer index or no sort keys.
+  const RowVectorPtr& keyBounds() const {
+    return keyBounds_;
+  }
+
+  /// Returns the index of the next batch returned by nextBatch().
+  uint32_t nextBatchIndex() const {
+    return nextBatchIndex_;
+  }
+
+  /// Positions the reader at the start of 'batch' without reading the skipped
+  /// batches from disk. Only forward seeks are supported. Seeking to
+  /// index().size() positions the reader at the end of the file.
+  void seekToBatch(uint32_t batch);
+
+  /// Skips the unread batches whose rows all sort at or before row 'row' of
+  /// 'keys' on the first 'numKeys' sort keys and returns the number of skipped
+  /// batches. The leading columns of 'keys' are the sort keys. A sorted merge
+  /// uses this to drop the rest of a key range without reading it. No-op if
+  /// the file has no footer index or sort keys.
+  uint32_t skipBatchesUpTo(
+      const RowVector& keys,
+      vector_size_t row,
+      uint32_t numKeys);
+
   /// Returns the file size in bytes.
   uint64_t size() const {
     return size_;
@@ -256,6 +347,10 @@ class SpillReadFile {
   void recordSpillStats();
 #endif
 
+  // Reads the footer index from 'file' if present and returns the size of
+  // the serialized batch data in the file.
+  uint64_t readFooter(const ReadFile& file);
+
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
@@ -271,6 +366,13 @@ class SpillReadFile {
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
+  // The footer index entries. Empty if the file has no footer index.
+  std::vector<SpillBatchIndex> index_;
+  RowVectorPtr keyBounds_;
+  // The byte size of the footer index read from the file.
+  uint64_t footerSize_{0};
+  uint32_t nextBatchIndex_{0};
+
   std::unique_ptr<common::FileInputStream> input_;
 };
 } // namespace facebook::velox::exec
@@ -62,8 +62,14 @@ void StreamingAggregation::initialize() {
       *aggregationNode_, *operatorCtx_, numKeys, expressionEvaluator, true);
 
   // Setup SortedAggregations.
-  sortedAggregations_ =
-      SortedAggregations::create(aggregates_, inputType, pool());
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  sortedAggregations_ = SortedAggregations::create(
+      aggregates_,
+      inputType,
+      pool(),
+      queryConfig.aggregationSortedInputGlobalSortEnabled()
+          ? std::make_optional(operatorCtx_->driverCtx()->prefixSortConfig())
+          : std::nullopt);
 
   distinctAggregations_.reserve(aggregates_.size());
   for (auto& aggregate : aggregates_) {
@@ -428,6 +428,24 @@ bool Task::allNodesReceivedNoMoreSplitsMessageLocked() const {
   return true;
 }
 
+void Task::setSpillDirectories(
+    const std::vector<std::string>& spillDirectories,
+    bool alreadyCreated) {
+  VELOX_CHECK(!spillDirectories.empty(), "No spill directory specified");
+  setSpillDirectory(spillDirectories[0], alreadyCreated);
+  if (spillDirectories.size() == 1) {
+    spillDirectories_.reset();
+    return;
+  }
+  const auto& queryConfig = queryCtx_->queryConfig();
+  spillDirectories_ = std::make_unique<common::SpillDirectories>(
+      spillDirectories,
+      common::spillDirectoryPlacementFromString(
+          queryConfig.spillDirectoryPlacement()),
+      queryConfig.spillDirectoryMaxQueueDepth(),
+      queryConfig.spillDirectoryMaxWaitMs());
+}
+
 const std::string& Task::getOrCreateSpillDirectory() {
   VELOX_CHECK(!spillDirectory_.empty(), "Spill directory not set");
   if (spillDirectoryCreated_) {
@@ -438,15 +456,23 @@ const std::string& Task::getOrCreateSpillDirectory() {
   if (spillDirectoryCreated_) {
     return spillDirectory_;
   }
-  try {
-    auto fileSystem = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fileSystem->mkdir(spillDirectory_);
-  } catch (const std::exception& e) {
-    VELOX_FAIL(
-        "Failed to create spill directory '{}' for Task {}: {}",
-        spillDirectory_,
-        taskId(),
-        e.what());
+  std::vector<std::string> directories{spillDirectory_};
+  if (spillDirectories_ != nullptr) {
+    for (uint32_t i = 1; i < spillDirectories_->size(); ++i) {
+      directories.push_back(spillDirectories_->path(i));
+    }
+  }
+  for (const auto& directory : directories) {
+    try {
+      auto fileSystem = filesystems::getFileSystem(directory, nullptr);
+      fileSystem->mkdir(directory);
+    } catch (const std::exception& e) {
+      VELOX_FAIL(
+          "Failed to create spill directory '{}' for Task {}: {}",
+          directory,
+          taskId(),
+          e.what());
+    }
   }
   spillDirectoryCreated_ = true;
   return spillDirectory_;
@@ -456,12 +482,20 @@ void Task::removeSpillDirectoryIfExists() {
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
-  try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
-  } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
-               << "' for Task " << taskId() << ": " << e.what();
+  std::vector<std::string> directories{spillDirectory_};
+  if (spillDirectories_ != nullptr) {
+    for (uint32_t i = 1; i < spillDirectories_->size(); ++i) {
+      directories.push_back(spillDirectories_->path(i));
+    }
+  }
+  for (const auto& directory : directories) {
+    try {
+      auto fs = filesystems::getFileSystem(directory, nullptr);
+      fs->rmdir(directory);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '" << directory
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
   }
 }
 
@@ -2525,8 +2559,10 @@ void Task::createLocalExchangeQueuesLocked(
 
   exchange.queues.reserve(numPartitions);
   for (auto i = 0; i < numPartitions; ++i) {
-    exchange.queues.emplace_back(
-        std::make_shared<LocalExchangeQueue>(exchange.memoryManager, i));
+    exchange.queues.emplace_back(std::make_shared<LocalExchangeQueue>(
+        exchange.memoryManager,
+        i,
+        queryCtx_->queryConfig().preferredOutputBatchRows()));
   }
 
   splitGroupState.localExchanges.insert({planNodeId, std::move(exchange)});
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/SpillDirectories.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -103,6 +104,14 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specifies multiple spill directories, typically one per local disk, to
+  /// stripe the spill files across. The placement of the spill files is
+  /// configured by the query config. The first directory is returned by
+  /// spillDirectory().
+  void setSpillDirectories(
+      const std::vector<std::string>& spillDirectories,
+      bool alreadyCreated = true);
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -644,6 +653,12 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  /// Returns the striped spill directories if the task has multiple spill
+  /// directories, otherwise null.
+  common::SpillDirectories* spillDirectories() const {
+    return spillDirectories_.get();
+  }
+
   /// Returns the spill directory path. Ensures that the spill directory is
   /// created before returning. Is thread safe. Returns an empty string if
   /// either the spill directory is not specified during task creation or the
@@ -1172,6 +1187,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // Base spill directory for this task.
   std::string spillDirectory_;
 
+  // Set if the spill files of this task are striped across multiple
+  // directories. 'spillDirectory_' is the first of them.
+  std::unique_ptr<common::SpillDirectories> spillDirectories_;
+
   // Mutex to ensure only the first caller thread of 'getOrCreateSpillDirectory'
   // creates the directory.
   mutable std::mutex spillDirCreateMutex_;
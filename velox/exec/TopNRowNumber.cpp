@@ -114,9 +114,11 @@ TopNRowNumber::TopNRowNumber(
           node->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      rankFunction_{node->rankFunction()},
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       numPartitionKeys_{node->partitionKeys().size()},
+      numSortingKeys_{node->sortingKeys().size()},
       inputChannels_{reorderInputChannels(
           node->inputType(),
           node->partitionKeys(),
@@ -243,11 +245,27 @@ void TopNRowNumber::initializeNewPartitions() {
 }
 
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
+  switch (rankFunction_) {
+    case core::TopNRowNumberNode::RankFunction::kRowNumber:
+      processRowNumberInputRow(index, partition);
+      break;
+    case core::TopNRowNumberNode::RankFunction::kRank:
+      processRankInputRow(index, partition);
+      break;
+    case core::TopNRowNumberNode::RankFunction::kDenseRank:
+      processDenseRankInputRow(index, partition);
+      break;
+  }
+}
+
+void TopNRowNumber::processRowNumberInputRow(
+    vector_size_t index,
+    TopRows& partition) {
   auto& topRows = partition.rows;
 
   char* newRow = nullptr;
   if (topRows.size() < limit_) {
-    newRow = data_->newRow();
+    newRow = storeInputRow(index);
   } else {
     char* topRow = topRows.top();
 
@@ -260,14 +278,91 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     topRows.pop();
 
     // Reuse the topRow's memory.
-    newRow = data_->initializeRow(topRow, true /* reuse */);
+    newRow = storeInputRow(index, topRow);
+  }
+
+  topRows.push(newRow);
+}
+
+void TopNRowNumber::processRankInputRow(
+    vector_size_t index,
+    TopRows& partition) {
+  auto& topRows = partition.rows;
+
+  int32_t result = 0;
+  if (topRows.size() >= limit_) {
+    result = comparator_.compare(decodedVectors_, index, topRows.top());
+    if (result > 0) {
+      // At least 'limit_' rows are smaller than this input row. Drop it.
+      return;
+    }
+  }
+
+  topRows.push(storeInputRow(index));
+  if (result == 0) {
+    // The input row is a peer of the largest row or there are less than
+    // 'limit_' rows. No rows can be dropped.
+    return;
+  }
+
+  // The largest rows have one more smaller row. Drop them if they no longer
+  // rank within 'limit_'.
+  popLargestPeers(partition);
+  if (topRows.size() >= limit_) {
+    data_->eraseRows(folly::Range(peerRows_.data(), peerRows_.size()));
+  } else {
+    for (auto* row : peerRows_) {
+      topRows.push(row);
+    }
   }
+}
 
+void TopNRowNumber::processDenseRankInputRow(
+    vector_size_t index,
+    TopRows& partition) {
+  auto& topRows = partition.rows;
+  auto& distinctRows = partition.distinctRows;
+
+  if (distinctRows.size() >= limit_ &&
+      comparator_.compare(decodedVectors_, index, topRows.top()) > 0) {
+    // There are 'limit_' distinct values smaller than this input row. Drop it.
+    return;
+  }
+
+  auto* newRow = storeInputRow(index);
+  topRows.push(newRow);
+  if (!distinctRows.insert(newRow).second ||
+      distinctRows.size() <= limit_) {
+    return;
+  }
+
+  // The input row adds a new value that pushes the largest value past
+  // 'limit_'. Drop all rows with the largest value.
+  distinctRows.erase(std::prev(distinctRows.end()));
+  popLargestPeers(partition);
+  data_->eraseRows(folly::Range(peerRows_.data(), peerRows_.size()));
+}
+
+char* TopNRowNumber::storeInputRow(vector_size_t index, char* row) {
+  char* newRow = row == nullptr
+      ? data_->newRow()
+      : data_->initializeRow(row, true /* reuse */);
   for (auto col = 0; col < decodedVectors_.size(); ++col) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
+  return newRow;
+}
 
-  topRows.push(newRow);
+void TopNRowNumber::popLargestPeers(TopRows& partition) {
+  auto& topRows = partition.rows;
+  peerRows_.clear();
+  peerRows_.push_back(topRows.top());
+  topRows.pop();
+  while (!topRows.empty() &&
+         comparator_.compare(topRows.top(), peerRows_[0]) == 0) {
+    peerRows_.push_back(topRows.top());
+    topRows.pop();
+  }
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -353,21 +448,43 @@ TopNRowNumber::TopRows& TopNRowNumber::currentPartition() {
   return partitionAt(partitions_[currentPartition_.value()]);
 }
 
+void TopNRowNumber::loadPartitionRows(TopRows& partition) {
+  auto& topRows = partition.rows;
+  const auto numRows = topRows.size();
+  partitionRows_.resize(numRows);
+  for (auto i = numRows; i > 0; --i) {
+    partitionRows_[i - 1] = topRows.top();
+    topRows.pop();
+  }
+
+  if (!generateRowNumber_) {
+    return;
+  }
+
+  partitionRowNumbers_.resize(numRows);
+  int64_t rank = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (rankFunction_ == core::TopNRowNumberNode::RankFunction::kRowNumber ||
+        i == 0 ||
+        comparator_.compare(partitionRows_[i - 1], partitionRows_[i]) != 0) {
+      rank = rankFunction_ == core::TopNRowNumberNode::RankFunction::kDenseRank
+          ? rank + 1
+          : i + 1;
+    }
+    partitionRowNumbers_[i] = rank;
+  }
+}
+
 void TopNRowNumber::appendPartitionRows(
-    TopRows& partition,
     vector_size_t start,
     vector_size_t size,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
-  // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
   for (auto i = 0; i < size; ++i) {
-    const auto index = outputOffset + size - i - 1;
     if (rowNumbers) {
-      rowNumbers->set(index, rowNumber--);
+      rowNumbers->set(outputOffset + i, partitionRowNumbers_[start + i]);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[outputOffset + i] = partitionRows_[start + i];
   }
 }
 
@@ -426,11 +543,10 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
 
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
-    auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partitionRows_.size() - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
-    appendPartitionRows(partition, start, numRows, offset, rowNumbers);
+    appendPartitionRows(start, numRows, offset, rowNumbers);
     offset += numRows;
     remainingRowsInPartition_ -= numRows;
   }
@@ -441,19 +557,20 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    loadPartitionRows(*partition);
+    auto numRows = partitionRows_.size();
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
       // Add a subset of partition rows.
       numRows -= remainingRowsInPartition_;
-      appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+      appendPartitionRows(0, numRows, offset, rowNumbers);
       offset += numRows;
       break;
     }
 
     // Add all partition rows.
-    appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+    appendPartitionRows(0, numRows, offset, rowNumbers);
     offset += numRows;
     remainingRowsInPartition_ = 0;
   }
@@ -498,9 +615,47 @@ bool TopNRowNumber::isNewPartition(
   return false;
 }
 
+int64_t TopNRowNumber::nextRank(
+    const RowVectorPtr& output,
+    vector_size_t index,
+    SpillMergeStream* next,
+    vector_size_t rowNumber,
+    int64_t rank) {
+  VELOX_CHECK_GT(index, 0);
+
+  if (rankFunction_ == core::TopNRowNumberNode::RankFunction::kRowNumber) {
+    return rowNumber + 1;
+  }
+
+  for (auto i = numPartitionKeys_; i < numPartitionKeys_ + numSortingKeys_;
+       ++i) {
+    if (!output->childAt(inputChannels_[i])
+             ->equalValueAt(
+                 next->current().childAt(i).get(),
+                 index - 1,
+                 next->currentIndex())) {
+      return rankFunction_ == core::TopNRowNumberNode::RankFunction::kRank
+          ? rowNumber + 1
+          : rank + 1;
+    }
+  }
+
+  // 'next' is a peer of the previous row.
+  return rank;
+}
+
+void TopNRowNumber::skipDroppedBatches(SpillMergeStream* next) {
+  bool isLastRow;
+  next->currentIndex(&isLastRow);
+  if (isLastRow) {
+    next->skipBatchesWithCurrentKeys(numPartitionKeys_);
+  }
+}
+
 void TopNRowNumber::setupNextOutput(
     const RowVectorPtr& output,
-    int32_t rowNumber) {
+    int32_t rowNumber,
+    int64_t rank) {
   nextRowNumber_ = rowNumber;
 
   auto lookAhead = merge_->next();
@@ -514,11 +669,13 @@ void TopNRowNumber::setupNextOutput(
     return;
   }
 
-  if (nextRowNumber_ < limit_) {
+  nextRank_ = nextRank(output, output->size(), lookAhead, rowNumber, rank);
+  if (nextRank_ <= limit_) {
     return;
   }
 
   // Skip remaining rows for this partition.
+  skipDroppedBatches(lookAhead);
   lookAhead->pop();
 
   while (auto next = merge_->next()) {
@@ -526,6 +683,7 @@ void TopNRowNumber::setupNextOutput(
       nextRowNumber_ = 0;
       return;
     }
+    skipDroppedBatches(next);
     next->pop();
   }
 
@@ -540,8 +698,9 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // All rows from the same partition will appear together.
   // We'll identify partition boundaries by comparing partition keys of the
   // current row with the previous row. When new partition starts, we'll reset
-  // row number to zero. Once row number reaches the 'limit_', we'll start
-  // dropping rows until the next partition starts.
+  // row number to zero. Once row number (or rank) exceeds the 'limit_', we'll
+  // start dropping rows until the next partition starts. Rows are sorted
+  // within a partition, so the rank of the dropped rows never decreases.
   // We'll emit output every time we accumulate 'outputBatchSize_' rows.
 
   auto output =
@@ -554,9 +713,12 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // Index of the next row to append to output.
   vector_size_t index = 0;
 
-  // Row number of the next row in the current partition.
+  // Number of rows of the current partition before the next row.
   vector_size_t rowNumber = nextRowNumber_;
-  VELOX_CHECK_LT(rowNumber, limit_);
+
+  // Row number or rank of the last row.
+  int64_t rank = nextRank_;
+  VELOX_CHECK(rowNumber == 0 || rank <= limit_);
   for (;;) {
     auto next = merge_->next();
     if (next == nullptr) {
@@ -568,7 +730,16 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
       rowNumber = 0;
     }
 
-    if (rowNumber < limit_) {
+    if (rowNumber == 0) {
+      rank = 1;
+    } else if (index > 0) {
+      rank = nextRank(output, index, next, rowNumber, rank);
+    } else {
+      // The rank of the first row in the batch was computed by
+      // setupNextOutput().
+    }
+
+    if (rank <= limit_) {
       for (auto i = 0; i < inputChannels_.size(); ++i) {
         output->childAt(inputChannels_[i])
             ->copy(
@@ -578,12 +749,12 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
                 1);
       }
       if (rowNumbers) {
-        // Row numbers start with 1.
-        rowNumbers->set(index, rowNumber + 1);
+        rowNumbers->set(index, rank);
       }
       ++index;
     } else {
       // Drop the row.
+      skipDroppedBatches(next);
     }
 
     ++rowNumber;
@@ -593,7 +764,7 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
       // Check if next row is from a new partition. Reset 'nextRowNumber_' if
       // so. Check if next row is from the current partition, but we have
       // reached the 'limit_'. Skip to the start of the next partition if so.
-      setupNextOutput(output, rowNumber);
+      setupNextOutput(output, rowNumber, rank);
 
       return output;
     }
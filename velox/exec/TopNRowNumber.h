@@ -21,8 +21,8 @@
 namespace facebook::velox::exec {
 
 /// Partitions the input using specified partitioning keys, sorts rows within
-/// partitions using specified sorting keys, assigns row numbers and returns up
-/// to specified number of rows per partition.
+/// partitions using specified sorting keys, assigns row numbers (or ranks) and
+/// returns the rows with row number (rank) up to the specified limit.
 ///
 /// It is allowed to not specify partitioning keys. In this case the whole input
 /// is treated as a single partition.
@@ -32,8 +32,10 @@ namespace facebook::velox::exec {
 /// The limit (maximum number of rows to return per partition) must be greater
 /// than zero.
 ///
-/// This is an optimized version of a Window operator with a single row_number
-/// window function followed by a row_number <= N filter.
+/// This is an optimized version of a Window operator with a single row_number,
+/// rank or dense_rank window function followed by a <= N filter. For rank and
+/// dense_rank, rows tied with the N-th row are kept as well, so a partition
+/// holds N rows plus the ties of the last kept value.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -74,7 +76,7 @@ class TopNRowNumber : public Operator {
     struct Compare {
       RowComparator& comparator;
 
-      bool operator()(const char* lhs, const char* rhs) {
+      bool operator()(const char* lhs, const char* rhs) const {
         return comparator(lhs, rhs);
       }
     };
@@ -82,8 +84,13 @@ class TopNRowNumber : public Operator {
     std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
         rows;
 
+    // One row per distinct value of the sorting keys in 'rows'. Used only for
+    // dense_rank.
+    std::set<char*, Compare, StlAllocator<char*>> distinctRows;
+
     TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+        : rows{{comparator}, StlAllocator<char*>(allocator)},
+          distinctRows{{comparator}, StlAllocator<char*>(allocator)} {}
   };
 
   void initializeNewPartitions();
@@ -95,6 +102,24 @@ class TopNRowNumber : public Operator {
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // processInputRow() for row_number. Keeps at most 'limit_' rows.
+  void processRowNumberInputRow(vector_size_t index, TopRows& partition);
+
+  // processInputRow() for rank. Keeps the rows with less than 'limit_'
+  // smaller rows.
+  void processRankInputRow(vector_size_t index, TopRows& partition);
+
+  // processInputRow() for dense_rank. Keeps the rows with at most 'limit_'
+  // distinct values of the sorting keys.
+  void processDenseRankInputRow(vector_size_t index, TopRows& partition);
+
+  // Stores input row 'index' in 'row' or in a new row of 'data_' if 'row' is
+  // null.
+  char* storeInputRow(vector_size_t index, char* row = nullptr);
+
+  // Removes the rows tied with the largest row from 'partition' and stores
+  // them in 'peerRows_'.
+  void popLargestPeers(TopRows& partition);
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
   TopRows* nextPartition();
@@ -102,10 +127,13 @@ class TopNRowNumber : public Operator {
   // Returns partition that was partially added to the previous output batch.
   TopRows& currentPartition();
 
-  // Appends partition rows to outputRows_ and optionally populates row
-  // numbers.
+  // Moves the rows of 'partition' to 'partitionRows_' in sorting order and
+  // computes their row numbers in 'partitionRowNumbers_' if needed.
+  void loadPartitionRows(TopRows& partition);
+
+  // Appends 'size' rows of 'partitionRows_' starting at 'start' to
+  // outputRows_ and optionally populates row numbers.
   void appendPartitionRows(
-      TopRows& partition,
       vector_size_t start,
       vector_size_t size,
       vector_size_t outputOffset,
@@ -133,15 +161,34 @@ class TopNRowNumber : public Operator {
       vector_size_t index,
       SpillMergeStream* next);
 
+  // Returns the row number or rank of 'next' row. 'index - 1' row of 'output'
+  // is the previous row of the same partition with row number or rank 'rank'.
+  // 'rowNumber' is the number of rows of the partition before 'next'.
+  int64_t nextRank(
+      const RowVectorPtr& output,
+      vector_size_t index,
+      SpillMergeStream* next,
+      vector_size_t rowNumber,
+      int64_t rank);
+
+  // Invoked when 'next' row is dropped because its row number or rank exceeds
+  // the limit. All the following rows of the partition are dropped too, so if
+  // 'next' is the last row of its batch, skips the spilled batches of its
+  // stream that hold only rows of this partition without reading them.
+  void skipDroppedBatches(SpillMergeStream* next);
+
   // Sets nextRowNumber_ to rowNumber. Checks if next row in 'merge_' belongs to
   // a different partition than last row in 'output' and if so updates
-  // nextRowNumber_ to 0. Also, checks current partition reached the limit on
-  // number of rows and if so advances 'merge_' to the first row on the next
-  // partition and sets nextRowNumber_ to 0.
+  // nextRowNumber_ to 0. Otherwise, computes the rank of the next row in
+  // nextRank_ and, if it exceeds the limit, advances 'merge_' to the first
+  // row on the next partition and sets nextRowNumber_ to 0.
   //
   // @post 'merge_->next()' is either at end or points to a row that should be
-  // included in the next output batch using 'nextRowNumber_'.
-  void setupNextOutput(const RowVectorPtr& output, int32_t rowNumber);
+  // included in the next output batch using 'nextRowNumber_' and 'nextRank_'.
+  void setupNextOutput(
+      const RowVectorPtr& output,
+      int32_t rowNumber,
+      int64_t rank);
 
   // Called in noMoreInput() and spill().
   void updateEstimatedOutputRowSize();
@@ -150,9 +197,11 @@ class TopNRowNumber : public Operator {
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
 
+  const core::TopNRowNumberNode::RankFunction rankFunction_;
   const int32_t limit_;
   const bool generateRowNumber_;
   const size_t numPartitionKeys_;
+  const size_t numSortingKeys_;
 
   // Input columns in the order of: partition keys, sorting keys, the rest.
   const std::vector<column_index_t> inputChannels_;
@@ -220,13 +269,26 @@ class TopNRowNumber : public Operator {
   std::optional<int32_t> currentPartition_;
   vector_size_t remainingRowsInPartition_{0};
 
+  // Rows of the partition being added to output in sorting order and their
+  // row numbers or ranks.
+  std::vector<char*> partitionRows_;
+  std::vector<int64_t> partitionRowNumbers_;
+
+  // Rows removed from a partition by popLargestPeers().
+  std::vector<char*> peerRows_;
+
   // Spiller for contents of the 'data_'.
   std::unique_ptr<Spiller> spiller_;
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
-  // Row number for the first row in the next output batch.
+  // Number of rows of the current partition before the first row in the next
+  // output batch.
   int32_t nextRowNumber_{0};
+
+  // Row number or rank of the first row in the next output batch if it
+  // continues the partition of the previous batch.
+  int64_t nextRank_{0};
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <iostream>
+#include <map>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/tpch/gen/TpchGen.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmark for group by over 1M rows with an integer key at low and high
+/// group counts.
+///
+/// Runs sum, count, min and max in array hash mode with accumulators inside
+/// the group rows and with accumulators in columns indexed by the array slot
+/// of the group.
+///
+/// Runs count(DISTINCT) with a set of inputs per group and with the
+/// (group, input) pairs de-duplicated in one shared hash table. Prints the
+/// peak memory of each distinct run after the benchmarks.
+///
+/// Runs array_agg(c1 ORDER BY c2) sorting the inputs of each group separately
+/// and sorting the inputs of all groups in an output batch at once.
+///
+/// Runs a 4-level ROLLUP over 250K rows of TPC-H lineitem by replicating the
+/// input rows once per grouping set and by re-aggregating the intermediate
+/// results of the finest grouping set. To compare the two, build with
+/// 'make benchmarks-build' and run:
+///
+///   _build/release/velox/exec/benchmarks/velox_aggregation_benchmark
+///       --bm_regex='lineitem_rollup_.*' --bm_min_iters=10
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+class AggregationBenchmark : public VectorTestBase {
+ public:
+  void makeBenchmark(int32_t numGroups, bool columnar) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(makeRows(numGroups))
+                    .singleAggregation(
+                        {"c0"},
+                        {"sum(c1)", "count(c1)", "min(c2)", "max(c2)"})
+                    .planNode();
+    auto name = fmt::format(
+        "{}_groups_{}", numGroups, columnar ? "columnar" : "rows");
+    folly::addBenchmark(__FILE__, name, [plan, columnar, this]() {
+      exec::test::AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kAggregationColumnarAccumulatorsEnabled,
+              columnar ? "true" : "false")
+          .copyResults(pool_.get());
+      return 1;
+    });
+  }
+
+  void makeDistinctBenchmark(int32_t numGroups, bool shared) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(makeRows(numGroups))
+                    .singleAggregation({"c0"}, {"count(DISTINCT c1)"})
+                    .planNode();
+    auto name = fmt::format(
+        "{}_groups_distinct_{}", numGroups, shared ? "shared" : "per_group");
+    folly::addBenchmark(__FILE__, name, [plan, shared, name, this]() {
+      std::shared_ptr<Task> task;
+      exec::test::AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kAggregationSharedDistinctHashEnabled,
+              shared ? "true" : "false")
+          .copyResults(pool_.get(), task);
+      peakBytes_[name] =
+          std::max(peakBytes_[name], task->pool()->peakBytes());
+      return 1;
+    });
+  }
+
+  void makeSortedBenchmark(int32_t numGroups, bool globalSort) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(makeRows(numGroups))
+                    .singleAggregation({"c0"}, {"array_agg(c1 ORDER BY c2)"})
+                    .planNode();
+    auto name = fmt::format(
+        "{}_groups_sorted_{}", numGroups, globalSort ? "global" : "per_group");
+    folly::addBenchmark(__FILE__, name, [plan, globalSort, this]() {
+      exec::test::AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kAggregationSortedInputGlobalSortEnabled,
+              globalSort ? "true" : "false")
+          .copyResults(pool_.get());
+      return 1;
+    });
+  }
+
+  void makeRollupBenchmark(bool reaggregate) {
+    if (lineItems_.empty()) {
+      for (auto i = 0; i < 25; ++i) {
+        lineItems_.push_back(
+            tpch::genTpchLineItem(pool_.get(), 10'000, i * 10'000, 1));
+      }
+    }
+    const std::vector<std::string> keys = {
+        "l_returnflag", "l_linestatus", "l_shipmode", "l_shipinstruct"};
+    const std::vector<std::vector<std::string>> groupingSets = {
+        keys, {keys[0], keys[1], keys[2]}, {keys[0], keys[1]}, {keys[0]}, {}};
+    const std::vector<std::string> aggregates = {
+        "sum(l_quantity)",
+        "sum(l_extendedprice)",
+        "avg(l_discount)",
+        "count(1)"};
+
+    exec::test::PlanBuilder builder;
+    builder.values(lineItems_);
+    if (reaggregate) {
+      builder.groupingSetsAggregation(groupingSets, aggregates);
+    } else {
+      auto groupingKeys = keys;
+      groupingKeys.push_back("group_id");
+      builder
+          .groupId(
+              keys,
+              groupingSets,
+              {"l_quantity", "l_extendedprice", "l_discount"})
+          .singleAggregation(groupingKeys, aggregates);
+    }
+    auto plan = builder.planNode();
+    auto name = fmt::format(
+        "lineitem_rollup_{}", reaggregate ? "reaggregate" : "replicate");
+    folly::addBenchmark(__FILE__, name, [plan, this]() {
+      exec::test::AssertQueryBuilder(plan).copyResults(pool_.get());
+      return 1;
+    });
+  }
+
+  void printPeakBytes() const {
+    for (const auto& [name, bytes] : peakBytes_) {
+      std::cout << name << " peak memory: " << succinctBytes(bytes)
+                << std::endl;
+    }
+  }
+
+ private:
+  std::vector<RowVectorPtr> makeRows(int32_t numGroups) {
+    constexpr vector_size_t kNumRows = 10'000;
+    std::vector<RowVectorPtr> rows;
+    for (auto i = 0; i < 100; ++i) {
+      rows.push_back(makeRowVector({
+          makeFlatVector<int32_t>(
+              kNumRows,
+              [&](auto row) { return (i * kNumRows + row) * 7 % numGroups; }),
+          makeFlatVector<int64_t>(
+              kNumRows, [](auto row) { return row % 1'000; }),
+          makeFlatVector<double>(kNumRows, [](auto row) { return row * 0.1; }),
+      }));
+    }
+    return rows;
+  }
+
+  std::map<std::string, int64_t> peakBytes_;
+  std::vector<RowVectorPtr> lineItems_;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  AggregationBenchmark bm;
+  for (auto numGroups : {16, 1'000, 100'000, 1'000'000}) {
+    bm.makeBenchmark(numGroups, false);
+    bm.makeBenchmark(numGroups, true);
+  }
+  for (auto numGroups : {16, 1'000, 100'000}) {
+    bm.makeDistinctBenchmark(numGroups, false);
+    bm.makeDistinctBenchmark(numGroups, true);
+  }
+  for (auto numGroups : {16, 1'000, 100'000, 1'000'000}) {
+    bm.makeSortedBenchmark(numGroups, false);
+    bm.makeSortedBenchmark(numGroups, true);
+  }
+  bm.makeRollupBenchmark(false);
+  bm.makeRollupBenchmark(true);
+
+  folly::runBenchmarks();
+  bm.printPeakBytes();
+  return 0;
+}
@@ -199,7 +199,8 @@ class ExchangeBenchmark : public VectorTestBase {
       std::vector<RowVectorPtr>& vectors,
       int32_t taskWidth,
       int32_t numTasks,
-      Counters& counters) {
+      Counters& counters,
+      bool compactPartitions = false) {
     assert(!vectors.empty());
     std::vector<std::shared_ptr<Task>> tasks;
     counters.bytes = vectors[0]->retainedSize() * vectors.size() * numTasks *
@@ -236,6 +237,9 @@ class ExchangeBenchmark : public VectorTestBase {
                   .config(
                       core::QueryConfig::kMaxLocalExchangeBufferSize,
                       fmt::format("{}", FLAGS_local_exchange_buffer_mb << 20))
+                  .config(
+                      core::QueryConfig::kLocalExchangeCompactPartitions,
+                      compactPartitions ? "true" : "false")
                   .maxDrivers(taskWidth)
                   .assertResults(expected);
           {
@@ -350,6 +354,7 @@ void runBenchmarks() {
   std::vector<RowVectorPtr> flat50;
   std::vector<RowVectorPtr> deep50;
   std::vector<RowVectorPtr> struct1k;
+  std::vector<RowVectorPtr> wide10k;
 
   Counters flat10kCounters;
   Counters deep10kCounters;
@@ -357,6 +362,8 @@ void runBenchmarks() {
   Counters deep50Counters;
   Counters localFlat10kCounters;
   Counters struct1kCounters;
+  Counters localWide10kCounters;
+  Counters localWide10kCompactCounters;
 
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
@@ -386,6 +393,17 @@ void runBenchmarks() {
   }
   auto flatType = ROW(std::move(flatNames), std::move(flatTypes));
 
+  // 64 columns for measuring the cost of per-destination column wrapping in
+  // local exchange with many consumers.
+  std::vector<std::string> wideNames;
+  std::vector<TypePtr> wideTypes;
+  for (auto i = 0; i < 64; ++i) {
+    wideNames.push_back(fmt::format("c{}", i));
+    wideTypes.push_back(
+        i == 0 ? BIGINT() : typeSelection[i % typeSelection.size()]);
+  }
+  auto wideType = ROW(std::move(wideNames), std::move(wideTypes));
+
   auto structType = ROW(
       {{"c0", BIGINT()},
        {"r1",
@@ -416,6 +434,7 @@ void runBenchmarks() {
   flat50 = bm->makeRows(flatType, 2000, 50, FLAGS_dict_pct);
   deep50 = bm->makeRows(deepType, 2000, 50, FLAGS_dict_pct);
   struct1k = bm->makeRows(structType, 100, 1000, FLAGS_dict_pct);
+  wide10k = bm->makeRows(wideType, 10, 10000, FLAGS_dict_pct);
 
   folly::addBenchmark(__FILE__, "exchangeFlat10k", [&]() {
     bm->run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -448,12 +467,27 @@ void runBenchmarks() {
     return 1;
   });
 
+  folly::addBenchmark(__FILE__, "localWide10k", [&]() {
+    bm->runLocal(wide10k, 32, FLAGS_num_local_tasks, localWide10kCounters);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "localWide10kCompact", [&]() {
+    bm->runLocal(
+        wide10k, 32, FLAGS_num_local_tasks, localWide10kCompactCounters, true);
+    return 1;
+  });
+
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "localFlat10k: " << localFlat10kCounters.toString() << std::endl
+            << "localWide10k: " << localWide10kCounters.toString() << std::endl
+            << "localWide10kCompact: "
+            << localWide10kCompactCounters.toString() << std::endl;
 }
 
 } // namespace
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <algorithm>
+
+/// Benchmark for aggregate window functions over sliding ROWS frames of
+/// increasing width. Runs sum and avg over 'k PRECEDING AND CURRENT ROW'
+/// frames on 100K rows in 10 partitions. The cost of evaluating each frame
+/// from scratch grows linearly with the frame width while the segment tree
+/// evaluation grows with the log of the partition size. The unbounded frame
+/// is the incremental aggregation baseline.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+class WindowBenchmark : public VectorTestBase {
+ public:
+  WindowBenchmark() {
+    constexpr vector_size_t kNumRows = 10'000;
+    for (auto i = 0; i < 10; ++i) {
+      rows_.push_back(makeRowVector({
+          makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 10; }),
+          makeFlatVector<int64_t>(
+              kNumRows, [i](auto row) { return i * kNumRows + row; }),
+          makeFlatVector<int64_t>(
+              kNumRows, [](auto row) { return row * 7 % 1000; }),
+      }));
+    }
+  }
+
+  void makeBenchmark(const std::string& function, const std::string& frame) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(rows_)
+                    .window({fmt::format(
+                        "{}(c2) over (partition by c0 order by c1 {})",
+                        function,
+                        frame)})
+                    .planNode();
+    auto name = fmt::format("{}_{}", function, frame);
+    std::replace(name.begin(), name.end(), ' ', '_');
+    folly::addBenchmark(__FILE__, name, [plan, this]() {
+      exec::test::AssertQueryBuilder(plan).copyResults(pool_.get());
+      return 1;
+    });
+  }
+
+ private:
+  std::vector<RowVectorPtr> rows_;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  WindowBenchmark bm;
+  for (const auto* function : {"sum", "avg"}) {
+    for (auto width : {1, 10, 30, 100, 1'000, 5'000}) {
+      bm.makeBenchmark(
+          function,
+          fmt::format("rows between {} preceding and current row", width));
+    }
+    bm.makeBenchmark(
+        function, "rows between unbounded preceding and current row");
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
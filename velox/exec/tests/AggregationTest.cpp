@@ -806,6 +806,69 @@ TEST_F(AggregationTest, rangeToDistinct) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, columnarAccumulators) {
+  // Keys are in array range. The sixth batch widens the range of c0 so that
+  // the table is rehashed and the accumulators move back to the rows and into
+  // the new columns.
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    const int32_t numKeys = i < 5 ? 100 : 1'000;
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (row * 7 + i) % numKeys; }),
+        makeFlatVector<int16_t>(1'000, [](auto row) { return row % 3; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return row * i; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.1; }, nullEvery(11)),
+        makeFlatVector<bool>(1'000, [](auto row) { return row % 5 == 0; }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c2)",
+      "count(c2)",
+      "min(c3)",
+      "max(c2)",
+      "avg(c3)",
+      "count(1)",
+      "sum(c2)"};
+  const std::vector<std::string> masks = {"", "", "", "", "", "", "c4"};
+  const std::string expectedSql =
+      "SELECT c0, c1, sum(c2), count(c2), min(c3), max(c2), avg(c3), "
+      "count(1), sum(c2) filter (where c4) FROM tmp GROUP BY 1, 2";
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0", "c1"}, aggregates, masks)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kAggregationColumnarAccumulatorsEnabled, "true")
+      .assertResults(expectedSql);
+
+  // Partial aggregation that flushes after every batch and reuses the table.
+  plan = PlanBuilder()
+             .values(batches)
+             .partialAggregation({"c0", "c1"}, aggregates, masks)
+             .finalAggregation()
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kAggregationColumnarAccumulatorsEnabled, "true")
+      .config(QueryConfig::kMaxPartialAggregationMemory, "1")
+      .assertResults(expectedSql);
+
+  // Variable width accumulators keep the row layout.
+  plan = PlanBuilder()
+             .values(batches)
+             .singleAggregation({"c0"}, {"sum(c2)", "array_agg(c1)"})
+             .project({"c0", "a0", "cardinality(a1)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kAggregationColumnarAccumulatorsEnabled, "true")
+      .assertResults("SELECT c0, sum(c2), count(1) FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, allKeyTypes) {
   // Covers different key types. Unlike the integer/string tests, the
   // hash table begins life in the generic mode, not array or
@@ -957,6 +1020,115 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationHeavyHitters) {
+  // Every other row has one of 4 hot keys. The other rows have unique keys, so
+  // partial aggregation is abandoned after the first batches.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 2 == 0 ? row % 8 : 1'000 + i * 1'000 + row;
+            }),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row; }, nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto runQuery = [&](int32_t numHeavyHitters) {
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'000)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(
+                QueryConfig::kAbandonPartialAggregationHeavyHitters,
+                numHeavyHitters)
+            .config(QueryConfig::kMaxPartialAggregationMemory, 1 << 20)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation(
+                          {"c0"}, {"sum(c1)", "count(c1)", "max(c1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(c1), max(c1) FROM tmp GROUP BY 1");
+    auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    EXPECT_EQ(1, stats.customStats.count("abandonedPartialAggregation"));
+    return stats;
+  };
+
+  auto stats = runQuery(0);
+  EXPECT_EQ(0, stats.customStats.count("heavyHitterRows"));
+  const auto passThroughOutputRows = stats.outputRows;
+
+  // The hot keys are aggregated locally after abandoning, which reduces the
+  // number of rows sent to the final aggregation.
+  stats = runQuery(4);
+  EXPECT_LT(0, stats.customStats.at("heavyHitterRows").sum);
+  EXPECT_LT(stats.outputRows, passThroughOutputRows);
+}
+
+TEST_F(AggregationTest, partialAggregationHeavyHittersVariableWidth) {
+  // Aggregates with out-of-line accumulators and string values, which
+  // accumulate into both the heavy hitter table and the pass-through rows.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 2 == 0 ? row % 8 : 1'000 + i * 1'000 + row;
+            }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) {
+              return fmt::format("string longer than inline {}", i + row);
+            },
+            nullEvery(7)),
+    }));
+  }
+
+  const std::vector<std::string> aggregates = {
+      "array_agg(c1)", "max(c2)", "min(c2)"};
+  const std::vector<std::string> projections = {
+      "c0", "array_sort(a0)", "a1", "a2"};
+  const auto expected =
+      AssertQueryBuilder(PlanBuilder()
+                             .values(vectors)
+                             .singleAggregation({"c0"}, aggregates)
+                             .project(projections)
+                             .planNode())
+          .copyResults(pool());
+
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, aggregates)
+                  .capturePlanNodeId(aggNodeId)
+                  .finalAggregation()
+                  .project(projections)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  const auto result =
+      AssertQueryBuilder(plan)
+          .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'000)
+          .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+          .config(QueryConfig::kAbandonPartialAggregationHeavyHitters, 4)
+          .config("max_drivers_per_task", 1)
+          .copyResults(pool(), task);
+  assertEqualResults({expected}, {result});
+
+  auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+  EXPECT_EQ(1, stats.customStats.count("abandonedPartialAggregation"));
+  EXPECT_LT(0, stats.customStats.at("heavyHitterRows").sum);
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1327,6 +1499,75 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "k3", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 17; }, nullEvery(7)),
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  auto testPlan = [&](const std::vector<std::vector<std::string>>& sets,
+                      const std::vector<std::string>& aggregates,
+                      const std::string& sql) {
+    SCOPED_TRACE(sql);
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .groupingSetsAggregation(sets, aggregates)
+                    .project({"k1", "k2", "k3", "a0", "a1", "a2"})
+                    .planNode();
+    assertQuery(plan, sql);
+  };
+
+  // Rollup and cube re-aggregate the intermediate results of
+  // GROUP BY k1, k2, k3.
+  testPlan(
+      {{"k1", "k2", "k3"}, {"k1", "k2"}, {"k1"}, {}},
+      {"count(1)", "sum(a)", "max(b)"},
+      "SELECT k1, k2, k3, count(1), sum(a), max(b) FROM tmp "
+      "GROUP BY ROLLUP (k1, k2, k3)");
+
+  testPlan(
+      {{"k1", "k2", "k3"},
+       {"k1", "k2"},
+       {"k1", "k3"},
+       {"k2", "k3"},
+       {"k1"},
+       {"k2"},
+       {"k3"},
+       {}},
+      {"count(1)", "avg(a)", "min(b)"},
+      "SELECT k1, k2, k3, count(1), avg(a), min(b) FROM tmp "
+      "GROUP BY CUBE (k1, k2, k3)");
+
+  // Aggregates over distinct inputs replicate the input rows.
+  testPlan(
+      {{"k1", "k2", "k3"}, {"k1"}, {}},
+      {"count(DISTINCT a)", "sum(a)", "max(b)"},
+      "SELECT k1, k2, k3, count(DISTINCT a), sum(a), max(b) FROM tmp "
+      "GROUP BY GROUPING SETS ((k1, k2, k3), (k1), ())");
+
+  // Re-aggregation over an empty input still produces the global grouping set.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .filter("a < 0")
+                  .groupingSetsAggregation({{"k1"}, {}}, {"count(b)"})
+                  .project({"k1", "a0"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, count(b) FROM tmp WHERE a < 0 "
+      "GROUP BY GROUPING SETS ((k1), ())");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1879,6 +2120,68 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, sharedDistinctHash) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationSharedDistinctHashEnabled, "true")
+        .assertResults(sql);
+  };
+
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {"c1"}, {"count(DISTINCT c0)", "sum(DISTINCT c0)"}, {})
+          .planNode(),
+      "SELECT c1, count(DISTINCT c0), sum(DISTINCT c0) FROM tmp GROUP BY c1");
+
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation({"c1", "c2"}, {"count(DISTINCT c3)"}, {})
+          .planNode(),
+      "SELECT c1, c2, count(DISTINCT c3) FROM tmp GROUP BY c1, c2");
+
+  // Different inputs keep a set of inputs per group.
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {"c1"}, {"count(DISTINCT c0)", "count(DISTINCT c2)"}, {})
+          .planNode(),
+      "SELECT c1, count(DISTINCT c0), count(DISTINCT c2) FROM tmp "
+      "GROUP BY c1");
+}
+
+TEST_F(AggregationTest, sharedDistinctHashWithSpilling) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(QueryConfig::kSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kAggregationSharedDistinctHashEnabled, true)
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(
+                        {"c1"}, {"count(DISTINCT c0)", "max(DISTINCT c0)"}, {})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(
+              "SELECT c1, count(DISTINCT c0), max(DISTINCT c0) FROM tmp "
+              "GROUP BY c1");
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
@@ -1919,6 +2222,88 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
       plan, "SELECT c0 % 7, array_agg(c1 ORDER BY c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(AggregationTest, sortedAggregationsGlobalSort) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    // Use PrefixSort for any number of rows.
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationSortedInputGlobalSortEnabled, true)
+        .config(QueryConfig::kPrefixSortMinRows, 0)
+        .assertResults(sql);
+  };
+
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .project({"c0 % 7 AS k", "c1", "c2"})
+          .singleAggregation(
+              {"k"},
+              {"array_agg(c1 ORDER BY c2 DESC, c1)",
+               "array_agg(c2 ORDER BY c2 DESC, c1)"})
+          .planNode(),
+      "SELECT c0 % 7, array_agg(c1 ORDER BY c2 DESC, c1), "
+      "array_agg(c2 ORDER BY c2 DESC, c1) FROM tmp GROUP BY 1");
+
+  // Many small groups.
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .project({"c1 % 100 AS k", "c1", "c2"})
+          .singleAggregation({"k"}, {"array_agg(c2 ORDER BY c2)"})
+          .planNode(),
+      "SELECT c1 % 100, array_agg(c2 ORDER BY c2) FROM tmp GROUP BY 1");
+
+  // Masked aggregates.
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .project({"c0 % 7 AS k", "c1", "c2", "c1 % 2 = 0 AS m"})
+          .singleAggregation(
+              {"k"},
+              {"array_agg(c1 ORDER BY c1)", "array_agg(c2 ORDER BY c1)"},
+              {"m", ""})
+          .planNode(),
+      "SELECT c0 % 7, array_agg(c1 ORDER BY c1) FILTER (WHERE c1 % 2 = 0), "
+      "array_agg(c2 ORDER BY c1) FROM tmp GROUP BY 1");
+
+  // Different sorting keys fall back to sorting each group separately.
+  testPlan(
+      PlanBuilder()
+          .values(vectors)
+          .project({"c0 % 7 AS k", "c1", "c2"})
+          .singleAggregation(
+              {"k"},
+              {"array_agg(c1 ORDER BY c1)", "array_agg(c2 ORDER BY c2)"})
+          .planNode(),
+      "SELECT c0 % 7, array_agg(c1 ORDER BY c1), array_agg(c2 ORDER BY c2) "
+      "FROM tmp GROUP BY 1");
+
+  // Spilling the accumulated inputs.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(QueryConfig::kSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kAggregationSortedInputGlobalSortEnabled, true)
+          .config(QueryConfig::kPrefixSortMinRows, 0)
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation({"c0"}, {"array_agg(c1 ORDER BY c1)"})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(
+              "SELECT c0, array_agg(c1 ORDER BY c1) FROM tmp GROUP BY 1");
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  checkSpillStats(taskStats.at(aggrNodeId), true);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   std::vector<RowVectorPtr> vectors;
   int64_t val = 0;
@@ -334,6 +334,115 @@ TEST_F(LocalPartitionTest, indicesBufferCapacity) {
   ASSERT_LE(capacity, 1.5 * numRows * sizeof(vector_size_t));
 }
 
+TEST_F(LocalPartitionTest, compactPartitions) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            100, [i](auto row) { return -71 + i * 10 + row; }),
+        makeFlatVector<int64_t>(100, [i](auto row) { return i * row; }),
+        makeFlatVector<std::string>(
+            100, [](auto row) { return std::string(row % 17, 'x'); }),
+    }));
+  }
+  auto filePaths = writeToFiles(vectors);
+  auto rowType = asRowType(vectors[0]->type());
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  std::vector<core::PlanNodeId> scanNodeIds;
+  auto scanNode = [&]() {
+    auto node = PlanBuilder(planNodeIdGenerator).tableScan(rowType).planNode();
+    scanNodeIds.push_back(node->id());
+    return node;
+  };
+  CursorParameters params;
+  params.planNode = PlanBuilder(planNodeIdGenerator)
+                        .localPartition(
+                            {"c0"},
+                            {
+                                scanNode(),
+                                scanNode(),
+                                scanNode(),
+                            })
+                        .planNode();
+  params.copyResult = false;
+  params.maxDrivers = 16;
+  params.queryConfigs[core::QueryConfig::kLocalExchangeCompactPartitions] =
+      "true";
+  auto cursor = TaskCursor::create(params);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    auto id = scanNodeIds[i % 3];
+    cursor->task()->addSplit(
+        id, Split(makeHiveConnectorSplit(filePaths[i]->getPath())));
+    cursor->task()->noMoreSplits(id);
+  }
+
+  // Each input batch is split 16 ways, hence, every partition is small enough
+  // to be copied into a flat batch, possibly together with other small
+  // partitions.
+  std::vector<RowVectorPtr> results;
+  int numRows = 0;
+  while (cursor->moveNext()) {
+    auto batch = cursor->current();
+    for (const auto& child : batch->children()) {
+      ASSERT_EQ(child->encoding(), VectorEncoding::Simple::FLAT);
+    }
+    numRows += batch->size();
+    results.push_back(batch);
+  }
+  ASSERT_EQ(numRows, 2100);
+  ASSERT_TRUE(assertEqualResults(vectors, results));
+}
+
+TEST_F(LocalPartitionTest, spreadSkewedPartitions) {
+  // Half of the rows have key 0 and land in the same partition.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [i](auto row) { return row % 2 == 0 ? 0 : i * 1'000 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto runQuery = [&](bool spreadSkewedPartitions) {
+    core::PlanNodeId exchangeId;
+    core::PlanNodeId aggregationId;
+    PlanBuilder builder;
+    builder.values(vectors);
+    if (spreadSkewedPartitions) {
+      builder.localPartitionSpreadSkewed({"c0"});
+    } else {
+      builder.localPartition({"c0"});
+    }
+    auto plan = builder.capturePlanNodeId(exchangeId)
+                    .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                    .capturePlanNodeId(aggregationId)
+                    .localPartition({"c0"})
+                    .finalAggregation()
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(4)
+                    .assertResults(
+                        "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+    auto planStats = toPlanStats(task->taskStats());
+    EXPECT_EQ(
+        spreadSkewedPartitions,
+        planStats.at(exchangeId).customStats.count("spreadSkewedRows") > 0);
+    const auto& inputRows = planStats.at(aggregationId).inputRowsPerDriver;
+    EXPECT_EQ(4, inputRows.count);
+    EXPECT_EQ(20'000, inputRows.sum);
+    return inputRows.max;
+  };
+
+  // Without spreading, the driver that gets key 0 processes over half of the
+  // rows. With spreading, the rows of key 0 after the first 10K rows are
+  // spread over all drivers.
+  EXPECT_GT(runQuery(false), 10'000);
+  EXPECT_LT(runQuery(true), 10'000);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
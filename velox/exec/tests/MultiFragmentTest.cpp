@@ -2092,5 +2092,69 @@ TEST_F(MultiFragmentTest, compression) {
   test("local://t2", 0.0000001, true);
 }
 
+TEST_F(MultiFragmentTest, adaptiveCompression) {
+  PartitionedOutput::testingSetMinCompressionRatio(0.8);
+  constexpr int32_t kNumRepeats = 1'000'000;
+  const auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+
+  const auto producerPlan = test::PlanBuilder()
+                                .values({data}, false, kNumRepeats)
+                                .partitionedOutput({}, 1)
+                                .planNode();
+
+  const auto plan = test::PlanBuilder()
+                        .exchange(asRowType(data->type()))
+                        .singleAggregation({}, {"sum(c0)"})
+                        .planNode();
+
+  const auto expected =
+      makeRowVector({makeFlatVector<int64_t>(std::vector<int64_t>{6000000})});
+
+  const auto test = [&](const std::string& producerTaskId, bool adaptive) {
+    configSettings_[core::QueryConfig::kExchangeAdaptiveCompression] =
+        adaptive ? "true" : "false";
+    auto producerTask = makeTask(producerTaskId, producerPlan);
+    producerTask->start(1);
+
+    // The consumer must read the pages with the same setting as the producer.
+    auto consumerTask =
+        test::AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kExchangeAdaptiveCompression,
+                adaptive ? "true" : "false")
+            .split(remoteSplit(producerTaskId))
+            .destination(0)
+            .assertResults(expected);
+
+    auto consumerTaskStats = exec::toPlanStats(consumerTask->taskStats());
+    ASSERT_EQ(
+        data->size() * kNumRepeats, consumerTaskStats.at("0").outputRows);
+
+    auto producerTaskStats = exec::toPlanStats(producerTask->taskStats());
+    const auto& producerStats = producerTaskStats.at("1").customStats;
+    if (!adaptive) {
+      ASSERT_EQ(producerStats.count("compressionNanos"), 0);
+      ASSERT_EQ(producerStats.count("compressedBytes.lz4"), 0);
+      return;
+    }
+    ASSERT_GT(producerStats.at("compressionNanos").sum, 0);
+    // Every candidate codec is tried before the best one is picked.
+    for (const auto& codec : {"none", "lz4", "zstd1", "zstd3"}) {
+      ASSERT_GT(
+          producerStats.at(fmt::format("compressionInputBytes.{}", codec)).sum,
+          0)
+          << codec;
+    }
+    // The data is extremely compressible, so the compressing codecs win.
+    ASSERT_LT(
+        producerStats.at("compressedBytes").sum,
+        producerStats.at("compressionInputBytes").sum);
+  };
+
+  test("local://t1", false);
+  test("local://t2", true);
+  test("local://t3", false);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -219,6 +219,12 @@ TEST_F(PlanNodeSerdeTest, localPartition) {
 
   plan = PlanBuilder().values({data_}).localPartition({"c0", "c1"}).planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .localPartitionSpreadSkewed({"c0", "c1"})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, limit) {
@@ -530,6 +536,18 @@ TEST_F(PlanNodeSerdeTest, topNRowNumber) {
              .topNRowNumber({"c0"}, {"c1", "c2"}, 10, false)
              .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .topNRank("rank", {"c0"}, {"c1", "c2"}, 10, true)
+             .planNode();
+  testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .topNRank("dense_rank", {}, {"c0", "c2"}, 10, false)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, write) {
@@ -772,6 +772,164 @@ TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   state_.reset();
 }
 
+TEST_P(SpillTest, spillFileIndex) {
+  constexpr int32_t kNumBatches = 8;
+  constexpr int32_t kNumRowsPerBatch = 100;
+  std::vector<CompareFlags> emptyCompareFlags;
+  // Write buffer size 0 flushes each appended vector as a separate batch.
+  SpillState state(
+      [&]() -> const std::string& { return tempDir_->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    state.appendToPartition(
+        0,
+        makeRowVector({
+            makeFlatVector<int64_t>(
+                kNumRowsPerBatch,
+                [&](auto row) { return i * kNumRowsPerBatch + row; }),
+            makeFlatVector<int32_t>(
+                kNumRowsPerBatch, [](auto row) { return row; }),
+        }));
+  }
+  const auto spillFiles = state.finish(0);
+  ASSERT_EQ(spillFiles.size(), 1);
+  const auto spilledBytes = spillStats_.rlock()->spilledBytes;
+  ASSERT_EQ(spillFiles[0].size, spilledBytes);
+
+  // Uses a small read buffer so that the skipped batches are not buffered.
+  auto readFile =
+      SpillReadFile::create(spillFiles[0], 256, pool(), &spillStats_);
+  ASSERT_TRUE(readFile->hasIndex());
+  ASSERT_EQ(readFile->index().size(), kNumBatches);
+  const auto& keyBounds = readFile->keyBounds();
+  ASSERT_NE(keyBounds, nullptr);
+  ASSERT_EQ(keyBounds->size(), 2 * kNumBatches);
+  ASSERT_EQ(keyBounds->childrenSize(), 1);
+  auto* bounds = keyBounds->childAt(0)->asFlatVector<int64_t>();
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    ASSERT_EQ(readFile->index()[i].numRows, kNumRowsPerBatch);
+    if (i > 0) {
+      ASSERT_GT(readFile->index()[i].offset, readFile->index()[i - 1].offset);
+    }
+    ASSERT_EQ(bounds->valueAt(2 * i), i * kNumRowsPerBatch);
+    ASSERT_EQ(bounds->valueAt(2 * i + 1), (i + 1) * kNumRowsPerBatch - 1);
+  }
+
+  RowVectorPtr batch;
+  ASSERT_TRUE(readFile->nextBatch(batch));
+  ASSERT_EQ(batch->size(), kNumRowsPerBatch);
+  ASSERT_EQ(readFile->nextBatchIndex(), 1);
+
+  // Skips the batches whose rows all sort at or before the probe key.
+  auto probe = makeRowVector({makeFlatVector<int64_t>(
+      std::vector<int64_t>{3 * kNumRowsPerBatch - 1})});
+  ASSERT_EQ(readFile->skipBatchesUpTo(*probe, 0, 1), 2);
+  ASSERT_EQ(readFile->nextBatchIndex(), 3);
+  ASSERT_EQ(readFile->skipBatchesUpTo(*probe, 0, 1), 0);
+  ASSERT_TRUE(readFile->nextBatch(batch));
+  ASSERT_EQ(
+      batch->childAt(0)->asFlatVector<int64_t>()->valueAt(0),
+      3 * kNumRowsPerBatch);
+
+  readFile->seekToBatch(kNumBatches - 1);
+  VELOX_ASSERT_THROW(
+      readFile->seekToBatch(kNumBatches - 2),
+      "Backward seek is not supported by spill file");
+  ASSERT_TRUE(readFile->nextBatch(batch));
+  ASSERT_EQ(
+      batch->childAt(0)->asFlatVector<int64_t>()->valueAt(0),
+      (kNumBatches - 1) * kNumRowsPerBatch);
+  ASSERT_FALSE(readFile->nextBatch(batch));
+
+  // The skipped batches are not read from disk.
+  ASSERT_LT(spillStats_.rlock()->spillReadBytes, spilledBytes);
+
+  // Zero keys compare equal to any row, so all the unread batches are
+  // skipped.
+  readFile = SpillReadFile::create(spillFiles[0], 256, pool(), &spillStats_);
+  ASSERT_TRUE(readFile->nextBatch(batch));
+  ASSERT_EQ(readFile->skipBatchesUpTo(*probe, 0, 0), kNumBatches - 1);
+  ASSERT_FALSE(readFile->nextBatch(batch));
+}
+
+TEST_P(SpillTest, stripedSpillDirectories) {
+  auto tempDir0 = exec::test::TempDirectoryPath::create();
+  auto tempDir1 = exec::test::TempDirectoryPath::create();
+  common::SpillDirectories directories(
+      {tempDir0->getPath(), tempDir1->getPath()},
+      common::SpillDirectoryPlacement::kRoundRobin);
+  std::vector<CompareFlags> emptyCompareFlags;
+  // Target file size 1 creates a new file for each written batch.
+  SpillState state(
+      [&]() -> const std::string& { return tempDir0->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      emptyCompareFlags,
+      1,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      &directories);
+  state.setPartitionSpilled(0);
+  constexpr int32_t kNumBatches = 6;
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(100, [&](auto row) {
+          return i * 100 + row;
+        })}));
+  }
+  const auto spillFiles = state.finish(0);
+  ASSERT_EQ(spillFiles.size(), kNumBatches);
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    const auto& expectedDir =
+        i % 2 == 0 ? tempDir0->getPath() : tempDir1->getPath();
+    ASSERT_EQ(spillFiles[i].path.rfind(expectedDir + "/", 0), 0)
+        << spillFiles[i].path;
+  }
+  for (const auto& directoryStats : directories.stats()) {
+    ASSERT_EQ(directoryStats.numFiles, kNumBatches / 2);
+    ASSERT_GT(directoryStats.writtenBytes, 0);
+    ASSERT_EQ(directoryStats.queueDepth, 0);
+  }
+  const auto spillStats = spillStats_.copy();
+  ASSERT_EQ(spillStats.spillDirectoryStats.size(), 2);
+  uint64_t directoryBytes{0};
+  for (const auto& path : {tempDir0->getPath(), tempDir1->getPath()}) {
+    const auto& directoryStats = spillStats.spillDirectoryStats.at(path);
+    ASSERT_EQ(directoryStats.spilledFiles, kNumBatches / 2);
+    ASSERT_GT(directoryStats.spillWrites, 0);
+    ASSERT_GT(directoryStats.spilledBytes, 0);
+    ASSERT_GE(directoryStats.maxQueueDepth, 1);
+    directoryBytes += directoryStats.spilledBytes;
+  }
+  ASSERT_EQ(directoryBytes, spillStats.spilledBytes);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, spillFiles);
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  for (int64_t i = 0; i < kNumBatches * 100; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+}
+
 namespace {
 SpillFiles makeFakeSpillFiles(int32_t numFiles) {
   auto tempDir = exec::test::TempDirectoryPath::create();
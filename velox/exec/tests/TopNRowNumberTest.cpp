@@ -172,6 +172,54 @@ TEST_F(TopNRowNumberTest, largeOutput) {
   testLimit(2000);
 }
 
+TEST_F(TopNRowNumberTest, spillSkipsDroppedBatches) {
+  // Each spill run keeps the top 500 rows of each partition, so the sorted
+  // merge of the runs drops most of the rows of each partition. Small write
+  // and read buffers give many small batches that can be skipped.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"d", "p", "s"},
+          {
+              makeFlatVector<std::string>(
+                  size,
+                  [](auto row) { return std::string(50, 'a' + row % 26); }),
+              makeFlatVector<int16_t>(size, [](auto row) { return row % 2; }),
+              makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId topNRowNumberId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .topNRowNumber({"p"}, {"s"}, 500, true)
+                  .capturePlanNodeId(topNRowNumberId)
+                  .planNode();
+
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+          .config(core::QueryConfig::kSpillWriteBufferSize, "1024")
+          .config(core::QueryConfig::kSpillReadBufferSize, "1024")
+          .spillDirectory(spillDirectory->getPath())
+          .assertResults(
+              "SELECT * FROM (SELECT *, row_number() over (partition by p "
+              "order by s) as rn FROM tmp) WHERE rn <= 500");
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(topNRowNumberId);
+  ASSERT_GT(stats.spilledFiles, 1);
+  ASSERT_GT(stats.spilledRows, 1'000);
+  // The batches holding only dropped rows are not read back.
+  ASSERT_LT(
+      stats.customStats.at(Operator::kSpillReadBytes).sum, stats.spilledBytes);
+}
+
 TEST_F(TopNRowNumberTest, manyPartitions) {
   const vector_size_t size = 10'000;
   auto data = split(
@@ -243,6 +291,129 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, rank) {
+  // Sorting key values repeat within partitions so that ties cross the limit.
+  auto data = makeRowVector({
+      // Partitioning key.
+      makeFlatVector<int64_t>({1, 1, 2, 2, 1, 2, 1, 1, 2, 1, 2, 1}),
+      // Sorting key.
+      makeNullableFlatVector<int64_t>(
+          {5, 3, 4, 4, 3, std::nullopt, 5, 1, 4, std::nullopt, 2, 3}),
+      // Data.
+      makeFlatVector<int64_t>(
+          {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120}),
+  });
+
+  createDuckDbTable({data});
+
+  auto testLimit = [&](const std::string& function, auto limit) {
+    SCOPED_TRACE(fmt::format("{} <= {}", function, limit));
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .topNRank(function, {"c0"}, {"c1"}, limit, true)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, {}() over (partition by c0 order by c1) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+
+    // Do not emit ranks.
+    plan = PlanBuilder()
+               .values({data})
+               .topNRank(function, {"c0"}, {"c1 DESC"}, limit, false)
+               .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT c0, c1, c2 FROM (SELECT *, {}() over (partition by c0 order by c1 DESC) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+
+    // No partitioning keys.
+    plan = PlanBuilder()
+               .values({data})
+               .topNRank(function, {}, {"c1"}, limit, true)
+               .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, {}() over (order by c1) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+  };
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    testLimit(function, 1);
+    testLimit(function, 2);
+    testLimit(function, 3);
+    testLimit(function, 4);
+    testLimit(function, 10);
+  }
+}
+
+TEST_F(TopNRowNumberTest, rankSpill) {
+  // Many ties per partition spread across batches, so that peers of the last
+  // kept row span output batches and spill runs.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"d", "s", "p"},
+          {
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return row % 37; }, nullEvery(13)),
+              makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  auto testLimit = [&](const std::string& function, auto limit) {
+    SCOPED_TRACE(fmt::format("{} <= {}", function, limit));
+    core::PlanNodeId topNRowNumberId;
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRank(function, {"p"}, {"s"}, limit, true)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .planNode();
+
+    auto sql = fmt::format(
+        "SELECT * FROM (SELECT *, {}() over (partition by p order by s) as rn FROM tmp) "
+        " WHERE rn <= {}",
+        function,
+        limit);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(sql);
+
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(topNRowNumberId);
+    ASSERT_GT(stats.spilledRows, 0);
+  };
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    testLimit(function, 1);
+    testLimit(function, 5);
+    testLimit(function, 40);
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
@@ -624,16 +624,16 @@ class AggregateTypeResolver {
 
 } // namespace
 
-core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
+std::vector<core::AggregationNode::Aggregate>
+PlanBuilder::createIntermediateOrFinalAggregates(
     core::AggregationNode::Step step,
     const core::AggregationNode* partialAggNode) {
-  // Create intermediate or final aggregation using same grouping keys and same
-  // aggregate function names.
+  // Create intermediate or final aggregates using same aggregate function
+  // names.
   const auto& partialAggregates = partialAggNode->aggregates();
-  const auto& groupingKeys = partialAggNode->groupingKeys();
 
   auto numAggregates = partialAggregates.size();
-  auto numGroupingKeys = groupingKeys.size();
+  auto numGroupingKeys = partialAggNode->groupingKeys().size();
 
   std::vector<core::AggregationNode::Aggregate> aggregates;
   aggregates.reserve(numAggregates);
@@ -663,14 +663,21 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
         std::make_shared<core::CallTypedExpr>(type, std::move(inputs), name);
     aggregates.emplace_back(aggregate);
   }
+  return aggregates;
+}
 
+core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
+    core::AggregationNode::Step step,
+    const core::AggregationNode* partialAggNode) {
+  // Create intermediate or final aggregation using same grouping keys and same
+  // aggregate function names.
   return std::make_shared<core::AggregationNode>(
       nextPlanNodeId(),
       step,
-      groupingKeys,
+      partialAggNode->groupingKeys(),
       partialAggNode->preGroupedKeys(),
       partialAggNode->aggregateNames(),
-      aggregates,
+      createIntermediateOrFinalAggregates(step, partialAggNode),
       partialAggNode->ignoreNullKeys(),
       planNode_);
 }
@@ -849,23 +856,9 @@ PlanBuilder& PlanBuilder::aggregation(
   auto aggregatesAndNames = createAggregateExpressionsAndNames(
       aggregates, masks, step, rawInputTypes);
 
-  // If the aggregationNode is over a GroupId, then global grouping sets
-  // need to be populated.
   std::vector<vector_size_t> globalGroupingSets;
   std::optional<core::FieldAccessTypedExprPtr> groupId;
-  if (auto groupIdNode =
-          dynamic_cast<const core::GroupIdNode*>(planNode_.get())) {
-    for (auto i = 0; i < groupIdNode->groupingSets().size(); i++) {
-      if (groupIdNode->groupingSets().at(i).empty()) {
-        globalGroupingSets.push_back(i);
-      }
-    }
-
-    if (!globalGroupingSets.empty()) {
-      // GroupId is the last column of the GroupIdNode.
-      groupId = field(groupIdNode->outputType()->names().back());
-    }
-  }
+  findGlobalGroupingSets(globalGroupingSets, groupId);
 
   planNode_ = std::make_shared<core::AggregationNode>(
       nextPlanNodeId(),
@@ -881,6 +874,26 @@ PlanBuilder& PlanBuilder::aggregation(
   return *this;
 }
 
+void PlanBuilder::findGlobalGroupingSets(
+    std::vector<vector_size_t>& globalGroupingSets,
+    std::optional<core::FieldAccessTypedExprPtr>& groupId) {
+  // If the aggregationNode is over a GroupId, then global grouping sets
+  // need to be populated.
+  if (auto groupIdNode =
+          dynamic_cast<const core::GroupIdNode*>(planNode_.get())) {
+    for (auto i = 0; i < groupIdNode->groupingSets().size(); i++) {
+      if (groupIdNode->groupingSets().at(i).empty()) {
+        globalGroupingSets.push_back(i);
+      }
+    }
+
+    if (!globalGroupingSets.empty()) {
+      // GroupId is the last column of the GroupIdNode.
+      groupId = field(groupIdNode->outputType()->names().back());
+    }
+  }
+}
+
 PlanBuilder& PlanBuilder::streamingAggregation(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::string>& aggregates,
@@ -943,6 +956,91 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    const std::string& groupIdName) {
+  std::vector<std::string> groupingKeys;
+  for (const auto& groupingSet : groupingSets) {
+    for (const auto& key : groupingSet) {
+      if (std::find(groupingKeys.begin(), groupingKeys.end(), key) ==
+          groupingKeys.end()) {
+        groupingKeys.push_back(key);
+      }
+    }
+  }
+  auto finalGroupingKeys = groupingKeys;
+  finalGroupingKeys.push_back(groupIdName);
+
+  const auto aggregatesAndNames = createAggregateExpressionsAndNames(
+      aggregates, {}, core::AggregationNode::Step::kSingle);
+  const bool decomposable = std::none_of(
+      aggregatesAndNames.aggregates.begin(),
+      aggregatesAndNames.aggregates.end(),
+      [](const auto& aggregate) {
+        return aggregate.distinct || !aggregate.sortingKeys.empty();
+      });
+
+  if (!decomposable) {
+    // Replicate the input rows once per grouping set.
+    std::vector<std::string> aggregationInputs;
+    auto addInput = [&](const core::TypedExprPtr& expr) {
+      if (auto* fieldExpr =
+              dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+        if (std::find(
+                aggregationInputs.begin(),
+                aggregationInputs.end(),
+                fieldExpr->name()) == aggregationInputs.end()) {
+          aggregationInputs.push_back(fieldExpr->name());
+        }
+      }
+    };
+    for (const auto& aggregate : aggregatesAndNames.aggregates) {
+      for (const auto& input : aggregate.call->inputs()) {
+        addInput(input);
+      }
+      for (const auto& sortingKey : aggregate.sortingKeys) {
+        addInput(sortingKey);
+      }
+      if (aggregate.mask != nullptr) {
+        addInput(aggregate.mask);
+      }
+    }
+
+    groupId(groupingKeys, groupingSets, aggregationInputs, groupIdName);
+    return singleAggregation(finalGroupingKeys, aggregates);
+  }
+
+  // Aggregate the input once by all grouping keys, replicate the intermediate
+  // results once per grouping set and re-aggregate these.
+  partialAggregation(groupingKeys, aggregates);
+  auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  groupId(
+      groupingKeys,
+      groupingSets,
+      partialAggNode->aggregateNames(),
+      groupIdName);
+
+  std::vector<vector_size_t> globalGroupingSets;
+  std::optional<core::FieldAccessTypedExprPtr> groupIdField;
+  findGlobalGroupingSets(globalGroupingSets, groupIdField);
+
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kFinal,
+      fields(finalGroupingKeys),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      partialAggNode->aggregateNames(),
+      createIntermediateOrFinalAggregates(
+          core::AggregationNode::Step::kFinal, partialAggNode.get()),
+      globalGroupingSets,
+      groupIdField,
+      false,
+      planNode_);
+  return *this;
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
@@ -1149,7 +1247,8 @@ core::PlanNodePtr createLocalPartitionNode(
     const core::PlanNodeId& planNodeId,
     const std::vector<core::TypedExprPtr>& keys,
     const std::vector<core::PlanNodePtr>& sources,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool spreadSkewedPartitions = false) {
   auto partitionFunctionFactory =
       createPartitionFunctionSpec(sources[0]->outputType(), keys, pool);
   return std::make_shared<core::LocalPartitionNode>(
@@ -1157,7 +1256,8 @@ core::PlanNodePtr createLocalPartitionNode(
       keys.empty() ? core::LocalPartitionNode::Type::kGather
                    : core::LocalPartitionNode::Type::kRepartition,
       partitionFunctionFactory,
-      sources);
+      sources,
+      spreadSkewedPartitions);
 }
 } // namespace
 
@@ -1250,6 +1350,18 @@ PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localPartitionSpreadSkewed(
+    const std::vector<std::string>& keys) {
+  VELOX_CHECK(!keys.empty(), "Spreading skewed partitions requires keys");
+  planNode_ = createLocalPartitionNode(
+      nextPlanNodeId(),
+      exprs(keys, planNode_->outputType()),
+      {planNode_},
+      pool_,
+      /*spreadSkewedPartitions=*/true);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localPartitionByBucket(
     const std::shared_ptr<connector::hive::HiveBucketProperty>&
         bucketProperty) {
@@ -1823,15 +1935,26 @@ PlanBuilder& PlanBuilder::topNRowNumber(
     const std::vector<std::string>& sortingKeys,
     int32_t limit,
     bool generateRowNumber) {
+  return topNRank(
+      "row_number", partitionKeys, sortingKeys, limit, generateRowNumber);
+}
+
+PlanBuilder& PlanBuilder::topNRank(
+    std::string_view function,
+    const std::vector<std::string>& partitionKeys,
+    const std::vector<std::string>& sortingKeys,
+    int32_t limit,
+    bool generateRank) {
   VELOX_CHECK_NOT_NULL(planNode_, "TopNRowNumber cannot be the source node");
   auto [sortingFields, sortingOrders] =
       parseOrderByClauses(sortingKeys, planNode_->outputType(), pool_);
   std::optional<std::string> rowNumberColumnName;
-  if (generateRowNumber) {
-    rowNumberColumnName = "row_number";
+  if (generateRank) {
+    rowNumberColumnName = std::string(function);
   }
   planNode_ = std::make_shared<core::TopNRowNumberNode>(
       nextPlanNodeId(),
+      core::TopNRowNumberNode::rankFunctionFromName(std::string(function)),
       fields(partitionKeys),
       sortingFields,
       sortingOrders,
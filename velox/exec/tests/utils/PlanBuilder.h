@@ -684,6 +684,31 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add plan nodes that compute 'aggregates' for each of the 'groupingSets',
+  /// e.g. a ROLLUP or a CUBE. Unlike groupId() followed by
+  /// singleAggregation(), which replicates every input row once per grouping
+  /// set, the input is aggregated once by the union of all grouping keys. A
+  /// GroupIdNode then replicates the much smaller intermediate results and a
+  /// final aggregation re-aggregates them for each grouping set. Falls back to
+  /// replicating the input rows if some of the aggregates cannot be split into
+  /// partial and final, i.e. are over distinct or sorted inputs. The inputs of
+  /// such aggregates must not be grouping keys.
+  ///
+  /// The output columns are the grouping keys in the order they first appear in
+  /// 'groupingSets', followed by 'groupIdName' and the aggregates.
+  ///
+  /// For example,
+  ///
+  ///     groupingSetsAggregation(
+  ///         {{"k1", "k2"}, {"k1"}, {}}, {"sum(a) AS sum_a", "count(1)"})
+  ///
+  /// computes GROUP BY ROLLUP (k1, k2) and produces output columns k1, k2,
+  /// group_id, sum_a and a1.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      const std::string& groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
@@ -829,6 +854,19 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartition(const std::vector<std::string>& keys);
 
+  /// Same as localPartition(keys) but spreads the rows of partitions that
+  /// receive much more than their share of the rows over all partitions. The
+  /// consumer must produce partial results that are merged after another
+  /// repartitioning, e.g.
+  ///
+  ///   .localPartitionSpreadSkewed({"k"})
+  ///   .partialAggregation({"k"}, {"sum(v)"})
+  ///   .localPartition({"k"})
+  ///   .finalAggregation()
+  ///
+  /// See core::LocalPartitionNode::spreadSkewedPartitions().
+  PlanBuilder& localPartitionSpreadSkewed(const std::vector<std::string>& keys);
+
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
   PlanBuilder& localPartitionByBucket(
@@ -987,6 +1025,17 @@ class PlanBuilder {
       int32_t limit,
       bool generateRowNumber);
 
+  /// Add a TopNRowNumberNode to compute single row_number, rank or dense_rank
+  /// window function with a limit applied to sorted partitions.
+  /// @param function Name of the window function: row_number, rank or
+  /// dense_rank.
+  PlanBuilder& topNRank(
+      std::string_view function,
+      const std::vector<std::string>& partitionKeys,
+      const std::vector<std::string>& sortingKeys,
+      int32_t limit,
+      bool generateRank);
+
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
@@ -1083,6 +1132,13 @@ class PlanBuilder {
       core::AggregationNode::Step step,
       const core::AggregationNode* partialAggNode);
 
+  // Returns intermediate or final aggregates over the outputs of
+  // 'partialAggNode' that follow its grouping keys in the current plan node.
+  std::vector<core::AggregationNode::Aggregate>
+  createIntermediateOrFinalAggregates(
+      core::AggregationNode::Step step,
+      const core::AggregationNode* partialAggNode);
+
   struct AggregatesAndNames {
     std::vector<core::AggregationNode::Aggregate> aggregates;
     std::vector<std::string> names;
@@ -1103,6 +1159,12 @@ class PlanBuilder {
       bool ignoreNullKeys,
       const std::vector<std::vector<TypePtr>>& rawInputTypes);
 
+  // Sets 'globalGroupingSets' and 'groupId' for an aggregation over the current
+  // plan node if it is a GroupIdNode with empty grouping sets.
+  void findGlobalGroupingSets(
+      std::vector<vector_size_t>& globalGroupingSets,
+      std::optional<core::FieldAccessTypedExprPtr>& groupId);
+
   /// Create WindowNode based on whether input is sorted and then compute the
   /// window functions.
   PlanBuilder& window(
@@ -0,0 +1,994 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/jit/JitFilterProject.h"
+
+#include <deque>
+#include <set>
+
+#include <folly/Synchronized.h>
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::jit {
+
+namespace {
+
+// Signature of the generated function. 'columns' has the raw values of the
+// input columns that are referenced by the expressions. 'outputs' has the raw
+// values of the projections. Returns the number of rows that passed the filter
+// and writes their indices to 'selected', or -1 if a row raised an error.
+using PipelineFunction = int32_t (*)(
+    const void* const* columns,
+    int32_t numRows,
+    void* const* outputs,
+    int32_t* selected);
+
+enum class JitOp {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+  kBetween,
+  kAnd,
+  kOr,
+  kNot,
+};
+
+std::optional<JitOp> toJitOp(
+    const std::string& name,
+    const std::string& prefix) {
+  // Special forms are registered without a prefix.
+  if (name == "and") {
+    return JitOp::kAnd;
+  }
+  if (name == "or") {
+    return JitOp::kOr;
+  }
+  static const std::unordered_map<std::string, JitOp> kFunctions = {
+      {"plus", JitOp::kPlus},
+      {"minus", JitOp::kMinus},
+      {"multiply", JitOp::kMultiply},
+      {"divide", JitOp::kDivide},
+      {"eq", JitOp::kEq},
+      {"neq", JitOp::kNeq},
+      {"lt", JitOp::kLt},
+      {"lte", JitOp::kLte},
+      {"gt", JitOp::kGt},
+      {"gte", JitOp::kGte},
+      {"between", JitOp::kBetween},
+      {"not", JitOp::kNot},
+  };
+  if (name.compare(0, prefix.size(), prefix) != 0) {
+    return std::nullopt;
+  }
+  auto it = kFunctions.find(name.substr(prefix.size()));
+  if (it == kFunctions.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+// Returns true for the scalar types the generated code reads and writes.
+// Logical types with the same physical type, e.g. DATE or DECIMAL, are
+// excluded because their functions have different semantics.
+bool isSupportedType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+      return type->name() == mapTypeKindToName(type->kind());
+    default:
+      return false;
+  }
+}
+
+bool isNumeric(const TypePtr& type) {
+  return type->kind() != TypeKind::BOOLEAN &&
+      type->kind() != TypeKind::VARCHAR;
+}
+
+bool isFloatingPoint(const TypePtr& type) {
+  return type->kind() == TypeKind::REAL || type->kind() == TypeKind::DOUBLE;
+}
+
+const core::FieldAccessTypedExpr* asInputField(const core::TypedExprPtr& expr) {
+  auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr) {
+    return nullptr;
+  }
+  const auto& inputs = field->inputs();
+  if (inputs.empty() ||
+      (inputs.size() == 1 &&
+       dynamic_cast<const core::InputTypedExpr*>(inputs[0].get()))) {
+    return field;
+  }
+  return nullptr;
+}
+
+bool allInputsHaveType(const core::TypedExprPtr& expr, const TypePtr& type) {
+  for (const auto& input : expr->inputs()) {
+    if (input->type()->kind() != type->kind()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isSupported(const core::TypedExprPtr& expr, const std::string& prefix) {
+  if (!isSupportedType(expr->type())) {
+    return false;
+  }
+  if (asInputField(expr) != nullptr) {
+    return true;
+  }
+  if (auto* constant =
+          dynamic_cast<const core::ConstantTypedExpr*>(expr.get())) {
+    return !constant->hasValueVector() && !constant->value().isNull();
+  }
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return false;
+  }
+  const auto op = toJitOp(call->name(), prefix);
+  if (!op.has_value()) {
+    return false;
+  }
+  for (const auto& input : call->inputs()) {
+    if (!isSupported(input, prefix)) {
+      return false;
+    }
+  }
+
+  const auto& type = call->type();
+  const auto& inputs = call->inputs();
+  switch (op.value()) {
+    case JitOp::kPlus:
+    case JitOp::kMinus:
+    case JitOp::kMultiply:
+    case JitOp::kDivide:
+      return inputs.size() == 2 && isNumeric(type) &&
+          allInputsHaveType(expr, type);
+    case JitOp::kEq:
+    case JitOp::kNeq:
+    case JitOp::kLt:
+    case JitOp::kLte:
+    case JitOp::kGt:
+    case JitOp::kGte:
+      return inputs.size() == 2 && type->isBoolean() &&
+          allInputsHaveType(expr, inputs[0]->type());
+    case JitOp::kBetween:
+      return inputs.size() == 3 && type->isBoolean() &&
+          !inputs[0]->type()->isBoolean() &&
+          allInputsHaveType(expr, inputs[0]->type());
+    case JitOp::kAnd:
+    case JitOp::kOr:
+      return inputs.size() >= 2 && type->isBoolean() &&
+          allInputsHaveType(expr, BOOLEAN());
+    case JitOp::kNot:
+      return inputs.size() == 1 && type->isBoolean() &&
+          allInputsHaveType(expr, BOOLEAN());
+  }
+  VELOX_UNREACHABLE();
+}
+
+void collectChannels(
+    const core::TypedExprPtr& expr,
+    const RowTypePtr& inputType,
+    std::set<column_index_t>& channels) {
+  if (auto* field = asInputField(expr)) {
+    channels.insert(inputType->getChildIdx(field->name()));
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectChannels(input, inputType, channels);
+  }
+}
+
+// Cache key that identifies the expressions including the types of all
+// nodes.
+void appendCacheKey(const core::TypedExprPtr& expr, std::string& key) {
+  key += expr->type()->toString();
+  key += ':';
+  if (auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    key += call->name();
+  } else if (
+      auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    key += field->name();
+  } else {
+    key += expr->toString();
+  }
+  key += '(';
+  for (const auto& input : expr->inputs()) {
+    appendCacheKey(input, key);
+    key += ',';
+  }
+  key += ')';
+}
+
+int32_t compareStrings(const StringView* left, const StringView* right) {
+  return left->compare(*right);
+}
+
+// Owns the VARCHAR constants referenced by the generated code.
+struct StringConstants {
+  std::deque<std::string> strings;
+  std::deque<StringView> views;
+};
+
+// Generates the LLVM IR for a PipelineFunction. The function loops over the
+// rows. For each row it evaluates the filter and, if the row passes, records
+// it in 'selected' and evaluates the projections. Errors, e.g. integer
+// overflow, are accumulated in a flag instead of leaving the loop, so that
+// the loop body stays free of early exits.
+class PipelineCodegen {
+ public:
+  PipelineCodegen(
+      llvm::LLVMContext& context,
+      llvm::Module& module,
+      const RowTypePtr& inputType,
+      const std::string& prefix,
+      StringConstants& stringConstants)
+      : context_(context),
+        module_(module),
+        builder_(context),
+        inputType_(inputType),
+        prefix_(prefix),
+        stringConstants_(stringConstants) {}
+
+  void generate(
+      const std::vector<core::TypedExprPtr>& exprs,
+      bool hasFilter,
+      const std::string& name) {
+    auto* int32Type = builder_.getInt32Ty();
+    auto* pointerType = bytePointerType();
+    auto* functionType = llvm::FunctionType::get(
+        int32Type,
+        {llvm::PointerType::getUnqual(pointerType),
+         int32Type,
+         llvm::PointerType::getUnqual(pointerType),
+         llvm::PointerType::getUnqual(int32Type)},
+        false);
+    function_ = llvm::Function::Create(
+        functionType, llvm::Function::ExternalLinkage, name, module_);
+    auto* columns = function_->getArg(0);
+    auto* numRows = function_->getArg(1);
+    auto* outputs = function_->getArg(2);
+    auto* selected = function_->getArg(3);
+
+    auto* entry = llvm::BasicBlock::Create(context_, "entry", function_);
+    auto* loop = llvm::BasicBlock::Create(context_, "loop", function_);
+    auto* latch = llvm::BasicBlock::Create(context_, "latch", function_);
+    auto* exit = llvm::BasicBlock::Create(context_, "exit", function_);
+
+    // Loads the base addresses of the inputs and outputs once.
+    builder_.SetInsertPoint(entry);
+    errorFlag_ = builder_.CreateAlloca(builder_.getInt1Ty());
+    builder_.CreateStore(builder_.getFalse(), errorFlag_);
+    std::set<column_index_t> channels;
+    for (const auto& expr : exprs) {
+      collectChannels(expr, inputType_, channels);
+    }
+    for (auto channel : channels) {
+      columnBases_[channel] = builder_.CreateLoad(
+          pointerType,
+          builder_.CreateGEP(pointerType, columns, builder_.getInt32(channel)));
+    }
+    const int32_t firstProjection = hasFilter ? 1 : 0;
+    std::vector<llvm::Value*> outputBases;
+    for (auto i = firstProjection; i < exprs.size(); ++i) {
+      outputBases.push_back(builder_.CreateLoad(
+          pointerType,
+          builder_.CreateGEP(
+              pointerType,
+              outputs,
+              builder_.getInt32(i - firstProjection))));
+    }
+    builder_.CreateCondBr(
+        builder_.CreateICmpSGT(numRows, builder_.getInt32(0)), loop, exit);
+
+    builder_.SetInsertPoint(loop);
+    auto* row = builder_.CreatePHI(int32Type, 2);
+    auto* count = builder_.CreatePHI(int32Type, 2);
+    row_ = builder_.CreateSExt(row, builder_.getInt64Ty());
+
+    llvm::BasicBlock* rejectedBlock = nullptr;
+    if (hasFilter) {
+      auto* passed = genExpr(exprs[0]);
+      auto* selectedBlock =
+          llvm::BasicBlock::Create(context_, "selected", function_);
+      rejectedBlock = builder_.GetInsertBlock();
+      builder_.CreateCondBr(passed, selectedBlock, latch);
+      builder_.SetInsertPoint(selectedBlock);
+      builder_.CreateStore(
+          row, builder_.CreateGEP(int32Type, selected, count));
+    }
+    for (auto i = firstProjection; i < exprs.size(); ++i) {
+      genStore(
+          exprs[i]->type(),
+          outputBases[i - firstProjection],
+          genExpr(exprs[i]));
+    }
+    auto* nextCount = builder_.CreateAdd(count, builder_.getInt32(1));
+    auto* selectedEnd = builder_.GetInsertBlock();
+    builder_.CreateBr(latch);
+
+    builder_.SetInsertPoint(latch);
+    auto* countAtLatch = builder_.CreatePHI(int32Type, 2);
+    countAtLatch->addIncoming(nextCount, selectedEnd);
+    if (rejectedBlock != nullptr) {
+      countAtLatch->addIncoming(count, rejectedBlock);
+    }
+    auto* nextRow = builder_.CreateAdd(row, builder_.getInt32(1));
+    builder_.CreateCondBr(
+        builder_.CreateICmpSLT(nextRow, numRows), loop, exit);
+
+    row->addIncoming(builder_.getInt32(0), entry);
+    row->addIncoming(nextRow, latch);
+    count->addIncoming(builder_.getInt32(0), entry);
+    count->addIncoming(countAtLatch, latch);
+
+    builder_.SetInsertPoint(exit);
+    auto* result = builder_.CreatePHI(int32Type, 2);
+    result->addIncoming(builder_.getInt32(0), entry);
+    result->addIncoming(countAtLatch, latch);
+    auto* error = builder_.CreateLoad(builder_.getInt1Ty(), errorFlag_);
+    builder_.CreateRet(
+        builder_.CreateSelect(error, builder_.getInt32(-1), result));
+
+    std::string message;
+    llvm::raw_string_ostream out(message);
+    VELOX_CHECK(
+        !llvm::verifyFunction(*function_, &out),
+        "Invalid generated function: {}",
+        out.str());
+  }
+
+ private:
+  llvm::Type* bytePointerType() {
+    return llvm::PointerType::getUnqual(builder_.getInt8Ty());
+  }
+
+  llvm::Type* llvmType(const TypePtr& type) {
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN:
+        return builder_.getInt1Ty();
+      case TypeKind::TINYINT:
+        return builder_.getInt8Ty();
+      case TypeKind::SMALLINT:
+        return builder_.getInt16Ty();
+      case TypeKind::INTEGER:
+        return builder_.getInt32Ty();
+      case TypeKind::BIGINT:
+        return builder_.getInt64Ty();
+      case TypeKind::REAL:
+        return builder_.getFloatTy();
+      case TypeKind::DOUBLE:
+        return builder_.getDoubleTy();
+      case TypeKind::VARCHAR:
+        // Pointer to a StringView.
+        return bytePointerType();
+      default:
+        VELOX_UNREACHABLE("Unsupported type: {}", type->toString());
+    }
+  }
+
+  // Returns a pointer to the element type of 'type' at 'base'.
+  llvm::Value* typedBase(llvm::Value* base, llvm::Type* elementType) {
+    return builder_.CreateBitCast(
+        base, llvm::PointerType::getUnqual(elementType));
+  }
+
+  // Returns the address of the 64 bit word holding the bit of the current row
+  // and the mask of the bit within the word.
+  std::pair<llvm::Value*, llvm::Value*> bitAddress(llvm::Value* base) {
+    auto* int64Type = builder_.getInt64Ty();
+    auto* word = builder_.CreateGEP(
+        int64Type,
+        typedBase(base, int64Type),
+        builder_.CreateLShr(row_, builder_.getInt64(6)));
+    auto* mask = builder_.CreateShl(
+        builder_.getInt64(1),
+        builder_.CreateAnd(row_, builder_.getInt64(63)));
+    return {word, mask};
+  }
+
+  llvm::Value* genExpr(const core::TypedExprPtr& expr) {
+    if (auto* field = asInputField(expr)) {
+      return genField(*field);
+    }
+    if (auto* constant =
+            dynamic_cast<const core::ConstantTypedExpr*>(expr.get())) {
+      return genConstant(*constant);
+    }
+    auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+    VELOX_CHECK_NOT_NULL(call);
+    return genCall(*call);
+  }
+
+  llvm::Value* genField(const core::FieldAccessTypedExpr& field) {
+    auto* base = columnBases_.at(inputType_->getChildIdx(field.name()));
+    const auto& type = field.type();
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN: {
+        auto [word, mask] = bitAddress(base);
+        auto* bits = builder_.CreateLoad(builder_.getInt64Ty(), word);
+        return builder_.CreateICmpNE(
+            builder_.CreateAnd(bits, mask), builder_.getInt64(0));
+      }
+      case TypeKind::VARCHAR:
+        return builder_.CreateGEP(
+            builder_.getInt8Ty(),
+            base,
+            builder_.CreateMul(row_, builder_.getInt64(sizeof(StringView))));
+      default: {
+        auto* elementType = llvmType(type);
+        return builder_.CreateLoad(
+            elementType,
+            builder_.CreateGEP(
+                elementType, typedBase(base, elementType), row_));
+      }
+    }
+  }
+
+  llvm::Value* genConstant(const core::ConstantTypedExpr& constant) {
+    const auto& value = constant.value();
+    auto* type = llvmType(constant.type());
+    switch (constant.type()->kind()) {
+      case TypeKind::BOOLEAN:
+        return builder_.getInt1(value.value<TypeKind::BOOLEAN>());
+      case TypeKind::TINYINT:
+        return llvm::ConstantInt::get(
+            type, value.value<TypeKind::TINYINT>(), true);
+      case TypeKind::SMALLINT:
+        return llvm::ConstantInt::get(
+            type, value.value<TypeKind::SMALLINT>(), true);
+      case TypeKind::INTEGER:
+        return llvm::ConstantInt::get(
+            type, value.value<TypeKind::INTEGER>(), true);
+      case TypeKind::BIGINT:
+        return llvm::ConstantInt::get(
+            type, value.value<TypeKind::BIGINT>(), true);
+      case TypeKind::REAL:
+        return llvm::ConstantFP::get(type, value.value<TypeKind::REAL>());
+      case TypeKind::DOUBLE:
+        return llvm::ConstantFP::get(type, value.value<TypeKind::DOUBLE>());
+      case TypeKind::VARCHAR: {
+        auto& string = stringConstants_.strings.emplace_back(
+            value.value<TypeKind::VARCHAR>());
+        auto& view = stringConstants_.views.emplace_back(string);
+        return pointerConstant(&view, type);
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  llvm::Value* pointerConstant(const void* pointer, llvm::Type* type) {
+    return llvm::ConstantExpr::getIntToPtr(
+        builder_.getInt64(reinterpret_cast<uint64_t>(pointer)), type);
+  }
+
+  llvm::Value* genCall(const core::CallTypedExpr& call) {
+    std::vector<llvm::Value*> args;
+    for (const auto& input : call.inputs()) {
+      args.push_back(genExpr(input));
+    }
+    const auto& argType = call.inputs()[0]->type();
+    switch (toJitOp(call.name(), prefix_).value()) {
+      case JitOp::kPlus:
+        return genArithmetic(
+            llvm::Instruction::FAdd,
+            llvm::Intrinsic::sadd_with_overflow,
+            call.type(),
+            args[0],
+            args[1]);
+      case JitOp::kMinus:
+        return genArithmetic(
+            llvm::Instruction::FSub,
+            llvm::Intrinsic::ssub_with_overflow,
+            call.type(),
+            args[0],
+            args[1]);
+      case JitOp::kMultiply:
+        return genArithmetic(
+            llvm::Instruction::FMul,
+            llvm::Intrinsic::smul_with_overflow,
+            call.type(),
+            args[0],
+            args[1]);
+      case JitOp::kDivide:
+        return genDivide(call.type(), args[0], args[1]);
+      case JitOp::kEq:
+        return genEquals(argType, args[0], args[1]);
+      case JitOp::kNeq:
+        return builder_.CreateNot(genEquals(argType, args[0], args[1]));
+      case JitOp::kLt:
+        return genLessThan(argType, args[0], args[1]);
+      case JitOp::kGt:
+        return genLessThan(argType, args[1], args[0]);
+      case JitOp::kLte:
+        return builder_.CreateNot(genLessThan(argType, args[1], args[0]));
+      case JitOp::kGte:
+        return builder_.CreateNot(genLessThan(argType, args[0], args[1]));
+      case JitOp::kBetween:
+        return builder_.CreateAnd(
+            builder_.CreateNot(genLessThan(argType, args[0], args[1])),
+            builder_.CreateNot(genLessThan(argType, args[2], args[0])));
+      case JitOp::kAnd: {
+        auto* result = args[0];
+        for (auto i = 1; i < args.size(); ++i) {
+          result = builder_.CreateAnd(result, args[i]);
+        }
+        return result;
+      }
+      case JitOp::kOr: {
+        auto* result = args[0];
+        for (auto i = 1; i < args.size(); ++i) {
+          result = builder_.CreateOr(result, args[i]);
+        }
+        return result;
+      }
+      case JitOp::kNot:
+        return builder_.CreateNot(args[0]);
+    }
+    VELOX_UNREACHABLE();
+  }
+
+  // Sets the error flag if 'error' is true for the current row.
+  void recordError(llvm::Value* error) {
+    auto* flag = builder_.CreateLoad(builder_.getInt1Ty(), errorFlag_);
+    builder_.CreateStore(builder_.CreateOr(flag, error), errorFlag_);
+  }
+
+  // Integer arithmetic is checked like the Presto functions. On overflow the
+  // batch is handed back to the interpreter, which raises the error.
+  llvm::Value* genArithmetic(
+      llvm::Instruction::BinaryOps floatingPointOp,
+      llvm::Intrinsic::ID checkedIntegerOp,
+      const TypePtr& type,
+      llvm::Value* left,
+      llvm::Value* right) {
+    if (isFloatingPoint(type)) {
+      return builder_.CreateBinOp(floatingPointOp, left, right);
+    }
+    auto* intrinsic = llvm::Intrinsic::getDeclaration(
+        &module_, checkedIntegerOp, {llvmType(type)});
+    auto* result = builder_.CreateCall(intrinsic, {left, right});
+    recordError(builder_.CreateExtractValue(result, 1));
+    return builder_.CreateExtractValue(result, 0);
+  }
+
+  llvm::Value* genDivide(
+      const TypePtr& type,
+      llvm::Value* left,
+      llvm::Value* right) {
+    if (isFloatingPoint(type)) {
+      return builder_.CreateFDiv(left, right);
+    }
+    // Division by zero and MIN / -1 trap, so these rows divide by 1 instead
+    // and raise an error.
+    auto* integerType = llvm::cast<llvm::IntegerType>(llvmType(type));
+    const auto bits = integerType->getBitWidth();
+    auto* minValue = llvm::ConstantInt::get(
+        integerType, llvm::APInt::getSignedMinValue(bits));
+    auto* minusOne = llvm::ConstantInt::get(integerType, -1, true);
+    auto* invalid = builder_.CreateOr(
+        builder_.CreateICmpEQ(right, llvm::ConstantInt::get(integerType, 0)),
+        builder_.CreateAnd(
+            builder_.CreateICmpEQ(left, minValue),
+            builder_.CreateICmpEQ(right, minusOne)));
+    recordError(invalid);
+    return builder_.CreateSDiv(
+        left,
+        builder_.CreateSelect(
+            invalid, llvm::ConstantInt::get(integerType, 1), right));
+  }
+
+  // Returns the result of compareStrings() on the StringViews at 'left' and
+  // 'right'.
+  llvm::Value* genCompareStrings(llvm::Value* left, llvm::Value* right) {
+    auto* int32Type = builder_.getInt32Ty();
+    auto* functionType = llvm::FunctionType::get(
+        int32Type, {bytePointerType(), bytePointerType()}, false);
+    auto* callee = pointerConstant(
+        reinterpret_cast<const void*>(&compareStrings),
+        llvm::PointerType::getUnqual(functionType));
+    return builder_.CreateCall(functionType, callee, {left, right});
+  }
+
+  // Floating point comparisons follow the Presto semantics where NaN equals
+  // NaN and is larger than any other value.
+  llvm::Value*
+  genEquals(const TypePtr& type, llvm::Value* left, llvm::Value* right) {
+    if (type->isVarchar()) {
+      return builder_.CreateICmpEQ(
+          genCompareStrings(left, right), builder_.getInt32(0));
+    }
+    if (isFloatingPoint(type)) {
+      return builder_.CreateOr(
+          builder_.CreateFCmpOEQ(left, right),
+          builder_.CreateAnd(
+              builder_.CreateFCmpUNO(left, left),
+              builder_.CreateFCmpUNO(right, right)));
+    }
+    return builder_.CreateICmpEQ(left, right);
+  }
+
+  llvm::Value*
+  genLessThan(const TypePtr& type, llvm::Value* left, llvm::Value* right) {
+    if (type->isVarchar()) {
+      return builder_.CreateICmpSLT(
+          genCompareStrings(left, right), builder_.getInt32(0));
+    }
+    if (isFloatingPoint(type)) {
+      // 'left' is not NaN and either 'right' is NaN or 'left' < 'right'.
+      return builder_.CreateAnd(
+          builder_.CreateFCmpORD(left, left),
+          builder_.CreateFCmpULT(left, right));
+    }
+    if (type->isBoolean()) {
+      return builder_.CreateICmpULT(left, right);
+    }
+    return builder_.CreateICmpSLT(left, right);
+  }
+
+  void genStore(const TypePtr& type, llvm::Value* base, llvm::Value* value) {
+    if (type->isBoolean()) {
+      auto [word, mask] = bitAddress(base);
+      auto* int64Type = builder_.getInt64Ty();
+      auto* bits = builder_.CreateLoad(int64Type, word);
+      builder_.CreateStore(
+          builder_.CreateSelect(
+              value,
+              builder_.CreateOr(bits, mask),
+              builder_.CreateAnd(bits, builder_.CreateNot(mask))),
+          word);
+      return;
+    }
+    auto* elementType = llvmType(type);
+    builder_.CreateStore(
+        value,
+        builder_.CreateGEP(elementType, typedBase(base, elementType), row_));
+  }
+
+  llvm::LLVMContext& context_;
+  llvm::Module& module_;
+  llvm::IRBuilder<> builder_;
+  const RowTypePtr inputType_;
+  const std::string prefix_;
+  StringConstants& stringConstants_;
+
+  llvm::Function* function_{nullptr};
+  // Current row as a 64 bit index.
+  llvm::Value* row_{nullptr};
+  // Set if any row raised an error.
+  llvm::Value* errorFlag_{nullptr};
+  std::unordered_map<column_index_t, llvm::Value*> columnBases_;
+};
+
+void checkLlvm(llvm::Error error) {
+  if (error) {
+    VELOX_FAIL("LLVM error: {}", llvm::toString(std::move(error)));
+  }
+}
+
+template <typename T>
+T checkLlvm(llvm::Expected<T> expected) {
+  checkLlvm(expected.takeError());
+  return std::move(expected.get());
+}
+
+// Process wide LLVM ORC JIT. Each compiled pipeline is a separate module
+// with its own resource tracker so that it can be unloaded independently.
+class JitEngine {
+ public:
+  static JitEngine& instance() {
+    static JitEngine engine;
+    return engine;
+  }
+
+  // Optimizes and compiles 'module' and returns the address of the function
+  // 'name' with the resource tracker that owns the code.
+  std::pair<void*, llvm::orc::ResourceTrackerSP> add(
+      std::unique_ptr<llvm::LLVMContext> context,
+      std::unique_ptr<llvm::Module> module,
+      const std::string& name) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      module->setDataLayout(targetMachine_->createDataLayout());
+      module->setTargetTriple(targetMachine_->getTargetTriple().str());
+      optimize(*module);
+    }
+    auto tracker = jit_->getMainJITDylib().createResourceTracker();
+    checkLlvm(jit_->addIRModule(
+        tracker,
+        llvm::orc::ThreadSafeModule(std::move(module), std::move(context))));
+    auto symbol = checkLlvm(jit_->lookup(name));
+#if LLVM_VERSION_MAJOR >= 15
+    const auto address = symbol.getValue();
+#else
+    const auto address = symbol.getAddress();
+#endif
+    return {reinterpret_cast<void*>(address), std::move(tracker)};
+  }
+
+ private:
+  JitEngine() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    auto targetMachineBuilder =
+        checkLlvm(llvm::orc::JITTargetMachineBuilder::detectHost());
+    targetMachine_ = checkLlvm(targetMachineBuilder.createTargetMachine());
+    jit_ = checkLlvm(llvm::orc::LLJITBuilder()
+                         .setJITTargetMachineBuilder(
+                             std::move(targetMachineBuilder))
+                         .create());
+  }
+
+  void optimize(llvm::Module& module) {
+    llvm::LoopAnalysisManager loopAnalysis;
+    llvm::FunctionAnalysisManager functionAnalysis;
+    llvm::CGSCCAnalysisManager cgsccAnalysis;
+    llvm::ModuleAnalysisManager moduleAnalysis;
+    llvm::PassBuilder passBuilder(targetMachine_.get());
+    passBuilder.registerModuleAnalyses(moduleAnalysis);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalysis);
+    passBuilder.registerFunctionAnalyses(functionAnalysis);
+    passBuilder.registerLoopAnalyses(loopAnalysis);
+    passBuilder.crossRegisterProxies(
+        loopAnalysis, functionAnalysis, cgsccAnalysis, moduleAnalysis);
+    passBuilder
+        .buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3)
+        .run(module, moduleAnalysis);
+  }
+
+  std::mutex mutex_;
+  std::unique_ptr<llvm::TargetMachine> targetMachine_;
+  std::unique_ptr<llvm::orc::LLJIT> jit_;
+};
+
+class JitFilterProject : public exec::CompiledFilterProject {
+ public:
+  JitFilterProject(
+      PipelineFunction function,
+      llvm::orc::ResourceTrackerSP tracker,
+      std::unique_ptr<StringConstants> stringConstants,
+      bool hasFilter,
+      std::vector<column_index_t> channels,
+      std::vector<TypePtr> projectionTypes)
+      : function_(function),
+        tracker_(std::move(tracker)),
+        stringConstants_(std::move(stringConstants)),
+        hasFilter_(hasFilter),
+        channels_(std::move(channels)),
+        projectionTypes_(std::move(projectionTypes)) {}
+
+  ~JitFilterProject() override {
+    if (auto error = tracker_->remove()) {
+      LOG(WARNING) << "Failed to release JIT code: "
+                   << llvm::toString(std::move(error));
+    }
+  }
+
+  std::optional<vector_size_t> evaluate(
+      const RowVector& input,
+      vector_size_t* selectedIndices,
+      std::vector<VectorPtr>& results,
+      memory::MemoryPool* pool) const override {
+    const auto size = input.size();
+    std::vector<const void*> columns(input.childrenSize(), nullptr);
+    for (auto channel : channels_) {
+      const auto* column = input.childAt(channel)->loadedVector();
+      if (!column->isFlatEncoding() || column->mayHaveNulls()) {
+        return std::nullopt;
+      }
+      columns[channel] = column->valuesAsVoid();
+    }
+
+    const int32_t firstProjection = hasFilter_ ? 1 : 0;
+    results.resize(firstProjection + projectionTypes_.size());
+    std::vector<void*> outputs(projectionTypes_.size());
+    for (auto i = 0; i < projectionTypes_.size(); ++i) {
+      auto& result = results[firstProjection + i];
+      result = BaseVector::create(projectionTypes_[i], size, pool);
+      outputs[i] = result->values()->asMutable<uint8_t>();
+    }
+
+    const auto numSelected =
+        function_(columns.data(), size, outputs.data(), selectedIndices);
+    if (numSelected < 0) {
+      return std::nullopt;
+    }
+    return numSelected;
+  }
+
+ private:
+  const PipelineFunction function_;
+  const llvm::orc::ResourceTrackerSP tracker_;
+  const std::unique_ptr<StringConstants> stringConstants_;
+  const bool hasFilter_;
+  const std::vector<column_index_t> channels_;
+  const std::vector<TypePtr> projectionTypes_;
+};
+
+std::shared_ptr<const exec::CompiledFilterProject> compile(
+    const std::vector<core::TypedExprPtr>& exprs,
+    bool hasFilter,
+    const RowTypePtr& inputType,
+    const std::string& prefix) {
+  for (auto i = 0; i < exprs.size(); ++i) {
+    if (!isSupported(exprs[i], prefix)) {
+      return nullptr;
+    }
+    // The outputs are written in place and must be fixed width.
+    if ((hasFilter && i == 0) ? !exprs[i]->type()->isBoolean()
+                              : exprs[i]->type()->isVarchar()) {
+      return nullptr;
+    }
+  }
+
+  std::set<column_index_t> channels;
+  std::vector<TypePtr> projectionTypes;
+  for (auto i = 0; i < exprs.size(); ++i) {
+    collectChannels(exprs[i], inputType, channels);
+    if (!hasFilter || i > 0) {
+      projectionTypes.push_back(exprs[i]->type());
+    }
+  }
+
+  static std::atomic<uint64_t> nextId{0};
+  const auto name = fmt::format("velox_jit_filter_project_{}", nextId++);
+  auto context = std::make_unique<llvm::LLVMContext>();
+  auto module = std::make_unique<llvm::Module>(name, *context);
+  auto stringConstants = std::make_unique<StringConstants>();
+  PipelineCodegen(*context, *module, inputType, prefix, *stringConstants)
+      .generate(exprs, hasFilter, name);
+  auto [address, tracker] =
+      JitEngine::instance().add(std::move(context), std::move(module), name);
+  return std::make_shared<JitFilterProject>(
+      reinterpret_cast<PipelineFunction>(address),
+      std::move(tracker),
+      std::move(stringConstants),
+      hasFilter,
+      std::vector<column_index_t>(channels.begin(), channels.end()),
+      std::move(projectionTypes));
+}
+
+class JitCache {
+ public:
+  static JitCache& instance() {
+    static JitCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<const exec::CompiledFilterProject> getOrCompile(
+      const std::vector<core::TypedExprPtr>& exprs,
+      bool hasFilter,
+      const RowTypePtr& inputType,
+      const std::string& prefix) {
+    auto key =
+        fmt::format("{}|{}|{}|", prefix, hasFilter, inputType->toString());
+    for (const auto& expr : exprs) {
+      appendCacheKey(expr, key);
+      key += '|';
+    }
+
+    {
+      auto entries = entries_.rlock();
+      auto it = entries->find(key);
+      if (it != entries->end()) {
+        ++numHits_;
+        return it->second;
+      }
+    }
+    ++numMisses_;
+
+    std::shared_ptr<const exec::CompiledFilterProject> compiled;
+    try {
+      compiled = compile(exprs, hasFilter, inputType, prefix);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to compile FilterProject, using the interpreter: "
+                   << e.what();
+    }
+
+    auto entries = entries_.wlock();
+    if (entries->size() >= kMaxEntries) {
+      entries->erase(entries->begin());
+    }
+    return entries->emplace(std::move(key), std::move(compiled))
+        .first->second;
+  }
+
+  JitCacheStats stats() const {
+    return {entries_.rlock()->size(), numHits_, numMisses_};
+  }
+
+  void clear() {
+    entries_.wlock()->clear();
+  }
+
+ private:
+  JitCache() {
+    // Constructs the engine first so that it outlives the cached code.
+    JitEngine::instance();
+  }
+
+  // Compiled code stays alive while in use after eviction.
+  static constexpr size_t kMaxEntries = 1'000;
+
+  folly::Synchronized<std::unordered_map<
+      std::string,
+      std::shared_ptr<const exec::CompiledFilterProject>>>
+      entries_;
+  std::atomic<uint64_t> numHits_{0};
+  std::atomic<uint64_t> numMisses_{0};
+};
+
+} // namespace
+
+void registerJitFilterProject(const std::string& functionPrefix) {
+  exec::registerFilterProjectCompiler(
+      [functionPrefix](
+          const std::vector<core::TypedExprPtr>& exprs,
+          bool hasFilter,
+          const RowTypePtr& inputType) {
+        return compileJitFilterProject(
+            exprs, hasFilter, inputType, functionPrefix);
+      });
+}
+
+std::shared_ptr<const exec::CompiledFilterProject> compileJitFilterProject(
+    const std::vector<core::TypedExprPtr>& exprs,
+    bool hasFilter,
+    const RowTypePtr& inputType,
+    const std::string& functionPrefix) {
+  return JitCache::instance().getOrCompile(
+      exprs, hasFilter, inputType, functionPrefix);
+}
+
+JitCacheStats jitCacheStats() {
+  return JitCache::instance().stats();
+}
+
+void clearJitCache() {
+  JitCache::instance().clear();
+}
+
+} // namespace facebook::velox::jit
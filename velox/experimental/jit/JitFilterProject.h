@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/CompiledFilterProject.h"
+
+namespace facebook::velox::jit {
+
+/// Registers a FilterProject compiler based on the LLVM ORC JIT. The compiler
+/// generates one native loop per FilterProject that evaluates the filter and
+/// the projections row by row without intermediate vectors. Supported
+/// expressions are:
+///
+///   - Top level columns of type BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT,
+///     REAL, DOUBLE and VARCHAR.
+///   - Non-null constants of these types.
+///   - plus, minus, multiply and divide on numeric types. Integer overflow
+///     and division by zero are detected.
+///   - eq, neq, lt, lte, gt, gte and between on any of these types.
+///   - and, or and not.
+///
+/// Projections must produce fixed width types. Expressions with any other
+/// function are not compiled and FilterProject uses the interpreter.
+///
+/// The compiled code processes flat input columns without nulls. Batches with
+/// other encodings or nulls, and batches where a row raised an error, are
+/// evaluated by the interpreter.
+///
+/// 'functionPrefix' is the prefix the Presto functions were registered with.
+void registerJitFilterProject(const std::string& functionPrefix = "");
+
+/// Compiles the expressions of a FilterProject. Returns nullptr if any
+/// expression is not supported. The compiled code is cached by the
+/// expressions and the input type and is shared by all FilterProjects that
+/// evaluate the same expressions.
+std::shared_ptr<const exec::CompiledFilterProject> compileJitFilterProject(
+    const std::vector<core::TypedExprPtr>& exprs,
+    bool hasFilter,
+    const RowTypePtr& inputType,
+    const std::string& functionPrefix = "");
+
+struct JitCacheStats {
+  /// Number of cached expression lists, including the ones that are not
+  /// supported.
+  size_t numEntries{0};
+  uint64_t numHits{0};
+  uint64_t numMisses{0};
+};
+
+JitCacheStats jitCacheStats();
+
+/// Drops all entries from the cache. The compiled code is released once no
+/// FilterProject uses it.
+void clearJitCache();
+
+} // namespace facebook::velox::jit
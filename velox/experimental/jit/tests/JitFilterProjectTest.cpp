@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/jit/JitFilterProject.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::jit {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class JitFilterProjectTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    registerJitFilterProject();
+  }
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    clearJitCache();
+  }
+
+  // Runs 'plan' with and without the JIT, verifies that the results match and
+  // returns the runtime stats of 'nodeId' with the JIT.
+  std::unordered_map<std::string, RuntimeMetric> assertJit(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& nodeId) {
+    auto expected = AssertQueryBuilder(plan).copyResults(pool());
+    std::shared_ptr<exec::Task> task;
+    auto actual =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kFilterProjectJitEnabled, "true")
+            .copyResults(pool(), task);
+    assertEqualResults({expected}, {actual});
+    return exec::toPlanStats(task->taskStats()).at(nodeId).customStats;
+  }
+
+  RowVectorPtr makeInput(vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+        makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+        makeFlatVector<StringView>(
+            size,
+            [](auto row) {
+              return StringView::makeInline(
+                  fmt::format("str{}", row % 10));
+            }),
+        makeFlatVector<bool>(size, [](auto row) { return row % 3 == 0; }),
+    });
+  }
+};
+
+TEST_F(JitFilterProjectTest, filterProject) {
+  std::vector<RowVectorPtr> input = {
+      makeInput(1'000), makeInput(1'000), makeInput(100)};
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(input)
+                  .filter("(c0 * 2 > 100 AND c2 >= 'str5') OR NOT c3")
+                  .project({"c0 + 1", "c1 / 2.0", "c0 < 500", "c2"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto stats = assertJit(plan, projectId);
+  ASSERT_EQ(stats.at("jitBatches").sum, 3);
+  ASSERT_EQ(stats.count("jitFallbackBatches"), 0);
+
+  // Projections without a filter.
+  plan = PlanBuilder()
+             .values(input)
+             .project({"c0 - 7", "c1 * c1", "c1 between 10.0 and 20.0"})
+             .capturePlanNodeId(projectId)
+             .planNode();
+  stats = assertJit(plan, projectId);
+  ASSERT_EQ(stats.at("jitBatches").sum, 3);
+
+  // Filter only.
+  core::PlanNodeId filterId;
+  plan = PlanBuilder()
+             .values(input)
+             .filter("c2 = 'str3' AND c1 <> 4.5")
+             .capturePlanNodeId(filterId)
+             .planNode();
+  stats = assertJit(plan, filterId);
+  ASSERT_EQ(stats.at("jitBatches").sum, 3);
+}
+
+TEST_F(JitFilterProjectTest, fallback) {
+  // Batches with nulls are evaluated by the interpreter.
+  auto withNulls = makeRowVector({
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row; }, nullEvery(7)),
+  });
+  auto withoutNulls = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({withoutNulls, withNulls})
+                  .filter("c0 > 10")
+                  .project({"c0 * 3"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto stats = assertJit(plan, projectId);
+  ASSERT_EQ(stats.at("jitBatches").sum, 1);
+  ASSERT_EQ(stats.at("jitFallbackBatches").sum, 1);
+
+  // Overflow on a row that passes the filter is raised by the interpreter.
+  auto large = makeRowVector({
+      makeFlatVector<int64_t>(
+          {1, 2, std::numeric_limits<int64_t>::max() - 1}),
+  });
+  plan = PlanBuilder()
+             .values({large})
+             .filter("c0 > 1")
+             .project({"c0 + 10"})
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kFilterProjectJitEnabled, "true")
+          .copyResults(pool()),
+      "integer overflow");
+
+  // Rows that don't pass the filter don't raise errors.
+  plan = PlanBuilder()
+             .values({large})
+             .filter("c0 < 10")
+             .project({"c0 + 10"})
+             .capturePlanNodeId(projectId)
+             .planNode();
+  stats = assertJit(plan, projectId);
+  ASSERT_EQ(stats.at("jitBatches").sum, 1);
+
+  // Unsupported functions are not compiled.
+  plan = PlanBuilder()
+             .values({withoutNulls})
+             .filter("c0 % 2 = 0")
+             .project({"c0 * 3"})
+             .capturePlanNodeId(projectId)
+             .planNode();
+  stats = assertJit(plan, projectId);
+  ASSERT_EQ(stats.count("jitBatches"), 0);
+  ASSERT_EQ(stats.count("jitFallbackBatches"), 0);
+}
+
+TEST_F(JitFilterProjectTest, cache) {
+  auto plan = PlanBuilder()
+                  .values({makeInput(100)})
+                  .filter("c0 > 10")
+                  .project({"c1 * 2.0"})
+                  .planNode();
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kFilterProjectJitEnabled, "true")
+      .copyResults(pool());
+  auto stats = jitCacheStats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numHits, 0);
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kFilterProjectJitEnabled, "true")
+      .copyResults(pool());
+  stats = jitCacheStats();
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numHits, 1);
+
+  // Different input types compile different code.
+  plan = PlanBuilder()
+             .values({makeRowVector({makeFlatVector<int32_t>({1, 20, 30})})})
+             .filter("c0 > 10::INTEGER")
+             .planNode();
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kFilterProjectJitEnabled, "true")
+      .copyResults(pool());
+  ASSERT_EQ(jitCacheStats().numEntries, 2);
+}
+
+} // namespace
+} // namespace facebook::velox::jit
@@ -17,6 +17,7 @@
 #include "velox/expression/CastExpr.h"
 
 #include <fmt/format.h>
+#include <cstring>
 #include <stdexcept>
 
 #include "velox/common/base/Exceptions.h"
@@ -25,6 +26,7 @@
 #include "velox/expression/PrestoCastHooks.h"
 #include "velox/expression/ScopedVarSetter.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/type/Conversions.h"
 #include "velox/type/Type.h"
 #include "velox/type/tz/TimeZoneMap.h"
 #include "velox/vector/ComplexVector.h"
@@ -33,9 +35,47 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+
+// Parses a string of ASCII digits into 'out', up to 18 digits at a time.
+// Inputs of more than 38 digits, which may not fit in int128_t, go through
+// folly. Returns false on overflow.
+bool parseDigits(std::string_view digits, int128_t& out) {
+  constexpr size_t kMaxChunkDigits = 18;
+  if (digits.size() > LongDecimalType::kMaxPrecision) {
+    const auto tryValue = folly::tryTo<int128_t>(
+        folly::StringPiece(digits.data(), digits.size()));
+    if (tryValue.hasError()) {
+      return false;
+    }
+    out = tryValue.value();
+    return true;
+  }
+  int128_t value = 0;
+  for (size_t pos = 0; pos < digits.size(); pos += kMaxChunkDigits) {
+    const auto chunkSize = std::min(kMaxChunkDigits, digits.size() - pos);
+    uint64_t chunk;
+    [[maybe_unused]] const bool isDigits =
+        util::detail::tryParseDigits(digits.data() + pos, chunkSize, chunk);
+    VELOX_DCHECK(isDigits);
+    value = value * DecimalUtil::kPowersOfTen[chunkSize] + chunk;
+  }
+  out = value;
+  return true;
+}
+
+} // namespace
+
 std::string_view
 detail::extractDigits(const char* s, size_t start, size_t size) {
   size_t pos = start;
+  for (; pos + 8 <= size; pos += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, s + pos, 8);
+    if (!util::detail::isEightDigits(chunk)) {
+      break;
+    }
+  }
   for (; pos < size; ++pos) {
     if (!std::isdigit(s[pos])) {
       break;
@@ -116,13 +156,9 @@ Status detail::parseHugeInt(
     int128_t& out) {
   // Parse the whole digits.
   if (decimalComponents.wholeDigits.size() > 0) {
-    const auto tryValue = folly::tryTo<int128_t>(folly::StringPiece(
-        decimalComponents.wholeDigits.data(),
-        decimalComponents.wholeDigits.size()));
-    if (tryValue.hasError()) {
+    if (!parseDigits(decimalComponents.wholeDigits, out)) {
       return Status::UserError("Value too large.");
     }
-    out = tryValue.value();
   }
 
   // Parse the fractional digits.
@@ -133,12 +169,11 @@ Status detail::parseHugeInt(
     if (overflow) {
       return Status::UserError("Value too large.");
     }
-    const auto tryValue = folly::tryTo<int128_t>(
-        folly::StringPiece(decimalComponents.fractionalDigits.data(), length));
-    if (tryValue.hasError()) {
+    int128_t fraction;
+    if (!parseDigits(decimalComponents.fractionalDigits, fraction)) {
       return Status::UserError("Value too large.");
     }
-    overflow = __builtin_add_overflow(out, tryValue.value(), &out);
+    overflow = __builtin_add_overflow(out, fraction, &out);
     VELOX_DCHECK(!overflow);
   }
   return Status::OK();
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -357,6 +358,19 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+std::vector<TypedExprPtr> rewriteExpressionSet(
+    const std::vector<TypedExprPtr>& sources) {
+  std::vector<TypedExprPtr> rewritten = sources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto result = rewrite(rewritten);
+    if (!result.empty()) {
+      VELOX_CHECK_EQ(result.size(), rewritten.size());
+      rewritten = std::move(result);
+    }
+  }
+  return rewritten;
+}
+
 core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   for (auto& rewrite : expressionRewrites()) {
     if (auto rewritten = rewrite(expr)) {
@@ -442,15 +456,22 @@ ExprPtr compileRewrittenExpression(
           resultType,
           folly::join(", ", inputTypes));
 
-      auto func = simpleFunctionEntry->createFunction()->createVectorFunction(
-          inputTypes, getConstantInputs(compiledInputs), config);
-      result = std::make_shared<Expr>(
-          resultType,
-          std::move(compiledInputs),
-          std::move(func),
-          simpleFunctionEntry->metadata(),
-          call->name(),
-          trackCpuUsage);
+      if (config.exprFuseArithmetic()) {
+        result = tryFuseArithmetic(
+            resultType, call->name(), compiledInputs, trackCpuUsage);
+      }
+      if (!result) {
+        auto func =
+            simpleFunctionEntry->createFunction()->createVectorFunction(
+                inputTypes, getConstantInputs(compiledInputs), config);
+        result = std::make_shared<Expr>(
+            resultType,
+            std::move(compiledInputs),
+            std::move(func),
+            simpleFunctionEntry->metadata(),
+            call->name(),
+            trackCpuUsage);
+      }
     } else {
       const auto& functionName = call->name();
       auto vectorFunctionSignatures = getVectorFunctionSignatures(functionName);
@@ -595,11 +616,15 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  // Keeps the rewritten expressions alive while compiling. 'scope' refers to
+  // them by raw pointers.
+  const auto rewrittenSources = rewriteExpressionSet(sources);
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedArithmeticExpr.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/expression/EvalCtx.h"
+#include "velox/expression/FunctionSignature.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+using FusedArithmeticOpMap =
+    folly::Synchronized<std::unordered_map<std::string, FusedArithmeticOp>>;
+
+FusedArithmeticOpMap& fusedArithmeticOps() {
+  static FusedArithmeticOpMap ops;
+  return ops;
+}
+
+// 'out' may be the same tile as 'a' or 'b'. Each row is read before it is
+// written, so the loops stay correct and can still be vectorized.
+template <typename T>
+void applyOp(
+    FusedArithmeticOp op,
+    const T* a,
+    const T* b,
+    T* out,
+    int32_t size)
+// Division by zero produces +/-Infinity or NaN like DivideFunction does.
+#if defined(__has_feature)
+#if __has_feature(__address_sanitizer__)
+    __attribute__((__no_sanitize__("float-divide-by-zero")))
+#endif
+#endif
+{
+  switch (op) {
+    case FusedArithmeticOp::kPlus:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] + b[i];
+      }
+      break;
+    case FusedArithmeticOp::kMinus:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] - b[i];
+      }
+      break;
+    case FusedArithmeticOp::kMultiply:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] * b[i];
+      }
+      break;
+    case FusedArithmeticOp::kDivide:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] / b[i];
+      }
+      break;
+  }
+}
+
+// Evaluates a FusedArithmeticExpr program over flat, constant or otherwise
+// encoded leaf inputs. The rows are processed in tiles of kTileSize. Each
+// step of the program runs over a whole tile before the next step starts,
+// which keeps the inner loops free of branches and lets the compiler
+// vectorize them.
+class FusedArithmeticFunction : public VectorFunction {
+ public:
+  explicit FusedArithmeticFunction(
+      std::vector<FusedArithmeticExpr::Step> program)
+      : program_(std::move(program)) {
+    int32_t depth = 0;
+    for (const auto& step : program_) {
+      depth += step.isInput ? 1 : -1;
+      VELOX_CHECK_GT(depth, 0);
+      maxDepth_ = std::max(maxDepth_, depth);
+    }
+    VELOX_CHECK_EQ(depth, 1);
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      EvalCtx& context,
+      VectorPtr& result) const override {
+    if (outputType->kind() == TypeKind::REAL) {
+      applyTyped<float>(rows, args, outputType, context, result);
+    } else {
+      VELOX_CHECK_EQ(outputType->kind(), TypeKind::DOUBLE);
+      applyTyped<double>(rows, args, outputType, context, result);
+    }
+  }
+
+  bool supportsFlatNoNullsFastPath() const override {
+    return true;
+  }
+
+ private:
+  static constexpr int32_t kTileSize = FusedArithmeticExpr::kTileSize;
+
+  template <typename T>
+  void applyTyped(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      EvalCtx& context,
+      VectorPtr& result) const {
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asUnchecked<FlatVector<T>>();
+    flatResult->clearNulls(rows);
+    T* rawResult = flatResult->mutableRawValues();
+
+    const auto numArgs = args.size();
+    const bool allSelected = rows.isAllSelected();
+
+    // Registers hold the intermediate results of a tile, followed by one
+    // tile sized buffer per leaf that is not flat.
+    std::vector<T> buffers((maxDepth_ + numArgs) * kTileSize);
+    auto argBuffer = [&](auto i) {
+      return buffers.data() + (maxDepth_ + i) * kTileSize;
+    };
+
+    // Leaves that are flat are read in place. Constant leaves are broadcast
+    // once. Leaves with other encodings are gathered tile by tile.
+    std::vector<const T*> flatArgs(numArgs, nullptr);
+    std::vector<DecodedVector*> decodedArgs(numArgs, nullptr);
+    std::vector<LocalDecodedVector> decodedHolders;
+    decodedHolders.reserve(numArgs);
+    for (auto i = 0; i < numArgs; ++i) {
+      const auto& arg = args[i];
+      if (arg->isFlatEncoding()) {
+        flatArgs[i] = arg->asUnchecked<FlatVector<T>>()->rawValues();
+      } else if (arg->isConstantEncoding()) {
+        const T value =
+            arg->isNullAt(0) ? T() : arg->as<SimpleVector<T>>()->valueAt(0);
+        std::fill(argBuffer(i), argBuffer(i) + kTileSize, value);
+      } else {
+        decodedHolders.emplace_back(context, *arg, rows);
+        decodedArgs[i] = decodedHolders.back().get();
+      }
+    }
+
+    std::vector<const T*> stack;
+    stack.reserve(maxDepth_);
+    for (auto begin = rows.begin(); begin < rows.end(); begin += kTileSize) {
+      const auto size = std::min(kTileSize, rows.end() - begin);
+      for (auto i = 0; i < numArgs; ++i) {
+        if (decodedArgs[i] == nullptr) {
+          continue;
+        }
+        T* buffer = argBuffer(i);
+        for (auto j = 0; j < size; ++j) {
+          // Unselected rows may point outside of the base vector.
+          buffer[j] = allSelected || rows.isValid(begin + j)
+              ? decodedArgs[i]->valueAt<T>(begin + j)
+              : T();
+        }
+      }
+
+      stack.clear();
+      for (auto s = 0; s < program_.size(); ++s) {
+        const auto& step = program_[s];
+        if (step.isInput) {
+          stack.push_back(
+              flatArgs[step.input] != nullptr
+                  ? flatArgs[step.input] + begin
+                  : argBuffer(step.input));
+          continue;
+        }
+        const T* right = stack.back();
+        stack.pop_back();
+        const T* left = stack.back();
+        stack.pop_back();
+        // The last step writes directly into the result when no rows in
+        // between need to be preserved.
+        T* out = allSelected && s == program_.size() - 1
+            ? rawResult + begin
+            : buffers.data() + stack.size() * kTileSize;
+        applyOp(step.op, left, right, out, size);
+        stack.push_back(out);
+      }
+
+      if (!allSelected) {
+        const T* tileResult = stack.back();
+        for (auto j = 0; j < size; ++j) {
+          if (rows.isValid(begin + j)) {
+            rawResult[begin + j] = tileResult[j];
+          }
+        }
+      }
+    }
+  }
+
+  const std::vector<FusedArithmeticExpr::Step> program_;
+  int32_t maxDepth_{0};
+};
+
+// Returns true if 'expr' is a call to a fusable operation on 'kind'.
+bool isFusableCall(const ExprPtr& expr, TypeKind kind) {
+  if (expr->is<FusedArithmeticExpr>()) {
+    return expr->type()->kind() == kind;
+  }
+  if (expr->isSpecialForm() || expr->vectorFunction() == nullptr ||
+      !expr->isDeterministic() ||
+      !expr->vectorFunctionMetadata().defaultNullBehavior ||
+      expr->inputs().size() != 2 || expr->type()->kind() != kind ||
+      !fusedArithmeticOp(expr->name()).has_value()) {
+    return false;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (input->type()->kind() != kind) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends the program of 'expr' to 'program' and its leaves to 'leaves'.
+void appendFused(
+    const ExprPtr& expr,
+    std::vector<FusedArithmeticExpr::Step>& program,
+    std::vector<ExprPtr>& leaves) {
+  if (auto* fused = expr->as<FusedArithmeticExpr>()) {
+    const int32_t offset = leaves.size();
+    for (auto step : fused->program()) {
+      if (step.isInput) {
+        step.input += offset;
+      }
+      program.push_back(std::move(step));
+    }
+    leaves.insert(leaves.end(), fused->inputs().begin(), fused->inputs().end());
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    program.push_back({true, static_cast<int32_t>(leaves.size()), {}, {}});
+    leaves.push_back(input);
+  }
+  program.push_back(
+      {false, 0, fusedArithmeticOp(expr->name()).value(), expr->name()});
+}
+
+// Formats the program as a tree of calls using 'formatLeaf' for the leaves.
+template <typename TFormatLeaf, typename TFormatName>
+std::string formatProgram(
+    const std::vector<FusedArithmeticExpr::Step>& program,
+    TFormatLeaf formatLeaf,
+    TFormatName formatName) {
+  std::vector<std::string> stack;
+  for (const auto& step : program) {
+    if (step.isInput) {
+      stack.push_back(formatLeaf(step.input));
+      continue;
+    }
+    auto right = std::move(stack.back());
+    stack.pop_back();
+    auto& left = stack.back();
+    left = fmt::format("{}({}, {})", formatName(step.name), left, right);
+  }
+  VELOX_CHECK_EQ(stack.size(), 1);
+  return stack.back();
+}
+
+} // namespace
+
+void registerFusedArithmeticOp(const std::string& name, FusedArithmeticOp op) {
+  const auto sanitizedName = sanitizeName(name);
+  fusedArithmeticOps().withWLock([&](auto& map) { map[sanitizedName] = op; });
+}
+
+std::optional<FusedArithmeticOp> fusedArithmeticOp(const std::string& name) {
+  const auto sanitizedName = sanitizeName(name);
+  return fusedArithmeticOps().withRLock(
+      [&](const auto& map) -> std::optional<FusedArithmeticOp> {
+        auto it = map.find(sanitizedName);
+        if (it == map.end()) {
+          return std::nullopt;
+        }
+        return it->second;
+      });
+}
+
+void unregisterAllFusedArithmeticOps() {
+  fusedArithmeticOps().withWLock([](auto& map) { map.clear(); });
+}
+
+FusedArithmeticExpr::FusedArithmeticExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    std::vector<Step> program,
+    bool trackCpuUsage)
+    : Expr(
+          std::move(type),
+          std::move(inputs),
+          std::make_shared<FusedArithmeticFunction>(program),
+          VectorFunctionMetadata{},
+          program.back().name,
+          trackCpuUsage),
+      program_(std::move(program)) {}
+
+std::string FusedArithmeticExpr::toString(bool recursive) const {
+  if (!recursive) {
+    return name();
+  }
+  return formatProgram(
+      program_,
+      [&](auto input) { return inputs()[input]->toString(); },
+      [](const auto& name) { return name; });
+}
+
+std::string FusedArithmeticExpr::toSql(
+    std::vector<VectorPtr>* complexConstants) const {
+  return formatProgram(
+      program_,
+      [&](auto input) { return inputs()[input]->toSql(complexConstants); },
+      [](const auto& name) { return fmt::format("\"{}\"", name); });
+}
+
+ExprPtr tryFuseArithmetic(
+    const TypePtr& type,
+    const std::string& name,
+    const std::vector<ExprPtr>& inputs,
+    bool trackCpuUsage) {
+  const auto op = fusedArithmeticOp(name);
+  if (!op.has_value() || inputs.size() != 2) {
+    return nullptr;
+  }
+  const auto kind = type->kind();
+  if (kind != TypeKind::REAL && kind != TypeKind::DOUBLE) {
+    return nullptr;
+  }
+
+  bool hasFusableInput = false;
+  for (const auto& input : inputs) {
+    if (input->type()->kind() != kind) {
+      return nullptr;
+    }
+    // Shared subexpressions are computed once and not fused.
+    hasFusableInput |=
+        !input->isMultiplyReferenced() && isFusableCall(input, kind);
+  }
+  if (!hasFusableInput) {
+    return nullptr;
+  }
+
+  std::vector<Step> program;
+  std::vector<ExprPtr> leaves;
+  for (const auto& input : inputs) {
+    if (!input->isMultiplyReferenced() && isFusableCall(input, kind)) {
+      appendFused(input, program, leaves);
+    } else {
+      program.push_back({true, static_cast<int32_t>(leaves.size()), {}, {}});
+      leaves.push_back(input);
+    }
+  }
+  program.push_back({false, 0, op.value(), name});
+  return std::make_shared<FusedArithmeticExpr>(
+      type, std::move(leaves), std::move(program), trackCpuUsage);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// Floating point operations that can be evaluated by a FusedArithmeticExpr.
+enum class FusedArithmeticOp : uint8_t {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+};
+
+/// Declares that the function 'name' computes 'op' on REAL and DOUBLE
+/// arguments. The function must be deterministic, propagate nulls and return
+/// exactly the result of the C++ operator, e.g. plus(a, b) is a + b. Such
+/// calls may be fused into a single FusedArithmeticExpr by ExprCompiler.
+void registerFusedArithmeticOp(const std::string& name, FusedArithmeticOp op);
+
+/// Returns the fusable operation registered for 'name', if any.
+std::optional<FusedArithmeticOp> fusedArithmeticOp(const std::string& name);
+
+/// Removes all fusable operations. Used in tests.
+void unregisterAllFusedArithmeticOps();
+
+/// A tree of fusable floating point calls, e.g. (a * 2 + b) / c - d, evaluated
+/// in one pass over the rows. The leaves of the tree are the inputs of the
+/// expression and are evaluated as usual. The calls are evaluated by
+/// FusedArithmeticExpr in tiles of kTileSize rows: the intermediate results
+/// of a tile stay in a few cache resident buffers and only the final result
+/// is written to a vector. The unfused tree would materialize one vector per
+/// call.
+class FusedArithmeticExpr : public Expr {
+ public:
+  /// One step of the fused program in postfix order. A step either pushes
+  /// the leaf input 'input' or pops two operands and pushes 'op' applied to
+  /// them.
+  struct Step {
+    bool isInput;
+    int32_t input;
+    FusedArithmeticOp op;
+
+    /// Name of the call for non-input steps. Used in toString() and toSql().
+    std::string name;
+  };
+
+  static constexpr int32_t kTileSize = 256;
+
+  FusedArithmeticExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      std::vector<Step> program,
+      bool trackCpuUsage);
+
+  const std::vector<Step>& program() const {
+    return program_;
+  }
+
+  /// Prints the original tree of calls, e.g. minus(plus(a, b), c).
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+ private:
+  const std::vector<Step> program_;
+};
+
+/// Returns a FusedArithmeticExpr for the call 'name' with 'inputs' when the
+/// call is a fusable operation and at least one of 'inputs' is a fusable call
+/// itself. Returns nullptr otherwise. Fusable inputs are absorbed into the
+/// returned expression and their inputs become its leaves.
+ExprPtr tryFuseArithmetic(
+    const TypePtr& type,
+    const std::string& name,
+    const std::vector<ExprPtr>& inputs,
+    bool trackCpuUsage);
+
+} // namespace facebook::velox::exec
@@ -117,12 +117,16 @@ class ExprCallable : public Callable {
       vector_size_t size) {
     VELOX_CHECK_EQ(signature_->size(), args.size());
     std::vector<VectorPtr> allVectors = args;
+    // Indices of dictionary captures composed with 'wrapCapture', keyed on the
+    // indices of the capture. Captures wrapped by the same enclosing lambda
+    // share their indices and therefore the composed indices.
+    std::vector<std::pair<const Buffer*, BufferPtr>> composedIndices;
     for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
       auto values = capture_->childAt(index);
       VELOX_DCHECK(!isLazyNotLoaded(*values));
       if (wrapCapture) {
-        values = BaseVector::wrapInDictionary(
-            BufferPtr(nullptr), wrapCapture, size, values);
+        values = wrapCaptureValues(
+            context, wrapCapture, size, values, composedIndices);
       }
       allVectors.push_back(values);
     }
@@ -136,6 +140,45 @@ class ExprCallable : public Callable {
     return row;
   }
 
+  // Aligns 'values' with the rows of the lambda body. A capture of a nested
+  // lambda is usually a dictionary created by the enclosing lambda. Rather
+  // than adding one more dictionary layer per level of nesting, which every
+  // reference to the capture in the body would have to decode, compose the
+  // indices so that the capture is a single dictionary over its base.
+  static VectorPtr wrapCaptureValues(
+      EvalCtx* context,
+      const BufferPtr& wrapCapture,
+      vector_size_t size,
+      const VectorPtr& values,
+      std::vector<std::pair<const Buffer*, BufferPtr>>& composedIndices) {
+    if (values->encoding() != VectorEncoding::Simple::DICTIONARY ||
+        values->rawNulls() != nullptr) {
+      return BaseVector::wrapInDictionary(
+          BufferPtr(nullptr), wrapCapture, size, values);
+    }
+
+    const auto innerIndices = values->wrapInfo();
+    BufferPtr indices;
+    for (const auto& [key, composed] : composedIndices) {
+      if (key == innerIndices.get()) {
+        indices = composed;
+        break;
+      }
+    }
+    if (!indices) {
+      indices = allocateIndices(size, context->pool());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      const auto* rawWrap = wrapCapture->as<vector_size_t>();
+      const auto* rawInner = innerIndices->as<vector_size_t>();
+      for (auto i = 0; i < size; ++i) {
+        rawIndices[i] = rawInner[rawWrap[i]];
+      }
+      composedIndices.emplace_back(innerIndices.get(), indices);
+    }
+    return BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), std::move(indices), size, values->valueVector());
+  }
+
   RowTypePtr signature_;
   RowVectorPtr capture_;
   std::shared_ptr<Expr> body_;
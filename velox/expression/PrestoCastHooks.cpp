@@ -21,6 +21,7 @@
 
 #include "velox/expression/PrestoCastHooks.h"
 #include "velox/functions/lib/string/StringImpl.h"
+#include "velox/type/Conversions.h"
 #include "velox/type/TimestampConversion.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
@@ -78,6 +79,46 @@ namespace {
 
 using double_conversion::StringToDoubleConverter;
 
+// Fast path for strings of the form [-]digits[.digits] with at most
+// kMaxDigits digits. Both the digits, read as an integer, and the power of ten
+// of the fractional part are then exactly representable in T, so a single
+// division is correctly rounded and matches StringToDoubleConverter. Returns
+// false for all other inputs.
+template <typename T>
+bool tryParseSimpleFloatingPoint(const char* data, size_t size, T& out) {
+  constexpr size_t kMaxDigits = std::is_same_v<T, float> ? 7 : 15;
+  static constexpr T kPowersOfTen[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+      1e14, 1e15};
+
+  const bool negative = size > 0 && data[0] == '-';
+  const char* begin = data + negative;
+  const char* end = data + size;
+  const char* dot = std::find(begin, end, '.');
+  const size_t wholeSize = dot - begin;
+  const size_t fractionSize = dot == end ? 0 : end - dot - 1;
+  if (wholeSize == 0 || (dot != end && fractionSize == 0) ||
+      wholeSize + fractionSize > kMaxDigits) {
+    return false;
+  }
+
+  uint64_t whole;
+  uint64_t fraction = 0;
+  if (!util::detail::tryParseDigits(begin, wholeSize, whole) ||
+      (fractionSize > 0 &&
+       !util::detail::tryParseDigits(dot + 1, fractionSize, fraction))) {
+    return false;
+  }
+  uint64_t scale = 1;
+  for (size_t i = 0; i < fractionSize; ++i) {
+    scale *= 10;
+  }
+  const T mantissa = static_cast<T>(whole * scale + fraction);
+  const T value = mantissa / kPowersOfTen[fractionSize];
+  out = negative ? -value : value;
+  return true;
+}
+
 template <typename T>
 Expected<T> doCastToFloatingPoint(const StringView& data) {
   static const T kNan = std::numeric_limits<T>::quiet_NaN();
@@ -97,6 +138,9 @@ Expected<T> doCastToFloatingPoint(const StringView& data) {
     // 'data' only contains white spaces.
     return folly::makeUnexpected(Status::UserError());
   }
+  if (tryParseSimpleFloatingPoint(begin, length, result)) {
+    return result;
+  }
   if constexpr (std::is_same_v<T, float>) {
     result = stringToDoubleConverter.StringToFloat(
         begin, length, &processedCharactersCount);
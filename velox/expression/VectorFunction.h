@@ -290,6 +290,22 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions compiled together into an
+/// ExprSet and returns equivalent expressions or an empty vector if re-write is
+/// not possible. Unlike ExpressionRewrite, it can rewrite related calls in
+/// different expressions, e.g. to share work between them via common
+/// subexpression elimination.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. Expression set re-writes
+/// are applied in the order they were registered, each to the result of the
+/// previous one, before the per-expression re-writes.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -1139,6 +1139,73 @@ TEST_F(CastExprTest, primitiveValidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, varcharToNumberFastPath) {
+  // Plain decimal strings are parsed 8 digits at a time. Results must match
+  // the general parsers at and beyond the limits of the fast paths.
+  testCast(
+      makeFlatVector<StringView>(
+          {"0",
+           "-12345678",
+           "123456789012345678",
+           "-123456789012345678",
+           "9223372036854775807",
+           "-9223372036854775808",
+           "0000000000000000000042",
+           "+12345678"}),
+      makeFlatVector<int64_t>(
+          {0,
+           -12345678,
+           123456789012345678,
+           -123456789012345678,
+           std::numeric_limits<int64_t>::max(),
+           std::numeric_limits<int64_t>::min(),
+           42,
+           12345678}));
+  testCast(
+      makeFlatVector<StringView>(
+          {"0",
+           "-0",
+           "0.1",
+           "-1.5",
+           "123456789012.345",
+           "999999999999999",
+           "1234567890123456789",
+           "0.000000000000001",
+           "1.2345678901234567",
+           "1.",
+           "1e3",
+           "2.5 "}),
+      makeFlatVector<double>(
+          {0.0,
+           -0.0,
+           0.1,
+           -1.5,
+           123456789012.345,
+           999999999999999.0,
+           1234567890123456789.0,
+           0.000000000000001,
+           1.2345678901234567,
+           1.0,
+           1000.0,
+           2.5}));
+  testCast(
+      makeFlatVector<StringView>(
+          {"0.3", "-7.654321", "9999999", "16777217", "0.12345678"}),
+      makeFlatVector<float>(
+          {0.3f, -7.654321f, 9999999.0f, 16777217.0f, 0.12345678f}));
+
+  testInvalidCast<std::string>(
+      "bigint", {"9223372036854775808"}, "Overflow during conversion");
+  testInvalidCast<std::string>(
+      "tinyint", {"128"}, "Overflow during conversion");
+  testInvalidCast<std::string>(
+      "bigint",
+      {"12345678a"},
+      "Non-whitespace character found after end of conversion");
+  testInvalidCast<std::string>(
+      "double", {"1234567.8x"}, "Cannot cast VARCHAR '1234567.8x' to DOUBLE");
+}
+
 TEST_F(CastExprTest, truncateVsRound) {
   // Testing round cast from double to int.
   testCast<double, int>(
@@ -17,6 +17,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 #include "velox/parse/Expressions.h"
@@ -102,6 +103,16 @@ class ExprCompilerTest : public testing::Test,
         std::vector<core::TypedExprPtr>{expr}, execCtx_.get());
   }
 
+  VectorPtr evaluate(
+      ExprSet& exprSet,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) {
+    EvalCtx context(execCtx_.get(), &exprSet, input.get());
+    std::vector<VectorPtr> results(1);
+    exprSet.eval(rows, context, results);
+    return results[0];
+  }
+
   std::shared_ptr<core::QueryCtx> queryCtx_{velox::core::QueryCtx::create()};
   std::unique_ptr<core::ExecCtx> execCtx_{
       std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get())};
@@ -355,4 +366,80 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
   ASSERT_EQ(distinctFields.size(), 2);
 }
 
+TEST_F(ExprCompilerTest, fuseArithmetic) {
+  auto rowType = ROW(
+      {"a", "b", "c", "d", "e"},
+      {DOUBLE(), DOUBLE(), DOUBLE(), DOUBLE(), BIGINT()});
+  const std::string text = "(a * 2.0 + b) / c - d";
+
+  // Fusion is disabled by default.
+  auto exprSet = compile(makeTypedExpr(text, rowType));
+  ASSERT_FALSE(exprSet->expr(0)->is<FusedArithmeticExpr>());
+
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprFuseArithmetic, "true"},
+  });
+  auto fusedExprSet = compile(makeTypedExpr(text, rowType));
+  auto* fused = fusedExprSet->expr(0)->as<FusedArithmeticExpr>();
+  ASSERT_NE(fused, nullptr);
+  ASSERT_EQ(fused->inputs().size(), 5);
+  ASSERT_EQ(fused->program().size(), 9);
+  ASSERT_EQ(exprSet->toString(), fusedExprSet->toString());
+
+  // A single call and integer arithmetic are not fused.
+  ASSERT_FALSE(compile(makeTypedExpr("a * b", rowType))
+                   ->expr(0)
+                   ->is<FusedArithmeticExpr>());
+  ASSERT_FALSE(compile(makeTypedExpr("e * 2 + e", rowType))
+                   ->expr(0)
+                   ->is<FusedArithmeticExpr>());
+
+  // Spans several tiles and mixes flat, flat with nulls, dictionary and
+  // constant inputs.
+  const vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(
+          size, [](auto row) { return row % 7; }, nullEvery(11)),
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<double>(size, [](auto row) { return row % 5 + 1; })),
+      makeConstant(1.5, size),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  SelectivityVector allRows(size);
+  assertEqualVectors(
+      evaluate(*exprSet, input, allRows),
+      evaluate(*fusedExprSet, input, allRows));
+
+  SelectivityVector someRows(size);
+  for (auto i = 0; i < size; i += 3) {
+    someRows.setValid(i, false);
+  }
+  someRows.updateBounds();
+  assertEqualVectors(
+      evaluate(*exprSet, input, someRows),
+      evaluate(*fusedExprSet, input, someRows),
+      someRows);
+
+  // REAL arithmetic. Powers of two keep the results exact.
+  rowType = ROW({"a", "b"}, {REAL(), REAL()});
+  fusedExprSet = compile(makeTypedExpr("a * b - a / b", rowType));
+  ASSERT_TRUE(fusedExprSet->expr(0)->is<FusedArithmeticExpr>());
+  input = makeRowVector({
+      makeFlatVector<float>(size, [](auto row) { return row * 0.25; }),
+      makeFlatVector<float>(size, [](auto row) { return 1 << (row % 3); }),
+  });
+  assertEqualVectors(
+      makeFlatVector<float>(
+          size,
+          [](auto row) {
+            const float a = row * 0.25;
+            const float b = 1 << (row % 3);
+            return a * b - a / b;
+          }),
+      evaluate(*fusedExprSet, input, allRows));
+}
+
 } // namespace facebook::velox::exec::test
@@ -0,0 +1,751 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/MultiPatternMatcher.h"
+
+#include <deque>
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/functions/lib/Re2Functions.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::functions {
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& keywords) {
+  failure_.push_back(0);
+  keyword_.push_back(-1);
+  outputLink_.push_back(-1);
+
+  // Children of each state, used to visit the trie in breadth-first order.
+  std::vector<std::vector<std::pair<uint8_t, int32_t>>> children(1);
+
+  for (auto i = 0; i < keywords.size(); ++i) {
+    VELOX_CHECK(!keywords[i].empty(), "Keywords must not be empty");
+    int32_t state = 0;
+    for (auto c : keywords[i]) {
+      const auto byte = static_cast<uint8_t>(c);
+      int32_t child;
+      if (state == 0) {
+        child = rootTransitions_[byte];
+      } else {
+        auto it = transitions_.find(transitionKey(state, byte));
+        child = it == transitions_.end() ? 0 : it->second;
+      }
+      if (child == 0) {
+        child = failure_.size();
+        failure_.push_back(0);
+        keyword_.push_back(-1);
+        outputLink_.push_back(-1);
+        children.emplace_back();
+        children[state].emplace_back(byte, child);
+        if (state == 0) {
+          rootTransitions_[byte] = child;
+        } else {
+          transitions_[transitionKey(state, byte)] = child;
+        }
+      }
+      state = child;
+    }
+    VELOX_CHECK_EQ(keyword_[state], -1, "Duplicate keyword: {}", keywords[i]);
+    keyword_[state] = i;
+  }
+
+  // The failure link of a state is the longest proper suffix of its string
+  // that is also in the trie. Computing it in breadth-first order guarantees
+  // that the failure links of all shorter strings are already known.
+  std::deque<int32_t> queue;
+  for (auto [byte, child] : children[0]) {
+    queue.push_back(child);
+  }
+  while (!queue.empty()) {
+    const auto state = queue.front();
+    queue.pop_front();
+    for (auto [byte, child] : children[state]) {
+      const auto failure = next(failure_[state], byte);
+      failure_[child] = failure;
+      outputLink_[child] =
+          keyword_[failure] >= 0 ? failure : outputLink_[failure];
+      queue.push_back(child);
+    }
+  }
+}
+
+namespace {
+
+std::unique_ptr<RE2> compileRegex(const std::string& regex) {
+  auto re = std::make_unique<RE2>(regex, RE2::Quiet);
+  VELOX_USER_CHECK(
+      re->ok(), "Invalid regular expression {}: {}.", regex, re->error());
+  return re;
+}
+
+re2::StringPiece toStringPiece(StringView input) {
+  return re2::StringPiece(input.data(), input.size());
+}
+
+} // namespace
+
+MultiPatternMatcher::MultiPatternMatcher(
+    const std::vector<Pattern>& patterns) {
+  std::vector<std::string> keywords;
+  folly::F14FastMap<std::string, int32_t> keywordIndices;
+  std::vector<std::string> unfilteredRegexes;
+
+  for (const auto& pattern : patterns) {
+    std::string regex;
+    std::string literal;
+    auto verify = Verify::kRe2;
+    if (pattern.isLike) {
+      bool validPattern;
+      // LIKE wildcards match any character including new lines.
+      regex = "(?s)" +
+          likePatternToRe2(
+                  StringView(pattern.pattern),
+                  pattern.escapeChar,
+                  validPattern);
+      VELOX_USER_CHECK(
+          validPattern,
+          "Escape character must be followed by '%', '_' or the escape character itself");
+
+      const auto metadata =
+          determinePatternKind(pattern.pattern, pattern.escapeChar);
+      switch (metadata.patternKind()) {
+        case PatternKind::kFixed:
+          verify = Verify::kFixed;
+          literal = metadata.fixedPattern();
+          break;
+        case PatternKind::kPrefix:
+          verify = Verify::kPrefix;
+          literal = metadata.fixedPattern();
+          break;
+        case PatternKind::kSuffix:
+          verify = Verify::kSuffix;
+          literal = metadata.fixedPattern();
+          break;
+        case PatternKind::kSubstring:
+          verify = Verify::kNone;
+          literal = metadata.fixedPattern();
+          break;
+        default:
+          literal =
+              detail::requiredLikeLiteral(pattern.pattern, pattern.escapeChar);
+      }
+    } else {
+      regex = pattern.pattern;
+      literal = detail::requiredRegexLiteral(regex);
+    }
+
+    if (literal.empty()) {
+      unfiltered_.push_back(compileRegex(regex));
+      unfilteredRegexes.push_back(std::move(regex));
+      continue;
+    }
+
+    auto [it, inserted] = keywordIndices.emplace(literal, keywords.size());
+    if (inserted) {
+      keywords.push_back(literal);
+      keywordPatterns_.emplace_back();
+    }
+    keywordPatterns_[it->second].push_back(filtered_.size());
+    filtered_.push_back(
+        {verify,
+         std::move(literal),
+         verify == Verify::kRe2 ? compileRegex(regex) : nullptr});
+  }
+
+  if (!keywords.empty()) {
+    automaton_.emplace(keywords);
+  }
+
+  if (!unfilteredRegexes.empty()) {
+    unfilteredSet_ =
+        std::make_unique<RE2::Set>(RE2::Options(RE2::Quiet), RE2::UNANCHORED);
+    for (const auto& regex : unfilteredRegexes) {
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          unfilteredSet_->Add(regex, &error),
+          0,
+          "Invalid regular expression {}: {}.",
+          regex,
+          error);
+    }
+    VELOX_CHECK(
+        unfilteredSet_->Compile(), "Failed to compile the set of patterns");
+  }
+}
+
+bool MultiPatternMatcher::verify(
+    const FilteredPattern& pattern,
+    StringView input) const {
+  const auto& literal = pattern.literal;
+  switch (pattern.verify) {
+    case Verify::kNone:
+      return true;
+    case Verify::kFixed:
+      // The literal occurs in the input, so they are equal if their sizes are.
+      return input.size() == literal.size();
+    case Verify::kPrefix:
+      return input.size() >= literal.size() &&
+          std::memcmp(input.data(), literal.data(), literal.size()) == 0;
+    case Verify::kSuffix:
+      return input.size() >= literal.size() &&
+          std::memcmp(
+              input.data() + input.size() - literal.size(),
+              literal.data(),
+              literal.size()) == 0;
+    case Verify::kRe2:
+      return RE2::PartialMatch(toStringPiece(input), *pattern.re);
+  }
+  VELOX_UNREACHABLE();
+}
+
+bool MultiPatternMatcher::matchUnfiltered(StringView input) const {
+  RE2::Set::ErrorInfo error;
+  if (unfilteredSet_->Match(toStringPiece(input), nullptr, &error)) {
+    return true;
+  }
+  if (error.kind == RE2::Set::kNoError) {
+    return false;
+  }
+  // The DFA of the set ran out of memory. Evaluate the patterns one by one.
+  for (const auto& re : unfiltered_) {
+    if (RE2::PartialMatch(toStringPiece(input), *re)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MultiPatternMatcher::match(StringView input, Scratch& scratch) const {
+  if (automaton_.has_value()) {
+    if (scratch.verified.size() < filtered_.size()) {
+      scratch.verified.resize(filtered_.size(), 0);
+    }
+    if (++scratch.epoch == 0) {
+      std::fill(scratch.verified.begin(), scratch.verified.end(), 0);
+      scratch.epoch = 1;
+    }
+    const auto epoch = scratch.epoch;
+    const bool matched = automaton_->search(
+        std::string_view(input.data(), input.size()), [&](int32_t keyword) {
+          for (auto index : keywordPatterns_[keyword]) {
+            if (scratch.verified[index] == epoch) {
+              continue;
+            }
+            scratch.verified[index] = epoch;
+            if (verify(filtered_[index], input)) {
+              return true;
+            }
+          }
+          return false;
+        });
+    if (matched) {
+      return true;
+    }
+  }
+  return unfilteredSet_ != nullptr && matchUnfiltered(input);
+}
+
+namespace {
+
+class LikeAny final : public exec::VectorFunction {
+ public:
+  explicit LikeAny(const std::vector<MultiPatternMatcher::Pattern>& patterns)
+      : matcher_(patterns) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_EQ(args.size(), 4);
+    context.ensureWritable(rows, BOOLEAN(), resultRef);
+    auto* result = resultRef->as<FlatVector<bool>>();
+
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* toSearch = decodedArgs.at(0);
+    MultiPatternMatcher::Scratch scratch;
+    if (toSearch->isConstantMapping()) {
+      const bool match =
+          matcher_.match(toSearch->valueAt<StringView>(0), scratch);
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t row) { result->set(row, match); });
+      return;
+    }
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      result->set(
+          row, matcher_.match(toSearch->valueAt<StringView>(row), scratch));
+    });
+  }
+
+ private:
+  const MultiPatternMatcher matcher_;
+};
+
+std::vector<std::string> constantStrings(
+    const std::string& name,
+    const exec::VectorFunctionArg& arg) {
+  VELOX_USER_CHECK(
+      arg.constantValue != nullptr && !arg.constantValue->isNullAt(0),
+      "{} requires constant non-null pattern arrays",
+      name);
+  const auto* array = arg.constantValue->wrappedVector()->as<ArrayVector>();
+  const auto index = arg.constantValue->wrappedIndex(0);
+  const auto offset = array->offsetAt(index);
+  const auto size = array->sizeAt(index);
+  const auto* elements = array->elements()->as<SimpleVector<StringView>>();
+
+  std::vector<std::string> strings;
+  strings.reserve(size);
+  for (auto i = offset; i < offset + size; ++i) {
+    VELOX_USER_CHECK(
+        !elements->isNullAt(i), "{} patterns must not be null", name);
+    strings.emplace_back(elements->valueAt(i));
+  }
+  return strings;
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 4, "{} requires 4 arguments", name);
+  const auto likePatterns = constantStrings(name, inputArgs[1]);
+  const auto likeEscapes = constantStrings(name, inputArgs[2]);
+  const auto regexps = constantStrings(name, inputArgs[3]);
+  VELOX_USER_CHECK_EQ(
+      likePatterns.size(),
+      likeEscapes.size(),
+      "{} requires an escape for each LIKE pattern",
+      name);
+
+  std::vector<MultiPatternMatcher::Pattern> patterns;
+  patterns.reserve(likePatterns.size() + regexps.size());
+  for (auto i = 0; i < likePatterns.size(); ++i) {
+    std::optional<char> escapeChar;
+    if (!likeEscapes[i].empty()) {
+      VELOX_USER_CHECK_EQ(
+          likeEscapes[i].size(), 1, "Escape string must be a single character");
+      escapeChar = likeEscapes[i][0];
+    }
+    patterns.push_back({likePatterns[i], true, escapeChar});
+  }
+  for (const auto& regexp : regexps) {
+    patterns.push_back({regexp, false, std::nullopt});
+  }
+  return std::make_shared<LikeAny>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures() {
+  // varchar, array(varchar), array(varchar), array(varchar) -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("array(varchar)")
+              .constantArgumentType("array(varchar)")
+              .constantArgumentType("array(varchar)")
+              .build()};
+}
+
+namespace {
+
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->hasValueVector() || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+struct PatternCall {
+  core::TypedExprPtr input;
+  MultiPatternMatcher::Pattern pattern;
+};
+
+// Returns the column and pattern of a like or regexp_like call with a
+// constant and valid pattern on a column.
+std::optional<PatternCall> asPatternCall(
+    const std::string& likeName,
+    const std::string& regexpLikeName,
+    const core::TypedExprPtr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return std::nullopt;
+  }
+  const auto& inputs = call->inputs();
+  const bool isLike = call->name() == likeName &&
+      (inputs.size() == 2 || inputs.size() == 3);
+  const bool isRegexpLike =
+      call->name() == regexpLikeName && inputs.size() == 2;
+  if (!isLike && !isRegexpLike) {
+    return std::nullopt;
+  }
+
+  // Only columns are combined as evaluating an arbitrary expression once
+  // instead of once per pattern may change the result, e.g. for rand().
+  if (!inputs[0]->type()->isVarchar() ||
+      dynamic_cast<const core::FieldAccessTypedExpr*>(inputs[0].get()) ==
+          nullptr) {
+    return std::nullopt;
+  }
+
+  auto pattern = constantString(inputs[1]);
+  if (!pattern.has_value()) {
+    return std::nullopt;
+  }
+
+  std::optional<char> escapeChar;
+  if (inputs.size() == 3) {
+    const auto escape = constantString(inputs[2]);
+    if (!escape.has_value() || escape->size() != 1) {
+      return std::nullopt;
+    }
+    escapeChar = escape->at(0);
+  }
+
+  if (isLike) {
+    bool validPattern;
+    likePatternToRe2(StringView(*pattern), escapeChar, validPattern);
+    if (!validPattern) {
+      return std::nullopt;
+    }
+  } else if (!RE2(*pattern, RE2::Quiet).ok()) {
+    return std::nullopt;
+  }
+
+  return PatternCall{inputs[0], {std::move(*pattern), isLike, escapeChar}};
+}
+
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, disjuncts);
+    }
+  } else {
+    disjuncts.push_back(expr);
+  }
+}
+
+core::TypedExprPtr makeArray(std::vector<variant> values) {
+  return std::make_shared<core::ConstantTypedExpr>(
+      ARRAY(VARCHAR()), variant::array(std::move(values)));
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteMultiPatternMatch(
+    const std::string& likeName,
+    const std::string& regexpLikeName,
+    const std::string& likeAnyName,
+    const core::TypedExprPtr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenOr(expr, disjuncts);
+  if (disjuncts.size() < kMinMultiPatterns) {
+    return nullptr;
+  }
+
+  // Groups the pattern calls by column.
+  std::vector<std::optional<PatternCall>> patternCalls;
+  std::vector<std::vector<size_t>> groups;
+  patternCalls.reserve(disjuncts.size());
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    patternCalls.push_back(
+        asPatternCall(likeName, regexpLikeName, disjuncts[i]));
+    if (!patternCalls.back().has_value()) {
+      continue;
+    }
+    const auto& input = *patternCalls.back()->input;
+    auto group = std::find_if(groups.begin(), groups.end(), [&](auto& g) {
+      return *patternCalls[g[0]]->input == input;
+    });
+    if (group == groups.end()) {
+      groups.push_back({static_cast<size_t>(i)});
+    } else {
+      group->push_back(i);
+    }
+  }
+
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  std::vector<bool> combined(disjuncts.size(), false);
+  for (const auto& group : groups) {
+    if (group.size() < kMinMultiPatterns) {
+      continue;
+    }
+    std::vector<variant> likePatterns;
+    std::vector<variant> likeEscapes;
+    std::vector<variant> regexps;
+    for (auto i : group) {
+      const auto& pattern = patternCalls[i]->pattern;
+      if (pattern.isLike) {
+        likePatterns.emplace_back(pattern.pattern);
+        likeEscapes.emplace_back(
+            pattern.escapeChar.has_value()
+                ? std::string(1, pattern.escapeChar.value())
+                : std::string());
+      } else {
+        regexps.emplace_back(pattern.pattern);
+      }
+      combined[i] = true;
+    }
+    newDisjuncts.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            patternCalls[group[0]]->input,
+            makeArray(std::move(likePatterns)),
+            makeArray(std::move(likeEscapes)),
+            makeArray(std::move(regexps))},
+        likeAnyName));
+  }
+
+  if (newDisjuncts.empty()) {
+    return nullptr;
+  }
+
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    if (!combined[i]) {
+      newDisjuncts.push_back(disjuncts[i]);
+    }
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newDisjuncts), "or");
+}
+
+namespace detail {
+
+std::string requiredLikeLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  std::string longest;
+  std::string current;
+  bool escaped = false;
+  for (auto c : pattern) {
+    if (!escaped && c == escapeChar) {
+      escaped = true;
+      continue;
+    }
+    if (!escaped && (c == '%' || c == '_')) {
+      if (current.size() > longest.size()) {
+        longest = current;
+      }
+      current.clear();
+      continue;
+    }
+    current.push_back(c);
+    escaped = false;
+  }
+  return current.size() > longest.size() ? current : longest;
+}
+
+namespace {
+
+// Returns the position after the character class starting at 'pos'.
+size_t skipCharacterClass(std::string_view pattern, size_t pos) {
+  ++pos;
+  if (pos < pattern.size() && pattern[pos] == '^') {
+    ++pos;
+  }
+  // A ']' right after the opening bracket is a literal.
+  if (pos < pattern.size() && pattern[pos] == ']') {
+    ++pos;
+  }
+  while (pos < pattern.size()) {
+    if (pattern[pos] == '\\') {
+      pos += 2;
+    } else if (pattern.substr(pos, 2) == "[:") {
+      const auto end = pattern.find(":]", pos + 2);
+      pos = end == std::string_view::npos ? pattern.size() : end + 2;
+    } else if (pattern[pos] == ']') {
+      return pos + 1;
+    } else {
+      ++pos;
+    }
+  }
+  return pattern.size();
+}
+
+// Returns the position after the group starting at 'pos' or std::nullopt if
+// the group is not closed.
+std::optional<size_t> skipGroup(std::string_view pattern, size_t pos) {
+  int32_t depth = 0;
+  while (pos < pattern.size()) {
+    switch (pattern[pos]) {
+      case '\\':
+        pos += 2;
+        continue;
+      case '[':
+        pos = skipCharacterClass(pattern, pos);
+        continue;
+      case '(':
+        ++depth;
+        break;
+      case ')':
+        if (--depth == 0) {
+          return pos + 1;
+        }
+        break;
+      default:
+        break;
+    }
+    ++pos;
+  }
+  return std::nullopt;
+}
+
+bool isHexDigit(char c) {
+  return std::isxdigit(static_cast<unsigned char>(c));
+}
+
+} // namespace
+
+std::string requiredRegexLiteral(std::string_view pattern) {
+  std::string longest;
+  // The literal characters since the last non-literal atom.
+  std::string current;
+  // Offset in 'current' of the last literal character. A quantifier applies to
+  // this character only.
+  size_t lastStart = 0;
+  bool lastIsLiteral = false;
+
+  auto endRun = [&](size_t size) {
+    if (size > longest.size()) {
+      longest = current.substr(0, size);
+    }
+    current.clear();
+    lastIsLiteral = false;
+  };
+
+  size_t pos = 0;
+  while (pos < pattern.size()) {
+    const char c = pattern[pos];
+    switch (c) {
+      case '|':
+        // An alternation at the top level makes every literal optional.
+        return "";
+      case ')':
+        return "";
+      case '(': {
+        // Flags, e.g. (?i), may change how literals match.
+        if (pattern.substr(pos, 2) == "(?" &&
+            pattern.substr(pos, 3) != "(?:") {
+          return "";
+        }
+        endRun(current.size());
+        const auto end = skipGroup(pattern, pos);
+        if (!end.has_value()) {
+          return "";
+        }
+        pos = end.value();
+        continue;
+      }
+      case '[':
+        endRun(current.size());
+        pos = skipCharacterClass(pattern, pos);
+        continue;
+      case '.':
+      case '^':
+      case '$':
+        endRun(current.size());
+        ++pos;
+        continue;
+      case '*':
+      case '?':
+        // The preceding character may not occur.
+        endRun(lastIsLiteral ? lastStart : current.size());
+        ++pos;
+        continue;
+      case '+':
+        endRun(current.size());
+        ++pos;
+        continue;
+      case '{': {
+        endRun(lastIsLiteral ? lastStart : current.size());
+        const auto end = pattern.find('}', pos);
+        pos = end == std::string_view::npos ? pos + 1 : end + 1;
+        continue;
+      }
+      case '\\': {
+        if (pos + 1 >= pattern.size()) {
+          return "";
+        }
+        const char escaped = pattern[pos + 1];
+        if (!std::isalnum(static_cast<unsigned char>(escaped))) {
+          // Escaped punctuation is a literal.
+          lastStart = current.size();
+          current.push_back(escaped);
+          lastIsLiteral = true;
+          pos += 2;
+          continue;
+        }
+        if (escaped == 'Q') {
+          return "";
+        }
+        // Character classes, assertions and escape sequences such as \d, \b
+        // or \x41.
+        endRun(current.size());
+        pos += 2;
+        if (escaped == 'x' || escaped == 'p' || escaped == 'P') {
+          if (pos < pattern.size() && pattern[pos] == '{') {
+            const auto end = pattern.find('}', pos);
+            pos = end == std::string_view::npos ? pattern.size() : end + 1;
+          } else if (escaped == 'x') {
+            while (pos < pattern.size() && isHexDigit(pattern[pos])) {
+              ++pos;
+            }
+          } else {
+            ++pos;
+          }
+        } else if (std::isdigit(static_cast<unsigned char>(escaped))) {
+          while (pos < pattern.size() &&
+                 std::isdigit(static_cast<unsigned char>(pattern[pos]))) {
+            ++pos;
+          }
+        }
+        continue;
+      }
+      default:
+        // A quantifier applies to the whole UTF-8 character, so don't start a
+        // new character on continuation bytes.
+        if ((static_cast<uint8_t>(c) & 0xC0) != 0x80) {
+          lastStart = current.size();
+        }
+        current.push_back(c);
+        lastIsLiteral = true;
+        ++pos;
+    }
+  }
+  endRun(current.size());
+  return longest;
+}
+
+} // namespace detail
+
+} // namespace facebook::velox::functions
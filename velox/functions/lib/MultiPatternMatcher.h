@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+#include <re2/re2.h>
+#include <re2/set.h>
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::functions {
+
+/// Aho-Corasick automaton over bytes. Finds all occurrences of a set of
+/// keywords in a single pass over the text.
+class AhoCorasick {
+ public:
+  /// Builds the automaton for 'keywords'. Keywords must be non-empty and
+  /// unique.
+  explicit AhoCorasick(const std::vector<std::string>& keywords);
+
+  /// Scans 'text' once and calls 'onMatch(keywordIndex)' for each occurrence
+  /// of a keyword. Stops and returns true as soon as 'onMatch' returns true.
+  /// Returns false if 'onMatch' never returned true.
+  template <typename F>
+  bool search(std::string_view text, F onMatch) const {
+    int32_t state = 0;
+    for (auto c : text) {
+      state = next(state, static_cast<uint8_t>(c));
+      auto output = keyword_[state] >= 0 ? state : outputLink_[state];
+      for (; output > 0; output = outputLink_[output]) {
+        if (onMatch(keyword_[output])) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  size_t numStates() const {
+    return failure_.size();
+  }
+
+ private:
+  static uint64_t transitionKey(int32_t state, uint8_t c) {
+    return (static_cast<uint64_t>(state) << 8) | c;
+  }
+
+  // Returns the state reached from 'state' on byte 'c', following failure
+  // links as needed.
+  int32_t next(int32_t state, uint8_t c) const {
+    for (;;) {
+      if (state == 0) {
+        return rootTransitions_[c];
+      }
+      auto it = transitions_.find(transitionKey(state, c));
+      if (it != transitions_.end()) {
+        return it->second;
+      }
+      state = failure_[state];
+    }
+  }
+
+  // Transitions from the root. Most text bytes fall back to the root, so
+  // these are kept in a dense array. 0 means no transition.
+  std::array<int32_t, 256> rootTransitions_{};
+
+  // Transitions from the other states keyed on 'transitionKey'.
+  folly::F14FastMap<uint64_t, int32_t> transitions_;
+
+  // Failure link of each state.
+  std::vector<int32_t> failure_;
+
+  // Index of the keyword ending in each state or -1.
+  std::vector<int32_t> keyword_;
+
+  // The closest state on the failure chain of each state that ends a keyword
+  // or -1.
+  std::vector<int32_t> outputLink_;
+};
+
+/// Matches a string against a set of LIKE patterns and regular expressions
+/// in one pass and returns true if any of them matches.
+///
+/// The longest literal fragment that any match of a pattern must contain is
+/// extracted from each pattern. All the fragments are searched for with a
+/// single Aho-Corasick scan and only the patterns whose fragment occurs in the
+/// string are verified. Patterns of the form 'abc', 'abc%', '%abc' and '%abc%'
+/// are verified with a memcmp or not at all, the others with their RE2.
+/// Patterns without a usable fragment, e.g. '%_%' or '^[0-9]+$', are combined
+/// into a single RE2::Set which is evaluated only if no other pattern matched.
+class MultiPatternMatcher {
+ public:
+  struct Pattern {
+    std::string pattern;
+
+    /// True for a LIKE pattern. False for a regular expression with the
+    /// partial match semantics of regexp_like.
+    bool isLike;
+
+    /// Escape character of a LIKE pattern.
+    std::optional<char> escapeChar;
+  };
+
+  /// Throws if a pattern is invalid.
+  explicit MultiPatternMatcher(const std::vector<Pattern>& patterns);
+
+  /// Per-thread state that avoids verifying the same pattern more than once
+  /// per string.
+  struct Scratch {
+    std::vector<uint32_t> verified;
+    uint32_t epoch{0};
+  };
+
+  bool match(StringView input, Scratch& scratch) const;
+
+  /// Number of patterns prefiltered by the Aho-Corasick scan.
+  size_t numFiltered() const {
+    return filtered_.size();
+  }
+
+  /// Number of patterns evaluated with the RE2::Set.
+  size_t numUnfiltered() const {
+    return unfiltered_.size();
+  }
+
+ private:
+  enum class Verify {
+    // An occurrence of the literal is a match.
+    kNone,
+    // The input is equal to the literal.
+    kFixed,
+    // The input starts with the literal.
+    kPrefix,
+    // The input ends with the literal.
+    kSuffix,
+    // Full RE2 evaluation.
+    kRe2,
+  };
+
+  struct FilteredPattern {
+    Verify verify;
+    std::string literal;
+    std::unique_ptr<RE2> re;
+  };
+
+  bool verify(const FilteredPattern& pattern, StringView input) const;
+
+  bool matchUnfiltered(StringView input) const;
+
+  std::vector<FilteredPattern> filtered_;
+
+  // Indices into 'filtered_' of the patterns with the literal of each keyword
+  // of 'automaton_'.
+  std::vector<std::vector<int32_t>> keywordPatterns_;
+
+  std::optional<AhoCorasick> automaton_;
+
+  // The patterns without a literal. Used if 'unfilteredSet_' fails to match
+  // because it ran out of memory.
+  std::vector<std::unique_ptr<RE2>> unfiltered_;
+
+  std::unique_ptr<RE2::Set> unfilteredSet_;
+};
+
+/// $internal$like_any(string, likePatterns, likeEscapes, regexps) -> boolean
+///
+/// Returns true if 'string' matches any of the constant LIKE patterns or
+/// regular expressions. 'likeEscapes' has the escape character of each LIKE
+/// pattern or an empty string if it has none. Regular expressions use the
+/// semantics of regexp_like. Generated by 'rewriteMultiPatternMatch'.
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures();
+
+/// Minimum number of patterns on the same column that
+/// 'rewriteMultiPatternMatch' combines into a single call.
+inline constexpr int32_t kMinMultiPatterns = 3;
+
+/// Rewrites a disjunction of LIKE and regexp_like calls with constant
+/// patterns on the same column, e.g.
+///     like(c0, 'a%') OR regexp_like(c0, 'b+c') OR like(c0, '%d') OR c1
+/// into
+///     $internal$like_any(c0, ['a%', '%d'], ['', ''], ['b+c']) OR c1
+///
+/// Only groups of at least kMinMultiPatterns patterns are combined. Calls
+/// with an invalid pattern are left as is so they raise the same errors.
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteMultiPatternMatch(
+    const std::string& likeName,
+    const std::string& regexpLikeName,
+    const std::string& likeAnyName,
+    const core::TypedExprPtr& expr);
+
+namespace detail {
+
+/// Returns the longest literal string that every match of the LIKE
+/// 'pattern' must contain. 'pattern' must be valid.
+std::string requiredLikeLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar);
+
+/// Returns a literal string that every match of the RE2 regular expression
+/// 'pattern' must contain or an empty string if none is found. The analysis
+/// is conservative: alternations, flags, groups and character classes do not
+/// contribute literals.
+std::string requiredRegexLiteral(std::string_view pattern);
+
+} // namespace detail
+
+} // namespace facebook::velox::functions
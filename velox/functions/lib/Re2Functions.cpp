@@ -149,6 +149,8 @@ bool re2Extract(
   }
 }
 
+} // namespace
+
 std::string likePatternToRe2(
     StringView pattern,
     std::optional<char> escapeChar,
@@ -205,6 +207,8 @@ std::string likePatternToRe2(
   return regex;
 }
 
+namespace {
+
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
@@ -221,6 +221,14 @@ PatternMetadata determinePatternKind(
     std::string_view pattern,
     std::optional<char> escapeChar);
 
+/// Converts a LIKE pattern into an equivalent RE2 regular expression anchored
+/// at both ends. Sets 'validPattern' to false if the escape character is not
+/// followed by '%', '_' or the escape character itself.
+std::string likePatternToRe2(
+    StringView pattern,
+    std::optional<char> escapeChar,
+    bool& validPattern);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions::tdigest {
+
+namespace detail {
+
+// Version and value type of Presto's serialization format. Only digests of
+// DOUBLE values are supported.
+constexpr int8_t kSerializationVersion = 1;
+constexpr int8_t kDoubleType = 0;
+
+// Size of the header: version, type, min, max, compression, total weight and
+// number of centroids.
+constexpr size_t kHeaderSize = 2 + 4 * sizeof(double) + sizeof(int32_t);
+
+// The serialized data can come from arbitrary offsets inside a string, so
+// values are copied instead of accessed in place.
+template <typename T>
+void write(T value, char* out, size_t& offset) {
+  memcpy(out + offset, &value, sizeof(T));
+  offset += sizeof(T);
+}
+
+template <typename T>
+T read(const char* data, size_t& offset) {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+struct Header {
+  double min;
+  double max;
+  double compression;
+  double totalWeight;
+  int32_t numCentroids;
+};
+
+// Reads the header and checks that the version and value type are supported
+// and that 'size' matches the number of centroids. The data comes from user
+// input, so any inconsistency is a user error.
+inline Header readHeader(const char* data, size_t size, size_t& offset) {
+  VELOX_USER_CHECK_GE(size, kHeaderSize, "T-digest is too short");
+  const auto version = read<int8_t>(data, offset);
+  VELOX_USER_CHECK_EQ(
+      version,
+      kSerializationVersion,
+      "Unsupported t-digest version: {}",
+      version);
+  const auto type = read<int8_t>(data, offset);
+  VELOX_USER_CHECK_EQ(type, kDoubleType, "Unsupported t-digest type: {}", type);
+  Header header;
+  header.min = read<double>(data, offset);
+  header.max = read<double>(data, offset);
+  header.compression = read<double>(data, offset);
+  header.totalWeight = read<double>(data, offset);
+  header.numCentroids = read<int32_t>(data, offset);
+  VELOX_USER_CHECK_GE(header.numCentroids, 0);
+  VELOX_USER_CHECK_EQ(
+      size,
+      kHeaderSize + 2 * sizeof(double) * header.numCentroids,
+      "T-digest size does not match the number of centroids");
+  VELOX_USER_CHECK(
+      header.compression > 0,
+      "Invalid t-digest compression: {}",
+      header.compression);
+  return header;
+}
+
+// Number of buffered values that triggers a merge.
+inline size_t bufferCapacity(double compression) {
+  return 5 * std::ceil(compression);
+}
+
+} // namespace detail
+
+template <typename A>
+TDigest<A>::TDigest(const A& allocator)
+    : means_(allocator),
+      weights_(allocator),
+      unmergedMeans_(allocator),
+      unmergedWeights_(allocator),
+      order_(AllocI32(allocator)) {}
+
+template <typename A>
+void TDigest<A>::setCompression(double compression) {
+  VELOX_CHECK(means_.empty() && unmergedMeans_.empty());
+  VELOX_USER_CHECK_GT(compression, 0);
+  VELOX_USER_CHECK_LE(compression, kMaxCompression);
+  compression_ = std::max(compression, kMinCompression);
+}
+
+template <typename A>
+void TDigest<A>::add(double value, double weight) {
+  VELOX_USER_CHECK(!std::isnan(value), "Cannot add NaN to t-digest");
+  VELOX_USER_CHECK_GT(weight, 0, "Weight must be positive");
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  unmergedMeans_.push_back(value);
+  unmergedWeights_.push_back(weight);
+  unmergedWeight_ += weight;
+  if (unmergedMeans_.size() >= detail::bufferCapacity(compression_)) {
+    compress();
+  }
+}
+
+template <typename A>
+void TDigest<A>::addCentroids(
+    const double* means,
+    const double* weights,
+    int32_t count) {
+  for (int32_t i = 0; i < count; ++i) {
+    unmergedMeans_.push_back(means[i]);
+    unmergedWeights_.push_back(weights[i]);
+    unmergedWeight_ += weights[i];
+    if (unmergedMeans_.size() >= detail::bufferCapacity(compression_)) {
+      compress();
+    }
+  }
+}
+
+template <typename A>
+void TDigest<A>::compress() {
+  if (unmergedMeans_.empty()) {
+    return;
+  }
+  // Sort the buffer together with the existing centroids and combine them in
+  // one pass.
+  unmergedMeans_.insert(unmergedMeans_.end(), means_.begin(), means_.end());
+  unmergedWeights_.insert(
+      unmergedWeights_.end(), weights_.begin(), weights_.end());
+  const auto numInputs = unmergedMeans_.size();
+  order_.resize(numInputs);
+  std::iota(order_.begin(), order_.end(), 0);
+  std::sort(order_.begin(), order_.end(), [&](int32_t i, int32_t j) {
+    return unmergedMeans_[i] < unmergedMeans_[j];
+  });
+
+  totalWeight_ += unmergedWeight_;
+  unmergedWeight_ = 0;
+  // Normalizer of the k2 scale function. A centroid starting at quantile q0
+  // and ending at q2 may hold at most total * min(q * (1 - q)) / normalizer
+  // of the weight for q in {q0, q2}.
+  const double normalizer =
+      compression_ / (4 * std::log(totalWeight_ / compression_) + 24);
+
+  means_.clear();
+  weights_.clear();
+  means_.push_back(unmergedMeans_[order_[0]]);
+  weights_.push_back(unmergedWeights_[order_[0]]);
+  double weightSoFar = 0;
+  for (size_t i = 1; i < numInputs; ++i) {
+    const auto index = order_[i];
+    const double mean = unmergedMeans_[index];
+    const double weight = unmergedWeights_[index];
+    const double proposedWeight = weights_.back() + weight;
+    const double q0 = weightSoFar / totalWeight_;
+    const double q2 = (weightSoFar + proposedWeight) / totalWeight_;
+    const double limit =
+        totalWeight_ * std::min(q0 * (1 - q0), q2 * (1 - q2)) / normalizer;
+    if (proposedWeight <= limit) {
+      weights_.back() = proposedWeight;
+      means_.back() += (mean - means_.back()) * weight / proposedWeight;
+    } else {
+      weightSoFar += weights_.back();
+      means_.push_back(mean);
+      weights_.push_back(weight);
+    }
+  }
+  unmergedMeans_.clear();
+  unmergedWeights_.clear();
+}
+
+template <typename A>
+template <typename OtherAllocator>
+void TDigest<A>::merge(const TDigest<OtherAllocator>& other) {
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  addCentroids(
+      other.means_.data(), other.weights_.data(), other.means_.size());
+  addCentroids(
+      other.unmergedMeans_.data(),
+      other.unmergedWeights_.data(),
+      other.unmergedMeans_.size());
+}
+
+template <typename A>
+void TDigest<A>::mergeDeserialized(const char* data, size_t size) {
+  size_t offset = 0;
+  const auto header = detail::readHeader(data, size, offset);
+  if (header.numCentroids == 0) {
+    return;
+  }
+  if (totalWeight() == 0) {
+    setCompression(std::min(header.compression, kMaxCompression));
+  }
+  min_ = std::min(min_, header.min);
+  max_ = std::max(max_, header.max);
+  const char* weights = data + offset;
+  const char* means = weights + header.numCentroids * sizeof(double);
+  for (int32_t i = 0; i < header.numCentroids; ++i) {
+    double mean;
+    double weight;
+    memcpy(&mean, means + i * sizeof(double), sizeof(double));
+    memcpy(&weight, weights + i * sizeof(double), sizeof(double));
+    addCentroids(&mean, &weight, 1);
+  }
+}
+
+template <typename A>
+double TDigest<A>::weightedAverage(double x1, double w1, double x2, double w2) {
+  if (x1 > x2) {
+    std::swap(x1, x2);
+    std::swap(w1, w2);
+  }
+  const double x = (x1 * w1 + x2 * w2) / (w1 + w2);
+  return std::max(x1, std::min(x, x2));
+}
+
+template <typename A>
+double TDigest<A>::estimateQuantile(double quantile) const {
+  VELOX_CHECK(unmergedMeans_.empty(), "T-digest must be compressed first");
+  VELOX_CHECK(0 <= quantile && quantile <= 1);
+  const int32_t n = means_.size();
+  if (n == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (n == 1) {
+    return means_[0];
+  }
+  const double index = quantile * totalWeight_;
+  if (index < 1) {
+    return min_;
+  }
+  // The first and last centroids hold a single sample at the min and max, so
+  // interpolate between those and the centroid means.
+  if (weights_[0] > 1 && index < weights_[0] / 2) {
+    return min_ + (index - 1) / (weights_[0] / 2 - 1) * (means_[0] - min_);
+  }
+  if (index > totalWeight_ - 1) {
+    return max_;
+  }
+  if (weights_[n - 1] > 1 && totalWeight_ - index <= weights_[n - 1] / 2) {
+    return max_ -
+        (totalWeight_ - index - 1) / (weights_[n - 1] / 2 - 1) *
+        (max_ - means_[n - 1]);
+  }
+
+  double weightSoFar = weights_[0] / 2;
+  for (int32_t i = 0; i < n - 1; ++i) {
+    const double dw = (weights_[i] + weights_[i + 1]) / 2;
+    if (weightSoFar + dw > index) {
+      // Centroids of weight 1 are exact samples, so do not interpolate within
+      // half a unit of them.
+      double leftUnit = 0;
+      if (weights_[i] == 1) {
+        if (index - weightSoFar < 0.5) {
+          return means_[i];
+        }
+        leftUnit = 0.5;
+      }
+      double rightUnit = 0;
+      if (weights_[i + 1] == 1) {
+        if (weightSoFar + dw - index <= 0.5) {
+          return means_[i + 1];
+        }
+        rightUnit = 0.5;
+      }
+      const double z1 = index - weightSoFar - leftUnit;
+      const double z2 = weightSoFar + dw - index - rightUnit;
+      return weightedAverage(means_[i], z2, means_[i + 1], z1);
+    }
+    weightSoFar += dw;
+  }
+  // Interpolate between the last centroid and the max.
+  const double z1 = index - weightSoFar;
+  const double z2 = weights_[n - 1] / 2 - z1;
+  return weightedAverage(means_[n - 1], z2, max_, z1);
+}
+
+template <typename A>
+template <typename Iter>
+void TDigest<A>::estimateQuantiles(
+    const folly::Range<Iter>& quantiles,
+    double* out) const {
+  for (size_t i = 0; i < quantiles.size(); ++i) {
+    out[i] = estimateQuantile(quantiles[i]);
+  }
+}
+
+template <typename A>
+size_t TDigest<A>::serializedByteSize() const {
+  return detail::kHeaderSize + 2 * sizeof(double) * means_.size();
+}
+
+template <typename A>
+void TDigest<A>::serialize(char* out) const {
+  VELOX_CHECK(unmergedMeans_.empty(), "T-digest must be compressed first");
+  size_t offset = 0;
+  detail::write(detail::kSerializationVersion, out, offset);
+  detail::write(detail::kDoubleType, out, offset);
+  detail::write(min_, out, offset);
+  detail::write(max_, out, offset);
+  detail::write(compression_, out, offset);
+  detail::write(totalWeight_, out, offset);
+  detail::write<int32_t>(means_.size(), out, offset);
+  const auto bytes = sizeof(double) * means_.size();
+  memcpy(out + offset, weights_.data(), bytes);
+  offset += bytes;
+  memcpy(out + offset, means_.data(), bytes);
+  offset += bytes;
+  VELOX_DCHECK_EQ(offset, serializedByteSize());
+}
+
+template <typename A>
+TDigest<A>
+TDigest<A>::deserialize(const char* data, size_t size, const A& allocator) {
+  TDigest<A> digest(allocator);
+  size_t offset = 0;
+  const auto header = detail::readHeader(data, size, offset);
+  if (header.numCentroids == 0) {
+    return digest;
+  }
+  // The serialized centroids are already merged and sorted by mean, so they
+  // are loaded as is.
+  digest.setCompression(std::min(header.compression, kMaxCompression));
+  digest.min_ = header.min;
+  digest.max_ = header.max;
+  digest.totalWeight_ = header.totalWeight;
+  const auto bytes = sizeof(double) * header.numCentroids;
+  digest.weights_.resize(header.numCentroids);
+  memcpy(digest.weights_.data(), data + offset, bytes);
+  offset += bytes;
+  digest.means_.resize(header.numCentroids);
+  memcpy(digest.means_.data(), data + offset, bytes);
+  return digest;
+}
+
+} // namespace facebook::velox::functions::tdigest
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "folly/Range.h"
+
+namespace facebook::velox::functions::tdigest {
+
+constexpr double kDefaultCompression = 100;
+
+/// Compression factors below this value are raised to it.
+constexpr double kMinCompression = 10;
+
+constexpr double kMaxCompression = 1000;
+
+/// Implementation of the merging t-digest, a sketch for estimating quantiles
+/// with accuracy relative to q * (1 - q), i.e. much more accurate at the tails
+/// of the distribution than at the median.
+///
+/// Values are collected in a buffer and periodically merged with the existing
+/// centroids in a single sorted pass. Adjacent centroids are combined as long
+/// as the result stays within the size allowed by the k2 scale function at
+/// that quantile, so centroids near q = 0 and q = 1 hold very few values.
+///
+/// The serialization format is compatible with Presto's tdigest type.
+///
+/// See https://arxiv.org/abs/1902.04023 for more details.
+template <typename Allocator = std::allocator<double>>
+class TDigest {
+ public:
+  explicit TDigest(const Allocator& allocator = Allocator());
+
+  /// Sets the compression factor. Larger values give more accurate results
+  /// using more centroids. Must be called before adding any values.
+  void setCompression(double compression);
+
+  double compression() const {
+    return compression_;
+  }
+
+  /// Adds 'value' with 'weight'. 'value' must not be NaN and 'weight' must be
+  /// positive.
+  void add(double value, double weight = 1);
+
+  /// Merges buffered values into the centroids. Must be called before
+  /// estimateQuantile(), serializedByteSize() and serialize().
+  void compress();
+
+  /// Adds the centroids and buffered values of 'other' to this digest.
+  template <typename OtherAllocator>
+  void merge(const TDigest<OtherAllocator>& other);
+
+  /// Adds the centroids of a serialized digest to this digest. Adopts the
+  /// compression of the serialized digest if this digest is empty. Throws a
+  /// user error if the 'size' bytes at 'data' are not a valid digest.
+  void mergeDeserialized(const char* data, size_t size);
+
+  /// Estimates the value at 'quantile' in [0, 1]. Returns NaN if the digest is
+  /// empty.
+  double estimateQuantile(double quantile) const;
+
+  /// Estimates the values at multiple quantiles.
+  /// @param out Pre-allocated memory at least as large as 'quantiles'.
+  template <typename Iter>
+  void estimateQuantiles(const folly::Range<Iter>& quantiles, double* out)
+      const;
+
+  /// Total weight of the values added to the digest.
+  double totalWeight() const {
+    return totalWeight_ + unmergedWeight_;
+  }
+
+  double min() const {
+    return min_;
+  }
+
+  double max() const {
+    return max_;
+  }
+
+  /// Number of centroids. Excludes buffered values.
+  int32_t numCentroids() const {
+    return means_.size();
+  }
+
+  /// Calculate the size needed for serialization.
+  size_t serializedByteSize() const;
+
+  /// Serializes the digest in the format of Presto's tdigest type.
+  ///
+  /// @param out Pre-allocated memory at least serializedByteSize() in size
+  void serialize(char* out) const;
+
+  /// Reads a digest serialized by serialize() or by Presto. The result is
+  /// compressed. Throws a user error if the 'size' bytes at 'data' are not a
+  /// valid digest.
+  static TDigest<Allocator> deserialize(
+      const char* data,
+      size_t size,
+      const Allocator& allocator = Allocator());
+
+ private:
+  template <typename A>
+  friend class TDigest;
+
+  using AllocI32 = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<int32_t>;
+
+  // Interpolates between 'x1' and 'x2' proportionally to the weights and
+  // clamps the result to [x1, x2].
+  static double weightedAverage(double x1, double w1, double x2, double w2);
+
+  // Adds 'count' centroids to the buffer.
+  void addCentroids(const double* means, const double* weights, int32_t count);
+
+  double compression_{kDefaultCompression};
+  double min_{std::numeric_limits<double>::infinity()};
+  double max_{-std::numeric_limits<double>::infinity()};
+
+  // Sum of 'weights_'.
+  double totalWeight_{0};
+
+  // Centroids sorted by mean.
+  std::vector<double, Allocator> means_;
+  std::vector<double, Allocator> weights_;
+
+  // Values not merged into the centroids yet and the sum of their weights.
+  std::vector<double, Allocator> unmergedMeans_;
+  std::vector<double, Allocator> unmergedWeights_;
+  double unmergedWeight_{0};
+
+  // Scratch space for sorting the buffer in compress().
+  std::vector<int32_t, AllocI32> order_;
+};
+
+} // namespace facebook::velox::functions::tdigest
+
+#include "velox/functions/lib/TDigest-inl.h"
@@ -16,6 +16,7 @@
 #include "velox/functions/lib/Utf8Utils.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -173,4 +174,18 @@ int32_t tryGetCharLength(const char* input, int64_t size) {
   return -1;
 }
 
+int64_t findInvalidUtf8(const char* input, int64_t size) {
+  size_t numChars;
+  int64_t pos = stringCore::skipValidUtf8(
+      input, size, std::numeric_limits<size_t>::max(), numChars);
+  while (pos < size) {
+    auto charLength = tryGetCharLength(input + pos, size - pos);
+    if (charLength < 0) {
+      return pos;
+    }
+    pos += charLength;
+  }
+  return size;
+}
+
 } // namespace facebook::velox::functions
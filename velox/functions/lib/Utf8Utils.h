@@ -52,6 +52,13 @@ namespace facebook::velox::functions {
 /// https://github.com/airlift/slice/blob/master/src/main/java/io/airlift/slice/SliceUtf8.java
 int32_t tryGetCharLength(const char* input, int64_t size);
 
+/// Returns the offset of the first byte sequence in `input` for which
+/// tryGetCharLength returns a negative value when walking the string character
+/// by character from the start, or `size` if the whole input is valid UTF-8.
+/// Validates 64 bytes at a time and only falls back to tryGetCharLength from
+/// the start of the block that contains the first invalid sequence.
+int64_t findInvalidUtf8(const char* input, int64_t size);
+
 /// Return the length in byte of the next UTF-8 encoded character at the
 /// beginning of `string`. If the beginning of `string` is not valid UTF-8
 /// encoding, return -1.
@@ -121,7 +121,7 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
     } else {
       mayPushdown = false;
     }
-    BaseAggregate::template updateGroups<true, T>(
+    BaseAggregate::template updateGroups<true, T, T, MinMaxRunReducer<false>>(
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
@@ -138,7 +138,7 @@ class SimpleNumericMaxAggregate : public SimpleNumericMinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::updateOneGroup(
+    BaseAggregate::template updateOneGroup<T, T, MinMaxRunReducer<false>>(
         group,
         rows,
         args[0],
@@ -218,7 +218,7 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
     } else {
       mayPushdown = false;
     }
-    BaseAggregate::template updateGroups<true, T>(
+    BaseAggregate::template updateGroups<true, T, T, MinMaxRunReducer<true>>(
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
@@ -235,7 +235,7 @@ class SimpleNumericMinAggregate : public SimpleNumericMinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::updateOneGroup(
+    BaseAggregate::template updateOneGroup<T, T, MinMaxRunReducer<true>>(
         group,
         rows,
         args[0],
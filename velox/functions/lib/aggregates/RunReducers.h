@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox::functions::aggregate {
+
+/// Reducers fold a run of consecutive rows of the same group into the group's
+/// accumulator at once instead of updating the accumulator row by row. This
+/// is used by SimpleNumericAggregate for global aggregations and for runs of
+/// rows in the same group, e.g. in streaming aggregation or over sorted input.
+///
+/// A reducer provides
+///
+///   template <typename TData, typename TValue, typename Update>
+///   static void reduce(
+///       TData& accumulator,
+///       const TValue* values,
+///       vector_size_t begin,
+///       vector_size_t end,
+///       Update update);
+///
+/// which folds non-null 'values[begin, end)' into 'accumulator'. 'update' is
+/// the aggregate's function to add a single value to an accumulator.
+
+/// Folds values one at a time into a copy of the accumulator kept in a
+/// register. Gives the same result as updating row by row.
+struct ScalarRunReducer {
+  template <typename TData, typename TValue, typename Update>
+  static void reduce(
+      TData& accumulator,
+      const TValue* values,
+      vector_size_t begin,
+      vector_size_t end,
+      Update update) {
+    TData result = accumulator;
+    for (auto i = begin; i < end; ++i) {
+      update(result, TData(values[i]));
+    }
+    accumulator = result;
+  }
+};
+
+namespace detail {
+
+// Returns the sum of 'values[begin, end)' computed in SIMD lanes. Integer
+// sums wrap around on overflow.
+template <typename T>
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("signed-integer-overflow")
+#endif
+T simdSum(const T* values, vector_size_t begin, vector_size_t end) {
+  using Batch = xsimd::batch<T>;
+  Batch sums(T(0));
+  auto i = begin;
+  for (; i + static_cast<vector_size_t>(Batch::size) <= end;
+       i += Batch::size) {
+    sums += Batch::load_unaligned(values + i);
+  }
+  T result = xsimd::reduce_add(sums);
+  for (; i < end; ++i) {
+    result += values[i];
+  }
+  return result;
+}
+
+// Returns the absolute value of 'value' as unsigned, so that it is defined
+// for the min int64_t.
+inline uint64_t unsignedAbs(int64_t value) {
+  return value < 0 ? uint64_t(0) - static_cast<uint64_t>(value)
+                   : static_cast<uint64_t>(value);
+}
+
+// Returns true if adding 'numValues' values in [min, max] to 'accumulator' in
+// any order cannot overflow int64_t, i.e. if |accumulator| + 'numValues' *
+// max(|min|, |max|) fits. A checked sum of such values then fails nowhere, no
+// matter how the additions are grouped.
+inline bool sumCannotOverflow(
+    int64_t accumulator,
+    int64_t min,
+    int64_t max,
+    vector_size_t numValues) {
+  uint64_t bound;
+  return !__builtin_mul_overflow(
+             std::max(unsignedAbs(min), unsignedAbs(max)),
+             static_cast<uint64_t>(numValues),
+             &bound) &&
+      !__builtin_add_overflow(bound, unsignedAbs(accumulator), &bound) &&
+      bound <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+}
+
+// Sets 'result' to the sum of 'values[begin, end)' computed in SIMD lanes if
+// the sum cannot overflow when added to 'accumulator' one value at a time.
+// Returns false without setting 'result' otherwise. Finds the min and max of
+// the values in the same pass as the sum.
+inline bool simdCheckedSum(
+    int64_t accumulator,
+    const int64_t* values,
+    vector_size_t begin,
+    vector_size_t end,
+    int64_t& result) {
+  if (begin >= end) {
+    result = 0;
+    return true;
+  }
+  using Batch = xsimd::batch<int64_t>;
+  // Add as unsigned to wrap around without undefined behavior. If the sum
+  // wraps around, the bound check below fails and the sum is not used.
+  xsimd::batch<uint64_t> sums(uint64_t(0));
+  Batch mins(values[begin]);
+  Batch maxs(values[begin]);
+  auto i = begin;
+  for (; i + static_cast<vector_size_t>(Batch::size) <= end;
+       i += Batch::size) {
+    const auto data = Batch::load_unaligned(values + i);
+    sums += xsimd::bitwise_cast<uint64_t>(data);
+    mins = xsimd::min(mins, data);
+    maxs = xsimd::max(maxs, data);
+  }
+  uint64_t sum = xsimd::reduce_add(sums);
+  alignas(Batch::arch_type::alignment()) int64_t minLanes[Batch::size];
+  alignas(Batch::arch_type::alignment()) int64_t maxLanes[Batch::size];
+  mins.store_aligned(minLanes);
+  maxs.store_aligned(maxLanes);
+  int64_t min = minLanes[0];
+  int64_t max = maxLanes[0];
+  for (size_t lane = 1; lane < Batch::size; ++lane) {
+    min = std::min(min, minLanes[lane]);
+    max = std::max(max, maxLanes[lane]);
+  }
+  for (; i < end; ++i) {
+    sum += static_cast<uint64_t>(values[i]);
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+  }
+  if (!sumCannotOverflow(accumulator, min, max, end - begin)) {
+    return false;
+  }
+  result = static_cast<int64_t>(sum);
+  return true;
+}
+
+// Returns the min or max of non-empty 'values[begin, end)'.
+template <bool kMin, typename T>
+T simdMinMax(const T* values, vector_size_t begin, vector_size_t end) {
+  using Batch = xsimd::batch<T>;
+  Batch extremes(values[begin]);
+  auto i = begin;
+  for (; i + static_cast<vector_size_t>(Batch::size) <= end;
+       i += Batch::size) {
+    const auto data = Batch::load_unaligned(values + i);
+    if constexpr (kMin) {
+      extremes = xsimd::min(extremes, data);
+    } else {
+      extremes = xsimd::max(extremes, data);
+    }
+  }
+  alignas(Batch::arch_type::alignment()) T lanes[Batch::size];
+  extremes.store_aligned(lanes);
+  T result = lanes[0];
+  for (auto lane : lanes) {
+    result = kMin ? std::min(result, lane) : std::max(result, lane);
+  }
+  for (; i < end; ++i) {
+    result = kMin ? std::min(result, values[i]) : std::max(result, values[i]);
+  }
+  return result;
+}
+
+} // namespace detail
+
+/// Sums a run in SIMD lanes and adds the sum to the accumulator. 'kOverflow'
+/// has the same meaning as in SumAggregateBase: if true, integer sums wrap
+/// around, otherwise overflow raises an error.
+///
+/// Checked integer sums only add the run at once if no partial sum can
+/// overflow, whatever the order of the additions. Otherwise they add the
+/// values one at a time, so that they fail exactly when updating row by row
+/// fails. Floating point sums may differ in rounding from adding row by row.
+template <bool kOverflow>
+struct SumRunReducer {
+  template <typename TData, typename TValue, typename Update>
+  static void reduce(
+      TData& accumulator,
+      const TValue* values,
+      vector_size_t begin,
+      vector_size_t end,
+      Update update) {
+    if constexpr (
+        std::is_same_v<TData, TValue> &&
+        (std::is_same_v<TData, int64_t> || std::is_same_v<TData, double> ||
+         std::is_same_v<TData, float>)) {
+      if constexpr (std::is_same_v<TData, int64_t> && !kOverflow) {
+        int64_t sum;
+        if (detail::simdCheckedSum(accumulator, values, begin, end, sum)) {
+          update(accumulator, sum);
+        } else {
+          ScalarRunReducer::reduce(accumulator, values, begin, end, update);
+        }
+      } else {
+        update(accumulator, detail::simdSum(values, begin, end));
+      }
+    } else if constexpr (
+        std::is_same_v<TData, int64_t> && std::is_integral_v<TValue> &&
+        sizeof(TValue) < sizeof(int64_t)) {
+      // The sum of fewer than 2^31 values of at most 32 bits fits in 64 bits.
+      int64_t sum = 0;
+      int64_t min = std::numeric_limits<int64_t>::max();
+      int64_t max = std::numeric_limits<int64_t>::min();
+      for (auto i = begin; i < end; ++i) {
+        sum += values[i];
+        min = std::min<int64_t>(min, values[i]);
+        max = std::max<int64_t>(max, values[i]);
+      }
+      if (kOverflow || begin >= end ||
+          detail::sumCannotOverflow(accumulator, min, max, end - begin)) {
+        update(accumulator, sum);
+      } else {
+        ScalarRunReducer::reduce(accumulator, values, begin, end, update);
+      }
+    } else {
+      ScalarRunReducer::reduce(accumulator, values, begin, end, update);
+    }
+  }
+};
+
+/// Computes the min or max of a run in SIMD lanes for integer types. Floating
+/// point types fold values one at a time to keep the NaN semantics of 'update'.
+template <bool kMin>
+struct MinMaxRunReducer {
+  template <typename TData, typename TValue, typename Update>
+  static void reduce(
+      TData& accumulator,
+      const TValue* values,
+      vector_size_t begin,
+      vector_size_t end,
+      Update update) {
+    if constexpr (
+        std::is_same_v<TData, TValue> && std::is_integral_v<TData> &&
+        !std::is_same_v<TData, bool> && sizeof(TData) <= sizeof(int64_t)) {
+      if (begin < end) {
+        update(accumulator, detail::simdMinMax<kMin>(values, begin, end));
+      }
+    } else {
+      ScalarRunReducer::reduce(accumulator, values, begin, end, update);
+    }
+  }
+};
+
+/// Folds the non-null values in 'values[begin, end)' into 'accumulator' using
+/// 'Reducer'. 'nulls' is nullptr if there are no nulls. Dense 64-row words
+/// without nulls go to the reducer and the remaining values are folded one at
+/// a time. Returns true if there was at least one non-null value.
+template <
+    typename Reducer,
+    typename TData,
+    typename TValue,
+    typename Update>
+bool reduceRun(
+    TData& accumulator,
+    const TValue* values,
+    const uint64_t* nulls,
+    vector_size_t begin,
+    vector_size_t end,
+    Update update) {
+  if (nulls == nullptr) {
+    Reducer::reduce(accumulator, values, begin, end, update);
+    return begin < end;
+  }
+
+  bool hasValue = false;
+  auto addSetBits = [&](int32_t index, uint64_t word) {
+    hasValue |= word != 0;
+    while (word) {
+      update(
+          accumulator, TData(values[index * 64 + __builtin_ctzll(word)]));
+      word &= word - 1;
+    }
+  };
+  bits::forEachWord(
+      begin,
+      end,
+      [&](int32_t index, uint64_t mask) {
+        addSetBits(index, nulls[index] & mask);
+      },
+      [&](int32_t index) {
+        if (nulls[index] == bits::kNotNull64) {
+          Reducer::reduce(
+              accumulator, values, index * 64, index * 64 + 64, update);
+          hasValue = true;
+        } else {
+          addSetBits(index, nulls[index]);
+        }
+      });
+  return hasValue;
+}
+
+} // namespace facebook::velox::functions::aggregate
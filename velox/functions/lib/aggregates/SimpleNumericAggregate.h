@@ -17,6 +17,7 @@
 
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
+#include "velox/functions/lib/aggregates/RunReducers.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/LazyVector.h"
@@ -86,10 +87,16 @@ class SimpleNumericAggregate : public exec::Aggregate {
   // sum(real) can differ. TValue is used to decode the update input 'args'.
   // It can be either TAccumulator or TInput, which is most cases are the same
   // but for sum(real) can differ.
+  //
+  // If all rows are selected and consecutive rows tend to belong to the same
+  // group, e.g. for sorted or streaming input, each run of rows in the same
+  // group is folded into the group's accumulator at once. 'Reducer' folds
+  // runs of flat values, e.g. in SIMD lanes. See RunReducers.h.
   template <
       bool tableHasNulls,
       typename TData = TResult,
       typename TValue = TInput,
+      typename Reducer = ScalarRunReducer,
       typename UpdateSingleValue>
   void updateGroups(
       char** groups,
@@ -116,6 +123,15 @@ class SimpleNumericAggregate : public exec::Aggregate {
       }
     }
 
+    if constexpr (!std::is_same_v<TValue, bool>) {
+      if (!decoded.isConstantMapping() && rows.isAllSelected() &&
+          hasGroupRuns(groups, rows.end())) {
+        updateGroupRuns<tableHasNulls, TData, TValue, Reducer>(
+            groups, rows, decoded, updateSingleValue);
+        return;
+      }
+    }
+
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
         auto value = decoded.valueAt<TValue>(0);
@@ -151,9 +167,13 @@ class SimpleNumericAggregate : public exec::Aggregate {
   // sum(real) can differ. TValue is used to decode the update input 'args'.
   // It can be either TAccumulator or TInput, which is most cases are the same
   // but for sum(real) can differ.
+  //
+  // If all rows are selected and 'arg' is flat, the values are folded into the
+  // accumulator at once using 'Reducer'. See RunReducers.h.
   template <
       typename TData = TResult,
       typename TValue = TInput,
+      typename Reducer = ScalarRunReducer,
       typename UpdateSingle,
       typename UpdateDuplicate>
   void updateOneGroup(
@@ -175,7 +195,25 @@ class SimpleNumericAggregate : public exec::Aggregate {
             rows.countSelected());
         updateNonNullValue<true, TData>(group, initialValue, updateSingleValue);
       }
-    } else if (decoded.mayHaveNulls()) {
+      return;
+    }
+
+    if constexpr (!std::is_same_v<TValue, bool>) {
+      if (decoded.isIdentityMapping() && rows.isAllSelected()) {
+        if (reduceRun<Reducer>(
+                *exec::Aggregate::value<TData>(group),
+                decoded.data<TValue>(),
+                decoded.nulls(&rows),
+                0,
+                rows.end(),
+                updateSingleValue)) {
+          exec::Aggregate::clearNull(group);
+        }
+        return;
+      }
+    }
+
+    if (decoded.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (decoded.isNullAt(i)) {
           return;
@@ -197,6 +235,77 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Returns true if consecutive rows in 'groups' tend to belong to the same
+  // group so that updating once per run of rows pays off. Looks at the first
+  // rows only.
+  static bool hasGroupRuns(char** groups, vector_size_t numRows) {
+    constexpr vector_size_t kNumSampleRows = 64;
+    constexpr vector_size_t kMinAverageRunLength = 4;
+    const auto numSampleRows = std::min(numRows, kNumSampleRows);
+    vector_size_t numRuns = 1;
+    for (auto i = 1; i < numSampleRows; ++i) {
+      numRuns += groups[i] != groups[i - 1];
+    }
+    return numSampleRows >= numRuns * kMinAverageRunLength;
+  }
+
+  // Calls 'func(begin, end)' for each run of consecutive rows in [0, numRows)
+  // that belong to the same group.
+  template <typename Func>
+  static void
+  forEachGroupRun(char** groups, vector_size_t numRows, Func func) {
+    vector_size_t begin = 0;
+    while (begin < numRows) {
+      auto end = begin + 1;
+      while (end < numRows && groups[end] == groups[begin]) {
+        ++end;
+      }
+      func(begin, end);
+      begin = end;
+    }
+  }
+
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename TValue,
+      typename Reducer,
+      typename UpdateSingleValue>
+  void updateGroupRuns(
+      char** groups,
+      const SelectivityVector& rows,
+      DecodedVector& decoded,
+      UpdateSingleValue updateSingleValue) {
+    const auto* nulls = decoded.nulls(&rows);
+    const auto* data =
+        decoded.isIdentityMapping() ? decoded.data<TValue>() : nullptr;
+    forEachGroupRun(groups, rows.end(), [&](auto begin, auto end) {
+      char* group = groups[begin];
+      auto& accumulator = *exec::Aggregate::value<TData>(group);
+      bool hasValue = false;
+      if (data != nullptr) {
+        hasValue = reduceRun<Reducer>(
+            accumulator, data, nulls, begin, end, updateSingleValue);
+      } else {
+        // Dictionary-encoded values are folded one at a time into a copy of
+        // the accumulator.
+        TData result = accumulator;
+        for (auto i = begin; i < end; ++i) {
+          if (nulls == nullptr || !bits::isBitNull(nulls, i)) {
+            updateSingleValue(result, TData(decoded.valueAt<TValue>(i)));
+            hasValue = true;
+          }
+        }
+        accumulator = result;
+      }
+      if constexpr (tableHasNulls) {
+        if (hasValue) {
+          exec::Aggregate::clearNull(group);
+        }
+      }
+    });
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -85,7 +85,10 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::template updateOneGroup<TAccumulator>(
+    BaseAggregate::template updateOneGroup<
+        TAccumulator,
+        TInput,
+        SumRunReducer<Overflow>>(
         group,
         rows,
         args[0],
@@ -100,7 +103,10 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::template updateOneGroup<TAccumulator, TAccumulator>(
+    BaseAggregate::template updateOneGroup<
+        TAccumulator,
+        TAccumulator,
+        SumRunReducer<Overflow>>(
         group,
         rows,
         args[0],
@@ -132,10 +138,18 @@ class SumAggregateBase
     }
 
     if (exec::Aggregate::numNulls_) {
-      BaseAggregate::template updateGroups<true, TData, TValue>(
+      BaseAggregate::template updateGroups<
+          true,
+          TData,
+          TValue,
+          SumRunReducer<Overflow>>(
           groups, rows, arg, &updateSingleValue<TData>, false);
     } else {
-      BaseAggregate::template updateGroups<false, TData, TValue>(
+      BaseAggregate::template updateGroups<
+          false,
+          TData,
+          TValue,
+          SumRunReducer<Overflow>>(
           groups, rows, arg, &updateSingleValue<TData>, false);
     }
   }
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <random>
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/portability/GFlags.h>
+
+#include "velox/functions/lib/KllSketch.h"
+#include "velox/functions/lib/TDigest.h"
+
+// Compares the t-digest used by tdigest_agg with the KLL sketch used by
+// approx_percentile. Besides update and merge throughput, main() prints the
+// rank error of both sketches at the tail of a skewed distribution before
+// running the benchmarks.
+
+namespace facebook::velox::functions::tdigest::test {
+namespace {
+
+using functions::kll::KllSketch;
+
+void populateValues(int len, std::vector<double>& out) {
+  folly::Random::DefaultGenerator gen(folly::Random::rand32());
+  std::lognormal_distribution<> dist(0, 2);
+  out.resize(len);
+  for (int i = 0; i < len; ++i) {
+    out[i] = dist(gen);
+  }
+}
+
+int insertTDigest(int iters) {
+  std::vector<double> values;
+  BENCHMARK_SUSPEND {
+    populateValues(iters, values);
+  }
+  TDigest<> digest;
+  for (int i = 0; i < iters; ++i) {
+    digest.add(values[i]);
+  }
+  digest.compress();
+  folly::doNotOptimizeAway(digest.numCentroids());
+  return iters;
+}
+
+int insertKllSketch(int iters) {
+  std::vector<double> values;
+  BENCHMARK_SUSPEND {
+    populateValues(iters, values);
+  }
+  KllSketch<double> kll;
+  for (int i = 0; i < iters; ++i) {
+    kll.insert(values[i]);
+  }
+  kll.finish();
+  folly::doNotOptimizeAway(kll.totalCount());
+  return iters;
+}
+
+void mergeTDigest(int iters, int maxSize, int count) {
+  std::vector<TDigest<>> digests;
+  BENCHMARK_SUSPEND {
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+      populateValues(maxSize, values);
+      TDigest<> digest;
+      for (auto v : values) {
+        digest.add(v);
+      }
+      digest.compress();
+      digests.push_back(std::move(digest));
+    }
+  }
+  for (int i = 0; i < iters; ++i) {
+    TDigest<> merged;
+    for (const auto& digest : digests) {
+      merged.merge(digest);
+    }
+    merged.compress();
+    folly::doNotOptimizeAway(merged.numCentroids());
+  }
+}
+
+void mergeKllSketch(int iters, int maxSize, int count) {
+  std::vector<KllSketch<double>> sketches;
+  BENCHMARK_SUSPEND {
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+      populateValues(maxSize, values);
+      KllSketch<double> kll;
+      for (auto v : values) {
+        kll.insert(v);
+      }
+      sketches.push_back(std::move(kll));
+    }
+  }
+  for (int i = 0; i < iters; ++i) {
+    KllSketch<double> merged;
+    merged.merge(folly::Range(sketches.data(), sketches.size()));
+    merged.finish();
+    folly::doNotOptimizeAway(merged.totalCount());
+  }
+}
+
+// Prints the rank error at the tail quantiles and the serialized size of both
+// sketches built from the same values.
+void printTailErrors(int size) {
+  std::vector<double> values;
+  populateValues(size, values);
+  TDigest<> digest;
+  KllSketch<double> kll;
+  for (auto v : values) {
+    digest.add(v);
+    kll.insert(v);
+  }
+  digest.compress();
+  kll.finish();
+  std::sort(values.begin(), values.end());
+  auto rankError = [&](double q, double estimate) {
+    auto it = std::upper_bound(values.begin(), values.end(), estimate);
+    return std::abs(double(it - values.begin()) / values.size() - q);
+  };
+  fmt::print(
+      "Rank error of {} lognormal values, t-digest: {} bytes, KLL: {} bytes\n",
+      size,
+      digest.serializedByteSize(),
+      kll.serializedByteSize());
+  for (auto q : {0.5, 0.9, 0.99, 0.999, 0.9999}) {
+    fmt::print(
+        "  p{:<8} t-digest {:.6f}  KLL {:.6f}\n",
+        q * 100,
+        rankError(q, digest.estimateQuantile(q)),
+        rankError(q, kll.estimateQuantile(q)));
+  }
+}
+
+BENCHMARK_PARAM_MULTI(insertTDigest, 1e5);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch, 1e5);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM_MULTI(insertTDigest, 1e6);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch, 1e6);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM_MULTI(insertTDigest, 1e7);
+BENCHMARK_RELATIVE_PARAM_MULTI(insertKllSketch, 1e7);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(mergeTDigest, 1e5x2, 1e5, 2);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e5x2, 1e5, 2);
+BENCHMARK_NAMED_PARAM(mergeTDigest, 1e5x20, 1e5, 20);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e5x20, 1e5, 20);
+BENCHMARK_NAMED_PARAM(mergeTDigest, 1e5x80, 1e5, 80);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e5x80, 1e5, 80);
+
+} // namespace
+} // namespace facebook::velox::functions::tdigest::test
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  facebook::velox::functions::tdigest::test::printTailErrors(1'000'000);
+  folly::runBenchmarks();
+  return 0;
+}
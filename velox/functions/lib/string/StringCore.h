@@ -16,6 +16,7 @@
 #pragma once
 
 #include <cstring>
+#include <limits>
 #include <string>
 #include <string_view>
 #include "folly/CPortability.h"
@@ -71,6 +72,187 @@ FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
   return true;
 }
 
+namespace detail {
+
+using Utf8Batch = xsimd::batch<int8_t>;
+
+/// Returns a mask with bit i set if lane i of 'mask' is true.
+FOLLY_ALWAYS_INLINE uint64_t toUtf8BitMask(xsimd::batch_bool<int8_t> mask) {
+  return static_cast<uint64_t>(simd::toBitMask(mask)) &
+      bits::lowMask(Utf8Batch::size);
+}
+
+/// Returns a mask with bit i set if byte i of the batch at 'input' is not a
+/// UTF-8 continuation byte (10xx_xxxx), i.e. starts a character.
+FOLLY_ALWAYS_INLINE uint64_t charStartMask(const char* input) {
+  auto batch = xsimd::load_unaligned(reinterpret_cast<const int8_t*>(input));
+  // Continuation bytes are 0x80 - 0xBF, which is [-128, -65] as int8_t.
+  return toUtf8BitMask(batch >= xsimd::broadcast<int8_t>(-64));
+}
+
+/// Constraints that a character starting near the end of a 64-byte block puts
+/// on the first bytes of the next block.
+struct Utf8Carry {
+  // Bit i is set if byte i of the next block must be a continuation byte.
+  uint64_t continuations{0};
+  // 1 if the first byte of the next block is the second byte of a character
+  // starting with 0xE0, 0xED, 0xF0 or 0xF4 respectively. These restrict the
+  // range of the second byte.
+  uint64_t afterE0{0};
+  uint64_t afterED{0};
+  uint64_t afterF0{0};
+  uint64_t afterF4{0};
+};
+
+/// Validates the 64 bytes at 'input' as the continuation of the block 'carry'
+/// was computed for. Returns a non-zero mask if the block contains a byte that
+/// is not part of well-formed UTF-8 as defined by RFC 3629, i.e. a byte
+/// tryGetCharLength would not accept. Sets 'continuations' to the mask of
+/// continuation bytes, bit i for byte i, and updates 'carry' for the next
+/// block.
+FOLLY_ALWAYS_INLINE uint64_t utf8BlockErrors(
+    const char* input,
+    Utf8Carry& carry,
+    uint64_t& continuations) {
+  constexpr int32_t kBatchSize = Utf8Batch::size;
+  static_assert(64 % kBatchSize == 0);
+  const auto* data = reinterpret_cast<const int8_t*>(input);
+
+  uint64_t nonAscii = 0;
+  for (auto i = 0; i < 64; i += kBatchSize) {
+    auto batch = xsimd::load_unaligned(data + i);
+    nonAscii |= toUtf8BitMask(batch < xsimd::broadcast<int8_t>(0)) << i;
+  }
+  if (nonAscii == 0 && carry.continuations == 0) {
+    continuations = 0;
+    return 0;
+  }
+
+  // Byte ranges as int8_t: continuation bytes 0x80 - 0xBF are [-128, -65],
+  // lead bytes 0xC2 - 0xDF, 0xE0 - 0xEF and 0xF0 - 0xF4 are [-62, -33],
+  // [-32, -17] and [-16, -12]. 0xC0, 0xC1 and 0xF5 - 0xFF never occur.
+  uint64_t cont = 0;
+  uint64_t below90 = 0;
+  uint64_t belowA0 = 0;
+  uint64_t lead2 = 0;
+  uint64_t lead3 = 0;
+  uint64_t lead4 = 0;
+  uint64_t invalid = 0;
+  uint64_t e0 = 0;
+  uint64_t ed = 0;
+  uint64_t f0 = 0;
+  uint64_t f4 = 0;
+  for (auto i = 0; i < 64; i += kBatchSize) {
+    auto batch = xsimd::load_unaligned(data + i);
+    auto atLeast = [&](int8_t value) {
+      return batch >= xsimd::broadcast<int8_t>(value);
+    };
+    auto below = [&](int8_t value) {
+      return batch < xsimd::broadcast<int8_t>(value);
+    };
+    auto equal = [&](int8_t value) {
+      return toUtf8BitMask(batch == xsimd::broadcast<int8_t>(value)) << i;
+    };
+    cont |= toUtf8BitMask(below(-64)) << i;
+    below90 |= toUtf8BitMask(below(-112)) << i;
+    belowA0 |= toUtf8BitMask(below(-96)) << i;
+    lead2 |= toUtf8BitMask(atLeast(-62) & below(-32)) << i;
+    lead3 |= toUtf8BitMask(atLeast(-32) & below(-16)) << i;
+    lead4 |= toUtf8BitMask(atLeast(-16) & below(-11)) << i;
+    invalid |= toUtf8BitMask(atLeast(-11) | (atLeast(-64) & below(-62))) << i;
+    e0 |= equal(-32);
+    ed |= equal(-19);
+    f0 |= equal(-16);
+    f4 |= equal(-12);
+  }
+
+  // Each lead byte must be followed by exactly the number of continuation
+  // bytes it announces and continuation bytes must not occur elsewhere.
+  const uint64_t lead = lead2 | lead3 | lead4;
+  const uint64_t lead34 = lead3 | lead4;
+  const uint64_t required = (lead << 1) | (lead34 << 2) | (lead4 << 3) |
+      carry.continuations;
+  // Overlong encodings, surrogates and code points above 0x10FFFF.
+  const uint64_t secondByteErrors = (((e0 << 1) | carry.afterE0) & belowA0) |
+      (((ed << 1) | carry.afterED) & cont & ~belowA0) |
+      (((f0 << 1) | carry.afterF0) & below90) |
+      (((f4 << 1) | carry.afterF4) & cont & ~below90);
+
+  carry.continuations = (lead >> 63) | (lead34 >> 62) | (lead4 >> 61);
+  carry.afterE0 = e0 >> 63;
+  carry.afterED = ed >> 63;
+  carry.afterF0 = f0 >> 63;
+  carry.afterF4 = f4 >> 63;
+  continuations = cont;
+  return invalid | (required ^ cont) | secondByteErrors;
+}
+
+} // namespace detail
+
+/// Returns the length in bytes of a prefix of 'input' that consists of
+/// well-formed UTF-8 characters and ends at a character boundary. Sets
+/// 'numChars' to the number of characters in the prefix. Validates 64 bytes
+/// at a time and stops before the first block that contains an invalid byte,
+/// before the trailing partial block and before a block that could take
+/// 'numChars' past 'maxChars'. Callers continue character by character from
+/// the returned offset.
+FOLLY_ALWAYS_INLINE size_t skipValidUtf8(
+    const char* input,
+    size_t size,
+    size_t maxChars,
+    size_t& numChars) {
+  numChars = 0;
+  size_t offset = 0;
+  detail::Utf8Carry carry;
+  uint64_t continuations;
+  while (offset + 64 <= size && numChars + 64 <= maxChars) {
+    auto nextCarry = carry;
+    if (detail::utf8BlockErrors(input + offset, nextCarry, continuations)) {
+      break;
+    }
+    carry = nextCarry;
+    numChars += 64 - __builtin_popcountll(continuations);
+    offset += 64;
+  }
+  if (carry.continuations != 0) {
+    // The last character of the validated blocks continues in the next
+    // block. Back up to its first byte.
+    do {
+      --offset;
+    } while (utf_cont(input[offset]));
+    --numChars;
+  }
+  return offset;
+}
+
+/// Returns the offset of the n-th (0-based) byte in 'input' that is not a
+/// UTF-8 continuation byte, or 'size' if there are not that many.
+FOLLY_ALWAYS_INLINE size_t
+findCharStart(const char* input, size_t size, size_t n) {
+  constexpr int32_t kBatchSize = detail::Utf8Batch::size;
+  size_t i = 0;
+  for (; i + kBatchSize <= size; i += kBatchSize) {
+    auto starts = detail::charStartMask(input + i);
+    const size_t count = __builtin_popcountll(starts);
+    if (n < count) {
+      for (; n > 0; --n) {
+        starts &= starts - 1;
+      }
+      return i + __builtin_ctzll(starts);
+    }
+    n -= count;
+  }
+  for (; i < size; ++i) {
+    if (!utf_cont(input[i])) {
+      if (n == 0) {
+        return i;
+      }
+      --n;
+    }
+  }
+  return size;
+}
+
 /// Perform reverse for ascii string input
 FOLLY_ALWAYS_INLINE static void
 reverseAscii(char* output, const char* input, size_t length) {
@@ -83,8 +265,19 @@ reverseAscii(char* output, const char* input, size_t length) {
 /// Perform reverse for utf8 string input
 FOLLY_ALWAYS_INLINE static void
 reverseUnicode(char* output, const char* input, size_t length) {
-  auto inputIdx = 0;
-  auto outputIdx = length;
+  size_t numChars;
+  const auto validBytes = skipValidUtf8(
+      input, length, std::numeric_limits<size_t>::max(), numChars);
+  size_t inputIdx = 0;
+  size_t outputIdx = length;
+  // Characters in the validated prefix are well-formed. Their sizes follow
+  // from their first bytes without decoding.
+  while (inputIdx < validBytes) {
+    const auto size = utf8proc_char_length(&input[inputIdx]);
+    outputIdx -= size;
+    std::memcpy(&output[outputIdx], &input[inputIdx], size);
+    inputIdx += size;
+  }
   while (inputIdx < length) {
     int size = 1;
     auto valid = utf8proc_codepoint(&input[inputIdx], input + length, size);
@@ -232,10 +425,17 @@ applyAppendersRecursive(TOutStr& output, Func appenderFunc, Funcs... funcs) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 lengthUnicode(const char* inputBuffer, size_t bufferLength) {
+  // Count the bytes that are not continuation bytes a batch at a time.
+  constexpr int32_t kBatchSize = detail::Utf8Batch::size;
+  int64_t size = 0;
+  size_t i = 0;
+  for (; i + kBatchSize <= bufferLength; i += kBatchSize) {
+    size += __builtin_popcountll(detail::charStartMask(inputBuffer + i));
+  }
+
   // First address after the last byte in the buffer
   auto buffEndAddress = inputBuffer + bufferLength;
-  auto currentChar = inputBuffer;
-  int64_t size = 0;
+  auto currentChar = inputBuffer + i;
   while (currentChar < buffEndAddress) {
     // This function detects bytes that come after the first byte in a
     // multi-byte UTF-8 character (provided that the string is valid UTF-8). We
@@ -267,10 +467,14 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 cappedLengthUnicode(const char* input, size_t size, size_t maxChars) {
+  // Skip the leading well-formed characters a block at a time.
+  size_t validChars;
+  const auto validBytes = skipValidUtf8(input, size, maxChars, validChars);
+
   // First address after the last byte in the input
   auto end = input + size;
-  auto currentChar = input;
-  int64_t numChars = 0;
+  auto currentChar = input + validBytes;
+  int64_t numChars = validChars;
 
   // Use maxChars to early stop to avoid calculating the whole
   // length of long string.
@@ -301,8 +505,9 @@ cappedLengthUnicode(const char* input, size_t size, size_t maxChars) {
 ///
 FOLLY_ALWAYS_INLINE int64_t
 cappedByteLengthUnicode(const char* input, size_t size, int64_t maxChars) {
-  size_t utf8Position = 0;
-  size_t numCharacters = 0;
+  // Skip the leading well-formed characters a block at a time.
+  size_t numCharacters;
+  size_t utf8Position = skipValidUtf8(input, size, maxChars, numCharacters);
   while (utf8Position < size && numCharacters < maxChars) {
     auto charSize = utf8proc_char_length(input + utf8Position);
     utf8Position += UNLIKELY(charSize < 0) ? 1 : charSize;
@@ -530,48 +735,26 @@ static inline std::pair<size_t, size_t> getByteRange(
     return std::make_pair(
         startCharPosition - 1, startCharPosition + length - 1);
   } else {
-    size_t startByteIndex = 0;
-    size_t nextCharOffset = 0;
-
-    // Skips any Unicode continuation bytes. These are bytes that appear after
-    // the first byte in a multi-byte Unicode character.  They do not count
-    // towards the position in or length of a string.
-    auto skipContBytes = [&]() {
-      while (nextCharOffset < strLength && utf_cont(str[nextCharOffset])) {
-        nextCharOffset++;
-      }
-    };
-
-    // Skip any invalid continuation bytes at the beginning of the string.
-    skipContBytes();
-
-    // Find startByteIndex
-    for (auto i = 0; nextCharOffset < strLength && i < startCharPosition - 1;
-         i++) {
-      nextCharOffset++;
-
-      skipContBytes();
+    // Leading continuation bytes are skipped. After that, each character
+    // starts at a byte that is not a continuation byte and extends over the
+    // continuation bytes that follow it. These bytes do not count towards the
+    // position in or length of a string.
+    const size_t startByteIndex =
+        findCharStart(str, strLength, startCharPosition - 1);
+    const size_t endByteIndex = startByteIndex +
+        findCharStart(str + startByteIndex, strLength - startByteIndex, length);
+
+    if (endByteIndex == strLength) {
+      VELOX_CHECK_EQ(
+          static_cast<size_t>(
+              lengthUnicode(str + startByteIndex, strLength - startByteIndex)),
+          length,
+          "The substring requested at {} of length {} exceeds the bounds of the string.",
+          startCharPosition,
+          length);
     }
 
-    startByteIndex = nextCharOffset;
-    size_t charCountInRange = 0;
-
-    // Find endByteIndex
-    for (auto i = 0; nextCharOffset < strLength && i < length; i++) {
-      nextCharOffset++;
-      charCountInRange++;
-
-      skipContBytes();
-    }
-
-    VELOX_CHECK_EQ(
-        charCountInRange,
-        length,
-        "The substring requested at {} of length {} exceeds the bounds of the string.",
-        startCharPosition,
-        length);
-
-    return std::make_pair(startByteIndex, nextCharOffset);
+    return std::make_pair(startByteIndex, endByteIndex);
   }
 }
 } // namespace stringCore
@@ -611,6 +611,51 @@ TEST_F(StringImplTest, getByteRange) {
   EXPECT_EQ(range.second, 3);
 }
 
+// Strings longer than a SIMD block exercise the block-at-a-time paths.
+TEST_F(StringImplTest, longUnicode) {
+  // 5 characters in 13 bytes.
+  const std::string pattern = "你好a\U0001F600é";
+  const std::string reversedPattern = "é\U0001F600a好你";
+  std::string input;
+  std::string reversed;
+  for (auto i = 0; i < 50; ++i) {
+    input += pattern;
+    reversed += reversedPattern;
+  }
+
+  ASSERT_EQ(length</*isAscii*/ false>(input), 250);
+  ASSERT_EQ(cappedLength</*isAscii*/ false>(input, 100), 100);
+  ASSERT_EQ(cappedLength</*isAscii*/ false>(input, 1'000), 250);
+  ASSERT_EQ(cappedByteLength</*isAscii*/ false>(input, 100), 260);
+  ASSERT_EQ(cappedByteLength</*isAscii*/ false>(input, 101), 263);
+
+  auto range = getByteRange</*isAscii*/ false>(input.data(), 650, 6, 5);
+  ASSERT_EQ(range.first, 13);
+  ASSERT_EQ(range.second, 26);
+  range = getByteRange</*isAscii*/ false>(input.data(), 650, 101, 150);
+  ASSERT_EQ(range.first, 260);
+  ASSERT_EQ(range.second, 650);
+  VELOX_ASSERT_THROW(
+      getByteRange</*isAscii*/ false>(input.data(), 650, 102, 150),
+      "exceeds the bounds of the string");
+
+  std::string output;
+  reverse</*ascii*/ false>(output, input);
+  ASSERT_EQ(output, reversed);
+
+  // Replace the first byte of the 151st character. The invalid byte and the
+  // 2 orphaned continuation bytes count as one character each.
+  input[390] = '\xFF';
+  ASSERT_EQ(length</*isAscii*/ false>(input), 250);
+  ASSERT_EQ(cappedLength</*isAscii*/ false>(input, 1'000), 252);
+  ASSERT_EQ(cappedByteLength</*isAscii*/ false>(input, 153), 393);
+  reverse</*ascii*/ false>(output, input);
+  ASSERT_EQ(output.substr(0, 257), reversed.substr(0, 257));
+  ASSERT_EQ(
+      output.substr(257, 3), (std::string{input[392], input[391], '\xFF'}));
+  ASSERT_EQ(output.substr(260), reversed.substr(260));
+}
+
 TEST_F(StringImplTest, pad) {
   auto runTest = [](const std::string& string,
                     const int64_t size,
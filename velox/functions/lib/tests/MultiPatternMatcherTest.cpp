@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/MultiPatternMatcher.h"
+
+#include <folly/Random.h>
+#include <folly/String.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+class MultiPatternMatcherTest : public test::FunctionBaseTest {
+ protected:
+  // Evaluates the disjunction of 'conditions' and verifies it matches the
+  // result of evaluating each condition on its own.
+  void testOr(
+      const std::vector<std::string>& conditions,
+      const RowVectorPtr& data) {
+    const auto expression = folly::join(" OR ", conditions);
+    SCOPED_TRACE(expression);
+    auto result = evaluate<SimpleVector<bool>>(expression, data);
+
+    std::vector<std::shared_ptr<SimpleVector<bool>>> expected;
+    for (const auto& condition : conditions) {
+      expected.push_back(evaluate<SimpleVector<bool>>(condition, data));
+    }
+    for (auto row = 0; row < data->size(); ++row) {
+      std::optional<bool> value = false;
+      for (const auto& vector : expected) {
+        if (vector->isNullAt(row)) {
+          if (value == false) {
+            value = std::nullopt;
+          }
+        } else if (vector->valueAt(row)) {
+          value = true;
+        }
+      }
+      ASSERT_EQ(result->isNullAt(row), !value.has_value()) << row;
+      if (value.has_value()) {
+        ASSERT_EQ(result->valueAt(row), value.value()) << row;
+      }
+    }
+  }
+
+  std::string compiled(const std::string& expression, const TypePtr& type) {
+    return compileExpression(expression, asRowType(type))->toString();
+  }
+};
+
+TEST_F(MultiPatternMatcherTest, requiredLiteral) {
+  using detail::requiredLikeLiteral;
+  using detail::requiredRegexLiteral;
+
+  EXPECT_EQ(requiredLikeLiteral("abc", std::nullopt), "abc");
+  EXPECT_EQ(requiredLikeLiteral("%ab_cde%f", std::nullopt), "cde");
+  EXPECT_EQ(requiredLikeLiteral("%a\\%bc%", '\\'), "a%bc");
+  EXPECT_EQ(requiredLikeLiteral("%_%", std::nullopt), "");
+
+  EXPECT_EQ(requiredRegexLiteral("abc"), "abc");
+  EXPECT_EQ(requiredRegexLiteral("abc*"), "ab");
+  EXPECT_EQ(requiredRegexLiteral("ab{2}cd"), "cd");
+  EXPECT_EQ(requiredRegexLiteral("\\d+hello"), "hello");
+  EXPECT_EQ(requiredRegexLiteral("\\.com$"), ".com");
+  EXPECT_EQ(requiredRegexLiteral("x[abc]yz"), "yz");
+  EXPECT_EQ(requiredRegexLiteral("foo(bar|baz)quux"), "quux");
+  EXPECT_EQ(requiredRegexLiteral("err(or)?:"), "err");
+  EXPECT_EQ(requiredRegexLiteral("é?xy"), "xy");
+
+  // Alternations and flags make literals optional.
+  EXPECT_EQ(requiredRegexLiteral("abc|def"), "");
+  EXPECT_EQ(requiredRegexLiteral("(?i)abc"), "");
+  EXPECT_EQ(requiredRegexLiteral("^[0-9]+$"), "");
+  EXPECT_EQ(requiredRegexLiteral("\\x41BC"), "");
+}
+
+TEST_F(MultiPatternMatcherTest, ahoCorasick) {
+  AhoCorasick automaton({"he", "she", "his", "hers"});
+  std::vector<int32_t> matches;
+  EXPECT_FALSE(automaton.search("ushers", [&](int32_t keyword) {
+    matches.push_back(keyword);
+    return false;
+  }));
+  EXPECT_EQ(matches, std::vector<int32_t>({1, 0, 3}));
+
+  matches.clear();
+  EXPECT_TRUE(automaton.search("ushers", [&](int32_t keyword) {
+    matches.push_back(keyword);
+    return true;
+  }));
+  EXPECT_EQ(matches, std::vector<int32_t>({1}));
+
+  EXPECT_FALSE(automaton.search("xyz", [](int32_t) { return true; }));
+  VELOX_ASSERT_THROW(AhoCorasick({"a", "a"}), "Duplicate keyword: a");
+}
+
+TEST_F(MultiPatternMatcherTest, matcher) {
+  MultiPatternMatcher matcher({
+      {"abc", true, std::nullopt},
+      {"pre%", true, std::nullopt},
+      {"%suf", true, std::nullopt},
+      {"%mid%", true, std::nullopt},
+      {"%x_y%", true, std::nullopt},
+      {"%50#%%", true, '#'},
+      {"___", true, std::nullopt},
+      {"er+or", false, std::nullopt},
+      {"^[0-9]+$", false, std::nullopt},
+  });
+  EXPECT_EQ(matcher.numFiltered(), 7);
+  EXPECT_EQ(matcher.numUnfiltered(), 2);
+
+  MultiPatternMatcher::Scratch scratch;
+  auto match = [&](const std::string& input) {
+    return matcher.match(StringView(input), scratch);
+  };
+  EXPECT_TRUE(match("abc"));
+  EXPECT_FALSE(match("abcd"));
+  EXPECT_TRUE(match("prefix"));
+  EXPECT_FALSE(match("a prefix"));
+  EXPECT_TRUE(match("a suf"));
+  EXPECT_FALSE(match("suffix"));
+  EXPECT_TRUE(match("amidst"));
+  EXPECT_TRUE(match("..x\ny.."));
+  EXPECT_TRUE(match("50% off"));
+  EXPECT_FALSE(match("50 off"));
+  EXPECT_TRUE(match("xyz"));
+  EXPECT_TRUE(match("an errrror"));
+  EXPECT_TRUE(match("12345"));
+  EXPECT_FALSE(match("1234a"));
+  EXPECT_FALSE(match(""));
+
+  VELOX_ASSERT_THROW(
+      MultiPatternMatcher({{"a(b", false, std::nullopt}}),
+      "Invalid regular expression");
+  VELOX_ASSERT_THROW(
+      MultiPatternMatcher({{"a#b", true, '#'}}),
+      "Escape character must be followed by");
+}
+
+TEST_F(MultiPatternMatcherTest, rewrite) {
+  const auto type = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+
+  // Three or more patterns on the same column are combined.
+  EXPECT_THAT(
+      compiled(
+          "c0 like 'a%' OR regexp_like(c0, 'b+c') OR c0 like '%d' OR "
+          "c1 like 'e%'",
+          type),
+      ::testing::HasSubstr("$internal$like_any"));
+  EXPECT_THAT(
+      compiled("c0 like 'a%' OR c0 like '%d' OR c1 like 'e%'", type),
+      ::testing::Not(::testing::HasSubstr("$internal$like_any")));
+
+  // Invalid patterns are not combined.
+  EXPECT_THAT(
+      compiled(
+          "c0 like 'a%' OR regexp_like(c0, 'b(') OR c0 like '%d' OR "
+          "c0 like 'x#y' escape '#'",
+          type),
+      ::testing::Not(::testing::HasSubstr("$internal$like_any")));
+}
+
+TEST_F(MultiPatternMatcherTest, evaluate) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"error: disk full",
+           "warning: low memory",
+           std::nullopt,
+           "INFO started",
+           "fatal error",
+           "",
+           "debug 42",
+           "Error 500",
+           "multi\nline"}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9}),
+  });
+
+  testOr(
+      {"c0 like 'error%'",
+       "c0 like '%memory'",
+       "regexp_like(c0, 'fat+al')",
+       "c0 like '%[0-9]%'"},
+      data);
+  testOr(
+      {"c0 like '%disk%'",
+       "regexp_like(c0, '[0-9]+$')",
+       "c0 like 'multi_line'",
+       "c0 like ''",
+       "c1 > 7"},
+      data);
+  testOr(
+      {"c0 like 'E%'",
+       "c0 like '%#%%' escape '#'",
+       "regexp_like(c0, '(?i)info')",
+       "c0 like '______'"},
+      data);
+}
+
+TEST_F(MultiPatternMatcherTest, fuzz) {
+  folly::Random::DefaultGenerator rng(1);
+  auto randomString = [&](const std::string& alphabet, int32_t maxSize) {
+    std::string result;
+    const auto size = folly::Random::rand32(maxSize + 1, rng);
+    for (auto i = 0; i < size; ++i) {
+      result += alphabet[folly::Random::rand32(alphabet.size(), rng)];
+    }
+    return result;
+  };
+
+  const std::vector<std::string> regexps = {
+      "ab+c", "^de", "c.d$", "(ab|cd)e", "a\\.b", "[bc]{2}a", "e?dd", "ba*c"};
+  for (auto i = 0; i < 100; ++i) {
+    std::vector<MultiPatternMatcher::Pattern> patterns;
+    const auto numPatterns = 1 + folly::Random::rand32(20, rng);
+    for (auto j = 0; j < numPatterns; ++j) {
+      if (folly::Random::oneIn(3, rng)) {
+        patterns.push_back(
+            {regexps[folly::Random::rand32(regexps.size(), rng)],
+             false,
+             std::nullopt});
+      } else {
+        patterns.push_back({randomString("abcde%_", 6), true, std::nullopt});
+      }
+    }
+    MultiPatternMatcher matcher(patterns);
+    MultiPatternMatcher::Scratch scratch;
+
+    for (auto j = 0; j < 100; ++j) {
+      const auto input = randomString("abcde.\n", 12);
+      bool expected = false;
+      for (const auto& pattern : patterns) {
+        bool validPattern;
+        RE2 re(
+            pattern.isLike ? "(?s)" +
+                    likePatternToRe2(
+                        StringView(pattern.pattern), std::nullopt, validPattern)
+                           : pattern.pattern,
+            RE2::Quiet);
+        expected |= RE2::PartialMatch(input, re);
+      }
+      ASSERT_EQ(matcher.match(StringView(input), scratch), expected)
+          << input;
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions
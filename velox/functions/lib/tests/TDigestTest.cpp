@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/functions/lib/TDigest.h"
+
+namespace facebook::velox::functions::tdigest::test {
+namespace {
+
+// Returns the fraction of 'sortedValues' that are less than or equal to
+// 'value'.
+double rankOf(const std::vector<double>& sortedValues, double value) {
+  auto it = std::upper_bound(sortedValues.begin(), sortedValues.end(), value);
+  return static_cast<double>(it - sortedValues.begin()) / sortedValues.size();
+}
+
+std::string serialize(const TDigest<>& digest) {
+  std::string data(digest.serializedByteSize(), '\0');
+  digest.serialize(data.data());
+  return data;
+}
+
+// Checks that the estimated quantiles are within 'maxError' of the actual rank
+// at the median and within 'maxTailError' at the tails.
+template <typename Allocator>
+void checkAccuracy(
+    const TDigest<Allocator>& digest,
+    std::vector<double> values,
+    double maxError,
+    double maxTailError) {
+  std::sort(values.begin(), values.end());
+  for (auto q : {0.1, 0.25, 0.5, 0.75, 0.9}) {
+    EXPECT_NEAR(rankOf(values, digest.estimateQuantile(q)), q, maxError) << q;
+  }
+  for (auto q : {0.0001, 0.001, 0.01, 0.99, 0.999, 0.9999}) {
+    EXPECT_NEAR(rankOf(values, digest.estimateQuantile(q)), q, maxTailError)
+        << q;
+  }
+}
+
+class TDigestTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(TDigestTest, empty) {
+  TDigest<> digest;
+  digest.compress();
+  EXPECT_EQ(digest.totalWeight(), 0);
+  EXPECT_EQ(digest.numCentroids(), 0);
+  EXPECT_TRUE(std::isnan(digest.estimateQuantile(0.5)));
+
+  auto data = serialize(digest);
+  auto copy = TDigest<>::deserialize(data.data(), data.size());
+  EXPECT_EQ(copy.totalWeight(), 0);
+  EXPECT_EQ(copy.min(), std::numeric_limits<double>::infinity());
+  EXPECT_EQ(copy.max(), -std::numeric_limits<double>::infinity());
+}
+
+TEST_F(TDigestTest, oneItem) {
+  TDigest<> digest;
+  digest.add(1.0);
+  digest.compress();
+  EXPECT_EQ(digest.totalWeight(), 1);
+  EXPECT_EQ(digest.estimateQuantile(0.0), 1.0);
+  EXPECT_EQ(digest.estimateQuantile(0.5), 1.0);
+  EXPECT_EQ(digest.estimateQuantile(1.0), 1.0);
+}
+
+TEST_F(TDigestTest, smallInput) {
+  // Few values are kept exactly.
+  TDigest<> digest;
+  for (int i = 1; i <= 10; ++i) {
+    digest.add(i);
+  }
+  digest.compress();
+  EXPECT_EQ(digest.numCentroids(), 10);
+  EXPECT_EQ(digest.estimateQuantile(0.0), 1);
+  EXPECT_EQ(digest.estimateQuantile(0.35), 4);
+  EXPECT_EQ(digest.estimateQuantile(1.0), 10);
+}
+
+TEST_F(TDigestTest, accuracy) {
+  constexpr int kSize = 100'000;
+  std::default_random_engine gen(0);
+  std::lognormal_distribution<> dist;
+  std::vector<double> values(kSize);
+  TDigest<> digest;
+  for (auto& value : values) {
+    value = dist(gen);
+    digest.add(value);
+  }
+  digest.compress();
+  EXPECT_EQ(digest.totalWeight(), kSize);
+  EXPECT_LE(digest.numCentroids(), 2 * kDefaultCompression);
+  checkAccuracy(digest, values, 0.01, 0.001);
+
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_EQ(digest.estimateQuantile(0), sorted.front());
+  EXPECT_EQ(digest.estimateQuantile(1), sorted.back());
+}
+
+TEST_F(TDigestTest, weighted) {
+  std::default_random_engine gen(0);
+  std::uniform_real_distribution<> dist;
+  std::vector<double> values;
+  TDigest<> digest;
+  for (int i = 0; i < 10'000; ++i) {
+    const auto value = dist(gen);
+    const auto weight = 1 + i % 5;
+    digest.add(value, weight);
+    values.insert(values.end(), weight, value);
+  }
+  digest.compress();
+  EXPECT_EQ(digest.totalWeight(), values.size());
+  checkAccuracy(digest, values, 0.02, 0.002);
+
+  VELOX_ASSERT_THROW(digest.add(1, 0), "Weight must be positive");
+  VELOX_ASSERT_THROW(
+      digest.add(std::numeric_limits<double>::quiet_NaN()),
+      "Cannot add NaN to t-digest");
+}
+
+TEST_F(TDigestTest, compression) {
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  TDigest<> small;
+  small.setCompression(20);
+  TDigest<> large;
+  large.setCompression(500);
+  std::vector<double> values(100'000);
+  for (auto& value : values) {
+    value = dist(gen);
+    small.add(value);
+    large.add(value);
+  }
+  small.compress();
+  large.compress();
+  EXPECT_LT(small.numCentroids(), large.numCentroids());
+  checkAccuracy(small, values, 0.05, 0.005);
+  checkAccuracy(large, values, 0.002, 0.0005);
+}
+
+TEST_F(TDigestTest, merge) {
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  std::vector<double> values;
+  TDigest<> merged;
+  for (int i = 0; i < 10; ++i) {
+    TDigest<> digest;
+    for (int j = 0; j < 10'000; ++j) {
+      // Shift each digest so that they cover different ranges.
+      const auto value = dist(gen) + i;
+      digest.add(value);
+      values.push_back(value);
+    }
+    if (i % 2 == 0) {
+      digest.compress();
+    }
+    merged.merge(digest);
+  }
+  merged.compress();
+  EXPECT_EQ(merged.totalWeight(), values.size());
+  EXPECT_EQ(merged.min(), *std::min_element(values.begin(), values.end()));
+  EXPECT_EQ(merged.max(), *std::max_element(values.begin(), values.end()));
+  checkAccuracy(merged, values, 0.01, 0.001);
+}
+
+TEST_F(TDigestTest, mergeDeserialized) {
+  std::default_random_engine gen(0);
+  std::exponential_distribution<> dist;
+  std::vector<double> values;
+  std::vector<std::string> serialized;
+  for (int i = 0; i < 10; ++i) {
+    TDigest<> digest;
+    digest.setCompression(200);
+    for (int j = 0; j < 10'000; ++j) {
+      values.push_back(dist(gen));
+      digest.add(values.back());
+    }
+    digest.compress();
+    serialized.push_back(serialize(digest));
+  }
+
+  auto pool = memory::memoryManager()->addLeafPool();
+  HashStringAllocator allocator(pool.get());
+  TDigest<StlAllocator<double>> merged(StlAllocator<double>(&allocator));
+  for (const auto& data : serialized) {
+    merged.mergeDeserialized(data.data(), data.size());
+  }
+  merged.compress();
+  // The compression of the serialized digests is adopted.
+  EXPECT_EQ(merged.compression(), 200);
+  EXPECT_EQ(merged.totalWeight(), values.size());
+  checkAccuracy(merged, values, 0.01, 0.001);
+}
+
+TEST_F(TDigestTest, serializationRoundTrip) {
+  std::default_random_engine gen(0);
+  std::normal_distribution<> dist;
+  TDigest<> digest;
+  digest.setCompression(50);
+  for (int i = 0; i < 10'000; ++i) {
+    digest.add(dist(gen));
+  }
+  digest.compress();
+  auto data = serialize(digest);
+  auto copy = TDigest<>::deserialize(data.data(), data.size());
+  EXPECT_EQ(copy.compression(), 50);
+  EXPECT_EQ(copy.totalWeight(), digest.totalWeight());
+  EXPECT_EQ(copy.numCentroids(), digest.numCentroids());
+  EXPECT_EQ(copy.min(), digest.min());
+  EXPECT_EQ(copy.max(), digest.max());
+  for (auto q : {0.0, 0.01, 0.3, 0.5, 0.999, 1.0}) {
+    EXPECT_EQ(copy.estimateQuantile(q), digest.estimateQuantile(q));
+  }
+  EXPECT_EQ(serialize(copy), data);
+}
+
+TEST_F(TDigestTest, serializationFormat) {
+  TDigest<> digest;
+  digest.add(3);
+  digest.add(1);
+  digest.add(2, 2);
+  digest.compress();
+  auto data = serialize(digest);
+  ASSERT_EQ(data.size(), 2 + 4 * sizeof(double) + sizeof(int32_t) + 48);
+
+  // Layout of Presto's tdigest type: version, value type, min, max,
+  // compression, total weight, number of centroids, weights, means.
+  const char* ptr = data.data();
+  auto next = [&](auto value) {
+    memcpy(&value, ptr, sizeof(value));
+    ptr += sizeof(value);
+    return value;
+  };
+  EXPECT_EQ(next(int8_t()), 1);
+  EXPECT_EQ(next(int8_t()), 0);
+  EXPECT_EQ(next(double()), 1);
+  EXPECT_EQ(next(double()), 3);
+  EXPECT_EQ(next(double()), kDefaultCompression);
+  EXPECT_EQ(next(double()), 4);
+  EXPECT_EQ(next(int32_t()), 3);
+  for (auto weight : {1, 2, 1}) {
+    EXPECT_EQ(next(double()), weight);
+  }
+  for (auto mean : {1, 2, 3}) {
+    EXPECT_EQ(next(double()), mean);
+  }
+
+  data[0] = 2;
+  VELOX_ASSERT_THROW(
+      TDigest<>::deserialize(data.data(), data.size()),
+      "Unsupported t-digest version: 2");
+  data[0] = 1;
+  data[1] = 1;
+  VELOX_ASSERT_THROW(
+      TDigest<>::deserialize(data.data(), data.size()),
+      "Unsupported t-digest type: 1");
+}
+
+TEST_F(TDigestTest, malformed) {
+  TDigest<> digest;
+  digest.add(1);
+  digest.add(2);
+  digest.compress();
+  const auto data = serialize(digest);
+  constexpr size_t kHeaderSize = 2 + 4 * sizeof(double) + sizeof(int32_t);
+  constexpr size_t kCompressionOffset = 2 + 2 * sizeof(double);
+  constexpr size_t kNumCentroidsOffset = kHeaderSize - sizeof(int32_t);
+
+  auto expectInvalid = [](const std::string& bad, const std::string& message) {
+    VELOX_ASSERT_USER_THROW(
+        TDigest<>::deserialize(bad.data(), bad.size()), message);
+    TDigest<> merged;
+    VELOX_ASSERT_USER_THROW(
+        merged.mergeDeserialized(bad.data(), bad.size()), message);
+  };
+
+  // Truncated inside the header and inside the centroids.
+  expectInvalid("", "T-digest is too short");
+  expectInvalid(data.substr(0, kHeaderSize - 1), "T-digest is too short");
+  expectInvalid(
+      data.substr(0, data.size() - 1),
+      "T-digest size does not match the number of centroids");
+  expectInvalid(
+      data + std::string(8, '\0'),
+      "T-digest size does not match the number of centroids");
+
+  // Number of centroids larger than the data or negative.
+  auto withNumCentroids = [&](int32_t numCentroids) {
+    auto bad = data;
+    memcpy(bad.data() + kNumCentroidsOffset, &numCentroids, sizeof(int32_t));
+    return bad;
+  };
+  expectInvalid(
+      withNumCentroids(1'000'000),
+      "T-digest size does not match the number of centroids");
+  expectInvalid(
+      withNumCentroids(std::numeric_limits<int32_t>::max()),
+      "T-digest size does not match the number of centroids");
+  expectInvalid(withNumCentroids(-1), "(-1 vs. 0)");
+
+  // Compression that is not positive.
+  for (double compression :
+       {0.0, -1.0, std::numeric_limits<double>::quiet_NaN()}) {
+    auto bad = data;
+    memcpy(bad.data() + kCompressionOffset, &compression, sizeof(double));
+    expectInvalid(bad, "Invalid t-digest compression");
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions::tdigest::test
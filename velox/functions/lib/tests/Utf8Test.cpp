@@ -95,5 +95,41 @@ TEST(Utf8Test, tryCharLength) {
   ASSERT_EQ(-1, tryCharLength({0xBF}));
 }
 
+TEST(Utf8Test, findInvalidUtf8) {
+  auto findInvalid = [](const std::string& input) {
+    return findInvalidUtf8(input.data(), input.size());
+  };
+
+  ASSERT_EQ(0, findInvalid(""));
+  ASSERT_EQ(100, findInvalid(std::string(100, 'a')));
+
+  // 150 bytes of 3-byte characters. Euro sign.
+  std::string euros;
+  for (auto i = 0; i < 50; ++i) {
+    euros += "\u20AC";
+  }
+  ASSERT_EQ(150, findInvalid(euros));
+
+  // Invalid continuation byte in the second 64-byte block. The character
+  // starts at byte 99.
+  auto input = euros;
+  input[100] = '\xFF';
+  ASSERT_EQ(99, findInvalid(input));
+
+  // Truncated last character.
+  ASSERT_EQ(147, findInvalid(euros.substr(0, 149)));
+
+  // Surrogate at the start of the second block.
+  ASSERT_EQ(64, findInvalid(std::string(64, 'a') + "\xED\xA0\x80"));
+
+  // Overlong encoding across the first block boundary.
+  ASSERT_EQ(63, findInvalid(std::string(63, 'a') + "\xE0\x80\x80" + "abc"));
+
+  // 4-byte character across the first block boundary followed by a code point
+  // above 0x10FFFF.
+  input = std::string(62, 'a') + "\U0001D122" + "\xF4\x90\x80\x80";
+  ASSERT_EQ(66, findInvalid(input));
+}
+
 } // namespace
 } // namespace facebook::velox::functions
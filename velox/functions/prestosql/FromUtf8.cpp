@@ -185,17 +185,9 @@ class FromUtf8Function : public exec::VectorFunction {
     std::optional<vector_size_t> firstInvalidRow;
     rows.testSelected([&](auto row) {
       auto value = decodedInput.valueAt<StringView>(row);
-
-      int32_t pos = 0;
-      while (pos < value.size()) {
-        auto charLength =
-            tryGetCharLength(value.data() + pos, value.size() - pos);
-        if (charLength < 0) {
-          firstInvalidRow = row;
-          return false;
-        }
-
-        pos += charLength;
+      if (findInvalidUtf8(value.data(), value.size()) < value.size()) {
+        firstInvalidRow = row;
+        return false;
       }
 
       return true;
@@ -267,14 +259,20 @@ class FromUtf8Function : public exec::VectorFunction {
 
     int32_t pos = 0;
     while (pos < input.size()) {
-      auto charLength =
-          tryGetCharLength(input.data() + pos, input.size() - pos);
-      if (charLength > 0) {
-        fixedWriter.append(std::string_view(input.data() + pos, charLength));
-        pos += charLength;
-        continue;
+      // Copy the valid characters up to the next invalid sequence at once.
+      auto validLength =
+          findInvalidUtf8(input.data() + pos, input.size() - pos);
+      if (validLength > 0) {
+        fixedWriter.append(std::string_view(input.data() + pos, validLength));
+        pos += validLength;
+        if (pos == input.size()) {
+          break;
+        }
       }
 
+      auto charLength =
+          tryGetCharLength(input.data() + pos, input.size() - pos);
+      VELOX_DCHECK_LT(charLength, 0);
       if (!replacement.empty()) {
         fixedWriter.append(replacement);
       }
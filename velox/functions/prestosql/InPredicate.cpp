@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstring>
+#include <numeric>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
@@ -299,6 +303,227 @@ std::pair<std::unique_ptr<common::Filter>, bool> createBytesValuesFilter(
   return {std::make_unique<common::BytesValues>(values, nullAllowed), false};
 }
 
+// Set of constant strings for VARCHAR and VARBINARY IN-lists with 2 or more
+// distinct values. Probes whose length does not occur in the list are
+// rejected first. Lists of up to kMaxScanValues inline strings are then
+// searched by comparing the 16 bytes of the probe's StringView with all values
+// using SIMD. Longer lists use a perfect hash built by hash and displace:
+// values are grouped into buckets by hash and each bucket gets a displacement
+// that places all of its values in distinct free slots. A lookup is then one
+// hash, one slot and one StringView compare, which checks size and the 4-byte
+// prefix before the rest of the string.
+class StringValuesSet {
+ public:
+  /// Returns nullptr if the list has fewer than 2 distinct non-null values or
+  /// if no perfect hash was found. BytesValues filter is used in these cases.
+  static std::unique_ptr<StringValuesSet> create(
+      const VectorPtr& valuesVector,
+      vector_size_t offset,
+      vector_size_t size);
+
+  bool nullAllowed() const {
+    return nullAllowed_;
+  }
+
+  bool contains(StringView value) const {
+    const auto lengthBit = std::min<uint32_t>(value.size(), kMaxLengthBit);
+    if ((lengthMask_ & (1ULL << lengthBit)) == 0) {
+      return false;
+    }
+    if (!scanFirstWords_.empty()) {
+      return scanContains(value);
+    }
+    const auto hash = hashValue(value);
+    const auto displacement = displacements_[hash & bucketMask_];
+    return slots_[slotIndex(hash, displacement)] == value;
+  }
+
+ private:
+  static constexpr uint32_t kMaxLengthBit = 63;
+  static constexpr size_t kMaxScanValues = 32;
+  static constexpr uint32_t kMaxDisplacement = 1 << 16;
+
+  StringValuesSet(std::vector<std::string> values, bool nullAllowed)
+      : values_(std::move(values)), nullAllowed_(nullAllowed) {}
+
+  // Returns the 16 bytes of inline StringView 'value'. Bytes past the end of
+  // a string of at most 4 characters are not guaranteed to be zero, so the
+  // second word is zeroed for these.
+  static std::pair<int64_t, int64_t> inlineWords(StringView value) {
+    int64_t words[2];
+    std::memcpy(words, &value, sizeof(words));
+    if (value.size() <= StringView::kPrefixSize) {
+      words[1] = 0;
+    }
+    return {words[0], words[1]};
+  }
+
+  static uint64_t hashValue(StringView value) {
+    if (value.isInline()) {
+      const auto [first, second] = inlineWords(value);
+      return bits::hashMix(first, second);
+    }
+    return bits::hashBytes(value.size(), value.data(), value.size());
+  }
+
+  uint64_t slotIndex(uint64_t hash, uint32_t displacement) const {
+    return ((hash ^ (displacement * 0x9e3779b97f4a7c15ULL)) *
+            0xff51afd7ed558ccdULL) >>
+        slotShift_;
+  }
+
+  bool scanContains(StringView value) const {
+    if (!value.isInline()) {
+      return false;
+    }
+    const auto [first, second] = inlineWords(value);
+    const auto firstWords = xsimd::broadcast<int64_t>(first);
+    const auto secondWords = xsimd::broadcast<int64_t>(second);
+    constexpr auto kBatchSize = xsimd::batch<int64_t>::size;
+    for (size_t i = 0; i < scanFirstWords_.size(); i += kBatchSize) {
+      const auto matches =
+          (xsimd::load_unaligned(scanFirstWords_.data() + i) == firstWords) &
+          (xsimd::load_unaligned(scanSecondWords_.data() + i) == secondWords);
+      if (simd::toBitMask(matches)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Fills 'scanFirstWords_' and 'scanSecondWords_'. The arrays are padded to
+  // a multiple of the batch size by repeating the first value, which does not
+  // change the result of a lookup.
+  void buildScan(const std::vector<StringView>& views) {
+    constexpr auto kBatchSize = xsimd::batch<int64_t>::size;
+    const auto paddedSize = bits::roundUp(views.size(), kBatchSize);
+    scanFirstWords_.reserve(paddedSize);
+    scanSecondWords_.reserve(paddedSize);
+    for (size_t i = 0; i < paddedSize; ++i) {
+      const auto [first, second] =
+          inlineWords(views[i < views.size() ? i : 0]);
+      scanFirstWords_.push_back(first);
+      scanSecondWords_.push_back(second);
+    }
+  }
+
+  // Places all values in 'slots_'. Empty slots hold the first value, so that
+  // a probe landing on one matches only if it is in the set. Returns false if
+  // some bucket could not be placed.
+  bool buildPerfectHash(const std::vector<StringView>& views) {
+    const auto numValues = views.size();
+    const auto numSlots = bits::nextPowerOfTwo(numValues + numValues / 4);
+    const auto numBuckets =
+        bits::nextPowerOfTwo(std::max<uint64_t>(numValues / 4, 1));
+    slotShift_ = 64 - __builtin_ctzll(numSlots);
+    bucketMask_ = numBuckets - 1;
+
+    std::vector<uint64_t> hashes(numValues);
+    std::vector<std::vector<int32_t>> buckets(numBuckets);
+    for (size_t i = 0; i < numValues; ++i) {
+      hashes[i] = hashValue(views[i]);
+      buckets[hashes[i] & bucketMask_].push_back(i);
+    }
+
+    // Places the largest buckets first, while most slots are free.
+    std::vector<int32_t> order(numBuckets);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto left, auto right) {
+      return buckets[left].size() > buckets[right].size();
+    });
+
+    displacements_.assign(numBuckets, 0);
+    slots_.assign(numSlots, views[0]);
+    std::vector<bool> usedSlots(numSlots);
+    std::vector<uint64_t> bucketSlots;
+    for (auto bucket : order) {
+      const auto& members = buckets[bucket];
+      if (members.empty()) {
+        break;
+      }
+      bool placed = false;
+      for (uint32_t displacement = 0;
+           !placed && displacement < kMaxDisplacement;
+           ++displacement) {
+        bucketSlots.clear();
+        placed = true;
+        for (auto member : members) {
+          const auto slot = slotIndex(hashes[member], displacement);
+          if (usedSlots[slot] ||
+              std::find(bucketSlots.begin(), bucketSlots.end(), slot) !=
+                  bucketSlots.end()) {
+            placed = false;
+            break;
+          }
+          bucketSlots.push_back(slot);
+        }
+        if (placed) {
+          displacements_[bucket] = displacement;
+        }
+      }
+      if (!placed) {
+        return false;
+      }
+      for (size_t i = 0; i < members.size(); ++i) {
+        usedSlots[bucketSlots[i]] = true;
+        slots_[bucketSlots[i]] = views[members[i]];
+      }
+    }
+    return true;
+  }
+
+  // Owns the strings referenced by the StringViews below.
+  const std::vector<std::string> values_;
+  const bool nullAllowed_;
+
+  // Bit i is set if a value has length i. Bit kMaxLengthBit stands for all
+  // lengths from kMaxLengthBit up.
+  uint64_t lengthMask_{0};
+
+  // First and second 8 bytes of the StringViews of all values if the list is
+  // searched by scanning. Empty otherwise.
+  std::vector<int64_t> scanFirstWords_;
+  std::vector<int64_t> scanSecondWords_;
+
+  // Perfect hash. A value with hash 'h' is in slot
+  // slotIndex(h, displacements_[h & bucketMask_]).
+  std::vector<uint32_t> displacements_;
+  std::vector<StringView> slots_;
+  uint64_t bucketMask_{0};
+  int32_t slotShift_{0};
+};
+
+std::unique_ptr<StringValuesSet> StringValuesSet::create(
+    const VectorPtr& valuesVector,
+    vector_size_t offset,
+    vector_size_t size) {
+  auto [values, nullAllowed] =
+      toValues<std::string, StringView>(valuesVector, offset, size);
+  if (values.size() < 2) {
+    return nullptr;
+  }
+
+  std::unique_ptr<StringValuesSet> set(
+      new StringValuesSet(std::move(values), nullAllowed));
+  std::vector<StringView> views;
+  views.reserve(set->values_.size());
+  bool allInline = true;
+  for (const auto& value : set->values_) {
+    views.emplace_back(value);
+    allInline &= views.back().isInline();
+    set->lengthMask_ |= 1ULL << std::min<uint32_t>(value.size(), kMaxLengthBit);
+  }
+
+  if (allInline && views.size() <= kMaxScanValues) {
+    set->buildScan(views);
+    return set;
+  }
+  if (!set->buildPerfectHash(views)) {
+    return nullptr;
+  }
+  return set;
+}
+
 /// x IN (2, null) returns null when x != 2 and true when x == 2.
 /// Null for x always produces null, regardless of 'IN' list.
 class InPredicate : public exec::VectorFunction {
@@ -306,6 +531,9 @@ class InPredicate : public exec::VectorFunction {
   explicit InPredicate(std::unique_ptr<common::Filter> filter, bool alwaysNull)
       : filter_{std::move(filter)}, alwaysNull_(alwaysNull) {}
 
+  explicit InPredicate(std::unique_ptr<StringValuesSet> stringValues)
+      : alwaysNull_(false), stringValues_{std::move(stringValues)} {}
+
   static std::shared_ptr<exec::VectorFunction> create(
       const std::string& /*name*/,
       const std::vector<exec::VectorFunctionArg>& inputArgs,
@@ -382,6 +610,10 @@ class InPredicate : public exec::VectorFunction {
         break;
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
+        if (auto stringValues =
+                StringValuesSet::create(elements, offset, size)) {
+          return std::make_shared<InPredicate>(std::move(stringValues));
+        }
         filter = createBytesValuesFilter(elements, offset, size);
         break;
       case TypeKind::UNKNOWN:
@@ -480,6 +712,13 @@ class InPredicate : public exec::VectorFunction {
         break;
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
+        if (stringValues_) {
+          applyTyped<StringView>(
+              rows, input, context, result, [&](StringView value) {
+                return stringValues_->contains(value);
+              });
+          break;
+        }
         applyTyped<StringView>(
             rows, input, context, result, [&](StringView value) {
               return filter_->testBytes(value.data(), value.size());
@@ -531,10 +770,13 @@ class InPredicate : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result,
       F&& testFunction) const {
-    VELOX_CHECK(filter_, "IN predicate supports only constant IN list");
+    VELOX_CHECK(
+        filter_ || stringValues_,
+        "IN predicate supports only constant IN list");
 
     // Indicates whether result can be true or null only, e.g. no false results.
-    const bool passOrNull = filter_->testNull();
+    const bool passOrNull =
+        filter_ ? filter_->testNull() : stringValues_->nullAllowed();
 
     if (arg->isConstantEncoding()) {
       auto simpleArg = arg->asUnchecked<SimpleVector<T>>();
@@ -586,6 +828,9 @@ class InPredicate : public exec::VectorFunction {
 
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
+
+  // Set for VARCHAR and VARBINARY IN-lists. If set, 'filter_' is null.
+  const std::unique_ptr<StringValuesSet> stringValues_;
 };
 } // namespace
 
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/JsonExtractScalars.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/functions/lib/SubscriptUtil.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+const std::string kJsonExtractScalars = "$internal$json_extract_scalars";
+const std::string kJsonExtractScalarAt = "$internal$json_extract_scalar_at";
+
+class JsonExtractScalarsFunction final : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarsFunction(
+      std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const final {
+    VELOX_CHECK_EQ(args.size(), 2);
+    const vector_size_t numPaths = extractors_.size();
+    auto* pool = context.pool();
+
+    auto elements = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), rows.end() * numPaths, pool);
+    auto offsets = allocateOffsets(rows.end(), pool);
+    auto sizes = allocateSizes(rows.end(), pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+
+    exec::DecodedArgs decodedArgs(rows, {args[0]}, context);
+    auto* json = decodedArgs.at(0);
+    std::optional<std::string> value;
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      const auto offset = row * numPaths;
+      rawOffsets[row] = offset;
+      rawSizes[row] = numPaths;
+
+      const auto jsonString = json->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(jsonString.data(), jsonString.size());
+      simdjson::ondemand::document jsonDoc;
+      bool needsParse = true;
+      for (auto i = 0; i < numPaths; ++i) {
+        if (needsParse) {
+          if (simdjsonParse(paddedJson).get(jsonDoc)) {
+            for (auto j = i; j < numPaths; ++j) {
+              elements->setNull(offset + j, true);
+            }
+            return;
+          }
+          needsParse = false;
+        } else {
+          jsonDoc.rewind();
+        }
+
+        value.reset();
+        if (extractJsonScalar(jsonDoc, *extractors_[i], value) ==
+                simdjson::SUCCESS &&
+            value.has_value()) {
+          elements->set(offset + i, StringView(*value));
+        } else {
+          elements->setNull(offset + i, true);
+          // On-demand parsing validates the document lazily, so the iterator
+          // may be left in an error state. Parse again to evaluate the next
+          // path exactly like a separate json_extract_scalar call would.
+          needsParse = true;
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<ArrayVector>(
+        pool,
+        outputType,
+        nullptr,
+        rows.end(),
+        std::move(offsets),
+        std::move(sizes),
+        std::move(elements));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  const std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+};
+
+class JsonExtractScalarAtFunction : public SubscriptImpl<
+                                        /* allowNegativeIndices */ false,
+                                        /* nullOnNegativeIndices */ false,
+                                        /* allowOutOfBound */ false,
+                                        /* indexStartsAtOne */ true> {
+ public:
+  JsonExtractScalarAtFunction() : SubscriptImpl(false) {}
+};
+
+struct ExtractScalarCall {
+  core::TypedExprPtr input;
+  std::string path;
+};
+
+// Returns the column and path of a json_extract_scalar call with a constant
+// and valid path on a column.
+std::optional<ExtractScalarCall> asExtractScalarCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != prefix + "json_extract_scalar" ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto& inputs = call->inputs();
+
+  // Only columns are combined as evaluating an arbitrary expression once
+  // instead of once per call may change the result, e.g. for rand().
+  if (dynamic_cast<const core::FieldAccessTypedExpr*>(inputs[0].get()) ==
+      nullptr) {
+    return std::nullopt;
+  }
+
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(inputs[1].get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->hasValueVector() || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  auto path = constant->value().value<TypeKind::VARCHAR>();
+
+  // Calls with invalid paths are left as is to raise the same error.
+  try {
+    SIMDJsonExtractor::create(path);
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return ExtractScalarCall{inputs[0], std::move(path)};
+}
+
+struct PathGroup {
+  core::TypedExprPtr input;
+  std::vector<std::string> paths;
+  // The shared $internal$json_extract_scalars call. Null if 'paths' has a
+  // single entry and the calls are not rewritten.
+  core::TypedExprPtr extractScalars;
+};
+
+PathGroup* findGroup(
+    std::vector<PathGroup>& groups,
+    const core::ITypedExpr& input) {
+  for (auto& group : groups) {
+    if (*group.input == input) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+bool canRebuild(const core::TypedExprPtr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(expr.get()) != nullptr ||
+      dynamic_cast<const core::CastTypedExpr*>(expr.get()) != nullptr;
+}
+
+// Collects the paths used with each column. Only descends into the
+// expressions replaceCalls can rebuild.
+void collectCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  if (auto extract = asExtractScalarCall(prefix, expr)) {
+    auto* group = findGroup(groups, *extract->input);
+    if (group == nullptr) {
+      groups.push_back({extract->input, {}, nullptr});
+      group = &groups.back();
+    }
+    auto& paths = group->paths;
+    if (std::find(paths.begin(), paths.end(), extract->path) == paths.end()) {
+      paths.push_back(std::move(extract->path));
+    }
+    return;
+  }
+  if (canRebuild(expr)) {
+    for (const auto& input : expr->inputs()) {
+      collectCalls(prefix, input, groups);
+    }
+  }
+}
+
+core::TypedExprPtr replaceCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  if (auto extract = asExtractScalarCall(prefix, expr)) {
+    const auto* group = findGroup(groups, *extract->input);
+    VELOX_CHECK_NOT_NULL(group);
+    if (group->extractScalars == nullptr) {
+      return expr;
+    }
+    const auto& paths = group->paths;
+    const int64_t index =
+        std::find(paths.begin(), paths.end(), extract->path) - paths.begin();
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(),
+        std::vector<core::TypedExprPtr>{
+            group->extractScalars,
+            std::make_shared<core::ConstantTypedExpr>(BIGINT(), index + 1)},
+        kJsonExtractScalarAt);
+  }
+
+  if (!canRebuild(expr)) {
+    return expr;
+  }
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceCalls(prefix, input, groups));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  return std::make_shared<core::CallTypedExpr>(
+      call->type(), std::move(inputs), call->name());
+}
+
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalars(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 2, "{} requires 2 arguments", name);
+  const auto& paths = inputArgs[1].constantValue;
+  VELOX_USER_CHECK(
+      paths != nullptr && !paths->isNullAt(0),
+      "{} requires a constant non-null array of paths",
+      name);
+  const auto* array = paths->wrappedVector()->as<ArrayVector>();
+  const auto index = paths->wrappedIndex(0);
+  const auto offset = array->offsetAt(index);
+  const auto size = array->sizeAt(index);
+  const auto* elements = array->elements()->as<SimpleVector<StringView>>();
+
+  std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors;
+  extractors.reserve(size);
+  for (auto i = offset; i < offset + size; ++i) {
+    VELOX_USER_CHECK(!elements->isNullAt(i), "{} paths must not be null", name);
+    const auto path = elements->valueAt(i);
+    extractors.push_back(SIMDJsonExtractor::create(path));
+  }
+  return std::make_shared<JsonExtractScalarsFunction>(std::move(extractors));
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarsSignatures() {
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  // json|varchar, array(varchar) -> array(varchar)
+  for (const auto& inputType : {"json", "varchar"}) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .returnType("array(varchar)")
+                             .argumentType(inputType)
+                             .constantArgumentType("array(varchar)")
+                             .build());
+  }
+  return signatures;
+}
+
+void registerJsonExtractScalarAt(const std::string& name) {
+  exec::registerStatefulVectorFunction(
+      name,
+      {exec::FunctionSignatureBuilder()
+           .returnType("varchar")
+           .argumentType("array(varchar)")
+           .argumentType("bigint")
+           .build()},
+      [](const std::string&,
+         const std::vector<exec::VectorFunctionArg>&,
+         const core::QueryConfig&) {
+        static const auto kInstance =
+            std::make_shared<JsonExtractScalarAtFunction>();
+        return kInstance;
+      });
+}
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<PathGroup> groups;
+  for (const auto& expr : exprs) {
+    collectCalls(prefix, expr, groups);
+  }
+
+  bool rewrite = false;
+  for (auto& group : groups) {
+    if (group.paths.size() < 2) {
+      continue;
+    }
+    std::vector<variant> paths(group.paths.begin(), group.paths.end());
+    group.extractScalars = std::make_shared<core::CallTypedExpr>(
+        ARRAY(VARCHAR()),
+        std::vector<core::TypedExprPtr>{
+            group.input,
+            std::make_shared<core::ConstantTypedExpr>(
+                ARRAY(VARCHAR()), variant::array(std::move(paths)))},
+        kJsonExtractScalars);
+    rewrite = true;
+  }
+  if (!rewrite) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(replaceCalls(prefix, expr, groups));
+  }
+  return rewritten;
+}
+
+} // namespace facebook::velox::functions
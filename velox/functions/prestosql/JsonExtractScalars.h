@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// $internal$json_extract_scalars(json, array(varchar)) -> array(varchar)
+///
+/// Returns json_extract_scalar(json, path) for each of the constant 'paths' as
+/// an array. Parses each document only once and rewinds it between the paths.
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalars(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarsSignatures();
+
+/// Registers $internal$json_extract_scalar_at(array(varchar), bigint) ->
+/// varchar, which returns the 1-based element of an array produced by
+/// $internal$json_extract_scalars.
+void registerJsonExtractScalarAt(const std::string& name);
+
+/// Finds json_extract_scalar calls with constant paths on the same column
+/// across all expressions of an ExprSet. If a column is queried for two or
+/// more distinct paths, rewrites each of these calls
+///
+///     json_extract_scalar(c, '$.a')
+///
+/// into
+///
+///     $internal$json_extract_scalar_at(
+///         $internal$json_extract_scalars(c, ARRAY['$.a', '$.b', ...]), 1)
+///
+/// Since the $internal$json_extract_scalars call is identical in all rewritten
+/// expressions, common subexpression elimination evaluates it once per batch.
+/// Each path is evaluated exactly like json_extract_scalar does, so paths with
+/// wildcards are combined too and still return null unless they match a
+/// single scalar. Calls with invalid paths and calls inside lambdas are left
+/// as is.
+///
+/// Returns the new expressions or an empty vector if rewrite is not possible.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
@@ -50,6 +50,12 @@ void checkArraySizes(
 /// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
 /// vector.
+/// For n > 0, 'arrayRows' must hold the rows selected for the (n-1)-th
+/// elements. Only these rows are visited, so the total work over all steps is
+/// proportional to the number of elements rather than the number of rows times
+/// the size of the largest array. Entries of 'elementIndices' for rows that
+/// are not selected are left as is; they are either zero or point to an
+/// earlier element of the same array.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
@@ -63,17 +69,27 @@ bool toNthElementRows(
 
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
-
-  rows.applyToSelected([&](auto row) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
+  if (n == 0) {
+    arrayRows.clearAll();
+    rows.applyToSelected([&](auto row) {
+      if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
+        if (rawSizes[row] > 0) {
+          arrayRows.setValid(row, true);
+          rawElementIndices[row] = rawOffsets[row];
+        }
+      }
+    });
+  } else {
+    // Clearing bits of 'arrayRows' while iterating over it is safe since
+    // applyToSelected works on a copy of each 64-bit word.
+    arrayRows.applyToSelected([&](auto row) {
       if (n < rawSizes[row]) {
-        arrayRows.setValid(row, true);
         rawElementIndices[row] = rawOffsets[row] + n;
+      } else {
+        arrayRows.setValid(row, false);
       }
-    }
-  });
+    });
+  }
   arrayRows.updateBounds();
 
   return arrayRows.hasSelections();
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/functions/Macros.h"
+#include "velox/functions/lib/TDigest.h"
+#include "velox/functions/prestosql/types/TDigestType.h"
+
+namespace facebook::velox::functions {
+
+namespace detail {
+FOLLY_ALWAYS_INLINE void checkQuantile(double quantile) {
+  VELOX_USER_CHECK(
+      0 <= quantile && quantile <= 1,
+      "Quantile should be within bounds [0, 1], was: {}",
+      quantile);
+}
+} // namespace detail
+
+/// value_at_quantile(tdigest, quantile) -> double
+template <typename T>
+struct ValueAtQuantileFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(
+      out_type<double>& result,
+      const arg_type<TDigest>& digest,
+      const arg_type<double>& quantile) {
+    detail::checkQuantile(quantile);
+    const auto tdigest =
+        tdigest::TDigest<>::deserialize(digest.data(), digest.size());
+    result = tdigest.estimateQuantile(quantile);
+  }
+};
+
+/// values_at_quantiles(tdigest, array(quantile)) -> array(double)
+template <typename T>
+struct ValuesAtQuantilesFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(
+      out_type<Array<double>>& result,
+      const arg_type<TDigest>& digest,
+      const arg_type<Array<double>>& quantiles) {
+    const auto tdigest =
+        tdigest::TDigest<>::deserialize(digest.data(), digest.size());
+    result.reserve(quantiles.size());
+    for (const auto& quantile : quantiles) {
+      VELOX_USER_CHECK(
+          quantile.has_value(), "All quantiles should be non-null.");
+      detail::checkQuantile(quantile.value());
+      result.push_back(tdigest.estimateQuantile(quantile.value()));
+    }
+  }
+};
+
+} // namespace facebook::velox::functions
@@ -23,7 +23,9 @@
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
+#include "velox/functions/prestosql/aggregates/TDigestAggregate.h"
 #include "velox/functions/prestosql/types/HyperLogLogType.h"
+#include "velox/functions/prestosql/types/TDigestType.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 
@@ -452,6 +454,12 @@ exec::AggregateRegistrationResult registerApproxDistinct(
                              .intermediateType("varbinary")
                              .argumentType("hyperloglog")
                              .build());
+    // merge(tdigest) shares the name, so its signature is registered here.
+    signatures.push_back(exec::AggregateFunctionSignatureBuilder()
+                             .returnType("tdigest")
+                             .intermediateType("varbinary")
+                             .argumentType("tdigest")
+                             .build());
   } else {
     for (const auto& inputType :
          {"boolean",
@@ -505,6 +513,9 @@ exec::AggregateRegistrationResult registerApproxDistinct(
           const TypePtr& resultType,
           const core::QueryConfig& /*config*/)
           -> std::unique_ptr<exec::Aggregate> {
+        if (hllAsRawInput && isTDigestType(argTypes[0])) {
+          return createTDigestMergeAggregate(resultType);
+        }
         return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
             createApproxDistinct,
             argTypes[0]->kind(),
@@ -524,6 +535,7 @@ void registerApproxDistinctAggregates(
     bool withCompanionFunctions,
     bool overwrite) {
   registerHyperLogLogType();
+  registerTDigestType();
   registerApproxDistinct(
       prefix + kApproxDistinct,
       false,
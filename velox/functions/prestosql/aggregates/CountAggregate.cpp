@@ -46,12 +46,23 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
+    const bool useGroupRuns =
+        rows.isAllSelected() && hasGroupRuns(groups, rows.end());
     if (args.empty()) {
+      if (useGroupRuns) {
+        addGroupRuns(groups, rows.end(), nullptr);
+        return;
+      }
       rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
       return;
     }
 
     DecodedVector decoded(*args[0], rows);
+    if (useGroupRuns && !decoded.isConstantMapping()) {
+      addGroupRuns(groups, rows.end(), decoded.nulls(&rows));
+      return;
+    }
+
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
         rows.applyToSelected(
@@ -95,6 +106,10 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       if (!decoded.isNullAt(0)) {
         addToGroup(group, rows.countSelected());
       }
+    } else if (decoded.mayHaveNulls() && rows.isAllSelected()) {
+      addToGroup(
+          group,
+          rows.end() - bits::countNulls(decoded.nulls(&rows), 0, rows.end()));
     } else if (decoded.mayHaveNulls()) {
       int64_t nonNullCount = 0;
       rows.applyToSelected([&](vector_size_t i) {
@@ -146,6 +161,18 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  // Adds the number of non-null rows in each run of rows in the same group.
+  // 'nulls' is nullptr if there are no nulls.
+  void
+  addGroupRuns(char** groups, vector_size_t numRows, const uint64_t* nulls) {
+    forEachGroupRun(groups, numRows, [&](auto begin, auto end) {
+      addToGroup(
+          groups[begin],
+          nulls == nullptr ? end - begin
+                           : bits::countBits(nulls, begin, end));
+    });
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/aggregates/TDigestAggregate.h"
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/expression/FunctionSignature.h"
+#include "velox/functions/lib/TDigest.h"
+#include "velox/functions/prestosql/aggregates/AggregateNames.h"
+#include "velox/functions/prestosql/types/TDigestType.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::aggregate::prestosql {
+
+namespace {
+
+using TDigestAccumulator = functions::tdigest::TDigest<StlAllocator<double>>;
+
+/// Builds a t-digest of DOUBLE values. When 'digestAsRawInput' is true, the raw
+/// input is serialized t-digests which are merged, i.e. merge(tdigest).
+class TDigestAggregate : public exec::Aggregate {
+ public:
+  TDigestAggregate(const TypePtr& resultType, bool digestAsRawInput)
+      : exec::Aggregate(resultType), digestAsRawInput_{digestAsRawInput} {}
+
+  int32_t accumulatorFixedWidthSize() const override {
+    return sizeof(TDigestAccumulator);
+  }
+
+  int32_t accumulatorAlignmentSize() const override {
+    return alignof(TDigestAccumulator);
+  }
+
+  bool isFixedSize() const override {
+    return false;
+  }
+
+  bool supportsToIntermediate() const final {
+    return digestAsRawInput_;
+  }
+
+  void toIntermediate(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      VectorPtr& result) const final {
+    singleInputAsIntermediate(rows, args, result);
+  }
+
+  void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
+      override {
+    extractAccumulators(groups, numGroups, result);
+  }
+
+  void extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result)
+      override {
+    VELOX_CHECK(result);
+    auto flatResult = (*result)->asFlatVector<StringView>();
+    flatResult->resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      char* group = groups[i];
+      if (isNull(group)) {
+        flatResult->setNull(i, true);
+        continue;
+      }
+      flatResult->setNull(i, false);
+      // Serializes a compressed copy that uses std::allocator so that this is
+      // safe to call during spilling which may run in parallel.
+      // HashStringAllocator is not thread safe, so the accumulator itself must
+      // not be compressed here.
+      auto accumulator = value<TDigestAccumulator>(group);
+      functions::tdigest::TDigest<> digest;
+      digest.setCompression(accumulator->compression());
+      digest.merge(*accumulator);
+      digest.compress();
+      const auto size = digest.serializedByteSize();
+      char* rawBuffer = flatResult->getRawStringBufferWithSpace(size);
+      digest.serialize(rawBuffer);
+      flatResult->setNoCopy(i, StringView(rawBuffer, size));
+    }
+  }
+
+  void addRawInput(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    if (digestAsRawInput_) {
+      addIntermediateResults(groups, rows, args, false /*unused*/);
+      return;
+    }
+    decodeArguments(rows, args);
+    rows.applyToSelected([&](auto row) {
+      if (!isRowValid(row)) {
+        return;
+      }
+      auto group = groups[row];
+      auto tracker = trackRowSize(group);
+      addValue(group, row);
+    });
+  }
+
+  void addIntermediateResults(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedDigest_.decode(*args[0], rows, true);
+    rows.applyToSelected([&](auto row) {
+      if (decodedDigest_.isNullAt(row)) {
+        return;
+      }
+      auto group = groups[row];
+      auto tracker = trackRowSize(group);
+      mergeDigest(group, row);
+    });
+  }
+
+  void addSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    if (digestAsRawInput_) {
+      addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
+      return;
+    }
+    decodeArguments(rows, args);
+    auto tracker = trackRowSize(group);
+    rows.applyToSelected([&](auto row) {
+      if (isRowValid(row)) {
+        addValue(group, row);
+      }
+    });
+  }
+
+  void addSingleGroupIntermediateResults(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedDigest_.decode(*args[0], rows, true);
+    auto tracker = trackRowSize(group);
+    rows.applyToSelected([&](auto row) {
+      if (!decodedDigest_.isNullAt(row)) {
+        mergeDigest(group, row);
+      }
+    });
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    setAllNulls(groups, indices);
+    for (auto i : indices) {
+      auto group = groups[i];
+      new (group + offset_)
+          TDigestAccumulator(StlAllocator<double>(allocator_));
+    }
+  }
+
+  void destroyInternal(folly::Range<char**> groups) override {
+    destroyAccumulators<TDigestAccumulator>(groups);
+  }
+
+ private:
+  void decodeArguments(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    decodedValue_.decode(*args[0], rows, true);
+    if (args.size() > 1) {
+      decodedWeight_.decode(*args[1], rows, true);
+    }
+    if (args.size() > 2) {
+      decodedCompression_.decode(*args[2], rows, true);
+      checkSetCompression(rows);
+    }
+    hasWeight_ = args.size() > 1;
+  }
+
+  // Rows with a null value or weight are ignored.
+  bool isRowValid(vector_size_t row) const {
+    return !decodedValue_.isNullAt(row) &&
+        !(hasWeight_ && decodedWeight_.isNullAt(row));
+  }
+
+  void addValue(char* group, vector_size_t row) {
+    auto accumulator = value<TDigestAccumulator>(group);
+    if (isNull(group)) {
+      clearNull(group);
+      accumulator->setCompression(compression_);
+    }
+    const auto weight = hasWeight_ ? decodedWeight_.valueAt<int64_t>(row) : 1;
+    accumulator->add(decodedValue_.valueAt<double>(row), weight);
+  }
+
+  void mergeDigest(char* group, vector_size_t row) {
+    clearNull(group);
+    auto serialized = decodedDigest_.valueAt<StringView>(row);
+    value<TDigestAccumulator>(group)->mergeDeserialized(
+        serialized.data(), serialized.size());
+  }
+
+  void checkSetCompression(const SelectivityVector& rows) {
+    if (decodedCompression_.isConstantMapping()) {
+      VELOX_USER_CHECK(
+          !decodedCompression_.isNullAt(0),
+          "Compression factor cannot be null");
+      checkSetCompression(decodedCompression_.valueAt<double>(0));
+      return;
+    }
+    rows.applyToSelected([&](auto row) {
+      VELOX_USER_CHECK(
+          !decodedCompression_.isNullAt(row),
+          "Compression factor cannot be null");
+      checkSetCompression(decodedCompression_.valueAt<double>(row));
+    });
+  }
+
+  void checkSetCompression(double compression) {
+    VELOX_USER_CHECK_GT(compression, 0, "Compression factor must be positive");
+    VELOX_USER_CHECK_LE(
+        compression,
+        functions::tdigest::kMaxCompression,
+        "Compression factor must be at most {}",
+        functions::tdigest::kMaxCompression);
+    if (!compressionSet_) {
+      compression_ = compression;
+      compressionSet_ = true;
+    } else {
+      VELOX_USER_CHECK_EQ(
+          compression,
+          compression_,
+          "Compression factor must be constant for all input rows");
+    }
+  }
+
+  const bool digestAsRawInput_;
+
+  double compression_{functions::tdigest::kDefaultCompression};
+  bool compressionSet_{false};
+  bool hasWeight_{false};
+  DecodedVector decodedValue_;
+  DecodedVector decodedWeight_;
+  DecodedVector decodedCompression_;
+  DecodedVector decodedDigest_;
+};
+
+} // namespace
+
+std::unique_ptr<exec::Aggregate> createTDigestMergeAggregate(
+    const TypePtr& resultType) {
+  return std::make_unique<TDigestAggregate>(resultType, true);
+}
+
+void registerTDigestAggregate(
+    const std::string& prefix,
+    bool withCompanionFunctions,
+    bool overwrite) {
+  registerTDigestType();
+
+  std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures{
+      exec::AggregateFunctionSignatureBuilder()
+          .returnType("tdigest")
+          .intermediateType("varbinary")
+          .argumentType("double")
+          .build(),
+      exec::AggregateFunctionSignatureBuilder()
+          .returnType("tdigest")
+          .intermediateType("varbinary")
+          .argumentType("double")
+          .argumentType("bigint")
+          .build(),
+      exec::AggregateFunctionSignatureBuilder()
+          .returnType("tdigest")
+          .intermediateType("varbinary")
+          .argumentType("double")
+          .argumentType("bigint")
+          .argumentType("double")
+          .build(),
+  };
+
+  exec::registerAggregateFunction(
+      prefix + kTDigestAgg,
+      std::move(signatures),
+      [](core::AggregationNode::Step /*step*/,
+         const std::vector<TypePtr>& argTypes,
+         const TypePtr& resultType,
+         const core::QueryConfig& /*config*/)
+          -> std::unique_ptr<exec::Aggregate> {
+        VELOX_CHECK_GE(argTypes.size(), 1);
+        VELOX_CHECK_LE(argTypes.size(), 3);
+        return std::make_unique<TDigestAggregate>(resultType, false);
+      },
+      withCompanionFunctions,
+      overwrite);
+}
+
+} // namespace facebook::velox::aggregate::prestosql
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Aggregate.h"
+
+namespace facebook::velox::aggregate::prestosql {
+
+/// Returns an aggregate that merges serialized t-digests into a single
+/// t-digest of type 'resultType'. The merge function, which is registered
+/// with the HyperLogLog aggregates, uses it for t-digest inputs.
+std::unique_ptr<exec::Aggregate> createTDigestMergeAggregate(
+    const TypePtr& resultType);
+
+} // namespace facebook::velox::aggregate::prestosql
@@ -44,6 +44,7 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
         {"k_array", INTEGER()},
         {"k_norm", INTEGER()},
         {"k_hash", INTEGER()},
+        {"k_run", INTEGER()},
         {"i32", INTEGER()},
         {"i64", BIGINT()},
         {"f32", REAL()},
@@ -85,6 +86,11 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
       // values).
       children.emplace_back(fuzzer.fuzzFlat(INTEGER()));
 
+      // Generate clustered key with runs of 64 consecutive rows per value
+      // (~160 values per vector).
+      children.emplace_back(makeFlatVector<int32_t>(
+          kRowsPerVector, [i](auto row) { return i * 1'000 + row / 64; }));
+
       // Generate random values without nulls.
       children.emplace_back(fuzzer.fuzzFlat(INTEGER()));
       // fuzzer.fuzzFlat(BIGINT()) generates very large number causing sum() to
@@ -229,18 +235,21 @@ void doRun(uint32_t, const std::string& key, const std::string& aggregate) {
 BENCHMARK_NAMED_PARAM(doRun, count_k_array, "k_array", "count(1)");
 BENCHMARK_NAMED_PARAM(doRun, count_k_norm, "k_norm", "count(1)");
 BENCHMARK_NAMED_PARAM(doRun, count_k_hash, "k_hash", "count(1)");
+BENCHMARK_NAMED_PARAM(doRun, count_k_run, "k_run", "count(1)");
 BENCHMARK_DRAW_LINE();
 
 // Count aggregate.
 AGG_BENCHMARKS(count, k_array)
 AGG_BENCHMARKS(count, k_norm)
 AGG_BENCHMARKS(count, k_hash)
+AGG_BENCHMARKS(count, k_run)
 BENCHMARK_DRAW_LINE();
 
 // Sum aggregate.
 AGG_BENCHMARKS(sum, k_array)
 AGG_BENCHMARKS(sum, k_norm)
 AGG_BENCHMARKS(sum, k_hash)
+AGG_BENCHMARKS(sum, k_run)
 BENCHMARK_DRAW_LINE();
 
 // Avg aggregate.
@@ -253,12 +262,14 @@ BENCHMARK_DRAW_LINE();
 AGG_BENCHMARKS(min, k_array)
 AGG_BENCHMARKS(min, k_norm)
 AGG_BENCHMARKS(min, k_hash)
+AGG_BENCHMARKS(min, k_run)
 BENCHMARK_DRAW_LINE();
 
 // Max aggregate.
 AGG_BENCHMARKS(max, k_array)
 AGG_BENCHMARKS(max, k_norm)
 AGG_BENCHMARKS(max, k_hash)
+AGG_BENCHMARKS(max, k_run)
 BENCHMARK_DRAW_LINE();
 
 // Stddev aggregate.
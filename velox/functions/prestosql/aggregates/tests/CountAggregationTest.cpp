@@ -81,6 +81,24 @@ TEST_F(CountAggregationTest, count) {
       "SELECT c0 % 10, count(c7) FROM tmp GROUP BY 1");
 }
 
+TEST_F(CountAggregationTest, groupRuns) {
+  // Clustered keys produce runs of consecutive rows with the same group, which
+  // are counted a run at a time.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row / 100; }),
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return row; }, nullEvery(3)),
+  });
+  createDuckDbTable({data});
+
+  testAggregations(
+      {data},
+      {"c0"},
+      {"count(1)", "count(c1)"},
+      "SELECT c0, count(1), count(c1) FROM tmp GROUP BY 1");
+  testAggregations({data}, {}, {"count(c1)"}, "SELECT count(c1) FROM tmp");
+}
+
 TEST_F(CountAggregationTest, mask) {
   std::vector<RowVectorPtr> data;
   // Make batches where some batches have mask all true, some half and half and
@@ -469,6 +469,33 @@ TEST_F(MinMaxTest, initialValue) {
       "SELECT 1, -1, 1, -1");
 }
 
+TEST_F(MinMaxTest, groupRuns) {
+  // Clustered keys produce runs of consecutive rows with the same group, which
+  // are reduced with the run reducers.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row / 100; }),
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return (row * 7919) % 10'007; }, nullEvery(7)),
+      makeFlatVector<int16_t>(
+          10'000, [](auto row) { return (row * 31) % 1'000 - 500; }),
+      makeFlatVector<double>(
+          10'000, [](auto row) { return (row * 13) % 101 * 0.5; }),
+  });
+  createDuckDbTable({data});
+
+  testAggregations(
+      {data},
+      {"c0"},
+      {"min(c1)", "max(c1)", "min(c2)", "max(c2)", "min(c3)", "max(c3)"},
+      "SELECT c0, min(c1), max(c1), min(c2), max(c2), min(c3), max(c3) "
+      "FROM tmp GROUP BY 1");
+  testAggregations(
+      {data},
+      {},
+      {"min(c1)", "max(c1)", "min(c2)", "max(c2)"},
+      "SELECT min(c1), max(c1), min(c2), max(c2) FROM tmp");
+}
+
 TEST_F(MinMaxTest, maxShortDecimal) {
   doTest(max, DECIMAL(18, 3), false);
 }
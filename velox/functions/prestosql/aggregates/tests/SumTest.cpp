@@ -462,5 +462,79 @@ TEST_F(SumTest, distinct) {
       .assertResults("SELECT c0, sum(distinct c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(SumTest, groupRuns) {
+  // Clustered keys produce runs of consecutive rows with the same group, which
+  // are summed with the run reducers.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row / 100; }),
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return row * 7; }, nullEvery(11)),
+      makeFlatVector<double>(10'000, [](auto row) { return row * 0.1; }),
+      makeFlatVector<int32_t>(
+          10'000, [](auto row) { return row % 1'000; }, nullEvery(5)),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  testAggregations(
+      {data},
+      {"c0"},
+      {"sum(c1)", "sum(c2)", "sum(c3)", "sum(c4)"},
+      "SELECT c0, sum(c1), sum(c2), sum(c3), sum(c4) FROM tmp GROUP BY 1");
+  testAggregations(
+      {data},
+      {},
+      {"sum(c1)", "sum(c3)", "sum(c4)"},
+      "SELECT sum(c1), sum(c3), sum(c4) FROM tmp");
+
+  // Overflow inside a run is still detected.
+  auto overflow = makeRowVector({
+      makeFlatVector<int32_t>(64, [](auto row) { return row / 32; }),
+      makeFlatVector<int64_t>(64, [](auto row) {
+        return row == 40 ? std::numeric_limits<int64_t>::max() : 1;
+      }),
+  });
+  auto plan = PlanBuilder()
+                  .values({overflow})
+                  .singleAggregation({"c0"}, {"sum(c1)"})
+                  .planNode();
+  VELOX_ASSERT_THROW(AssertQueryBuilder(plan).copyResults(pool()), "overflow");
+}
+
+TEST_F(SumTest, runOverflowOrder) {
+  // Adding row by row overflows at MAX + 1 even though the final sum fits.
+  // Summing the run at once must fail the same way for grouped and global
+  // aggregations.
+  std::vector<int64_t> values = {
+      std::numeric_limits<int64_t>::max(), 1, 0, 0, -1, 0, 0, 0};
+  values.resize(64, 0);
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(64, [](auto row) { return row / 32; }),
+      makeFlatVector<int64_t>(values),
+  });
+
+  for (const auto& keys : {std::vector<std::string>{"c0"}, {}}) {
+    SCOPED_TRACE(keys.empty() ? "global" : "grouped");
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .singleAggregation(keys, {"sum(c1)"})
+                    .planNode();
+    VELOX_ASSERT_THROW(
+        AssertQueryBuilder(plan).copyResults(pool()),
+        "integer overflow: 9223372036854775807 + 1");
+  }
+
+  // Large values that cannot overflow in any order are summed at once.
+  data = makeRowVector({
+      makeFlatVector<int64_t>(64, [](auto /*row*/) { return 1L << 56; }),
+  });
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({}, {"sum(c0)"})
+                  .planNode();
+  AssertQueryBuilder(plan).assertResults(
+      makeRowVector({makeConstant<int64_t>(1L << 62, 1)}));
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/TDigest.h"
+#include "velox/functions/lib/aggregates/tests/utils/AggregationTestBase.h"
+
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::functions::aggregate::test;
+
+namespace facebook::velox::aggregate::test {
+namespace {
+
+class TDigestAggregateTest : public AggregationTestBase {
+ protected:
+  static const std::vector<double> kQuantiles;
+
+  // Returns the quantiles of a digest built from 'values' and 'weights'.
+  // Groups in these tests are small enough that no centroids are combined, so
+  // the result does not depend on how the input is split between partial
+  // aggregations.
+  static std::vector<double> expectedQuantiles(
+      const std::vector<double>& values,
+      const std::vector<int64_t>& weights = {}) {
+    functions::tdigest::TDigest<> digest;
+    for (size_t i = 0; i < values.size(); ++i) {
+      digest.add(values[i], weights.empty() ? 1 : weights[i]);
+    }
+    digest.compress();
+    std::vector<double> quantiles;
+    for (auto q : kQuantiles) {
+      quantiles.push_back(digest.estimateQuantile(q));
+    }
+    return quantiles;
+  }
+
+  static std::string quantilesSql() {
+    std::vector<std::string> quantiles;
+    for (auto q : kQuantiles) {
+      quantiles.push_back(fmt::format("{:.2f}", q));
+    }
+    return fmt::format(
+        "values_at_quantiles(a0, ARRAY[{}])", folly::join(", ", quantiles));
+  }
+};
+
+const std::vector<double> TDigestAggregateTest::kQuantiles{
+    0.0, 0.1, 0.25, 0.5, 0.9, 1.0};
+
+TEST_F(TDigestAggregateTest, groupBy) {
+  constexpr int kNumGroups = 5;
+  constexpr int kSize = 100;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % kNumGroups; }),
+      makeFlatVector<double>(
+          kSize,
+          [](auto row) { return (row * 17) % 31 + 0.5; },
+          nullEvery(11)),
+  });
+
+  std::vector<int32_t> keys;
+  std::vector<std::vector<std::optional<double>>> quantiles;
+  for (int32_t group = 0; group < kNumGroups; ++group) {
+    std::vector<double> values;
+    for (auto row = group; row < kSize; row += kNumGroups) {
+      if (row % 11 != 0) {
+        values.push_back((row * 17) % 31 + 0.5);
+      }
+    }
+    keys.push_back(group);
+    auto expected = expectedQuantiles(values);
+    quantiles.emplace_back(expected.begin(), expected.end());
+  }
+  auto expected = makeRowVector({
+      makeFlatVector(keys),
+      makeNullableArrayVector(quantiles),
+  });
+
+  testAggregations(
+      {data}, {"c0"}, {"tdigest_agg(c1)"}, {"c0", quantilesSql()}, {expected});
+}
+
+TEST_F(TDigestAggregateTest, weighted) {
+  constexpr int kSize = 10;
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return kSize - row; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return 1 + row % 3; }),
+  });
+  std::vector<double> values;
+  std::vector<int64_t> weights;
+  for (auto row = 0; row < kSize; ++row) {
+    values.push_back(kSize - row);
+    weights.push_back(1 + row % 3);
+  }
+  auto expectedValues = expectedQuantiles(values, weights);
+  auto expected = makeRowVector({makeArrayVector<double>({expectedValues})});
+
+  testAggregations(
+      {data}, {}, {"tdigest_agg(c0, c1)"}, {quantilesSql()}, {expected});
+  testAggregations(
+      {data}, {}, {"tdigest_agg(c0, c1, 200.0)"}, {quantilesSql()}, {expected});
+
+  auto median = makeRowVector({makeFlatVector<double>({expectedValues[3]})});
+  testAggregations(
+      {data},
+      {},
+      {"tdigest_agg(c0, c1)"},
+      {"value_at_quantile(a0, 0.5)"},
+      {median});
+}
+
+TEST_F(TDigestAggregateTest, merge) {
+  constexpr int kSize = 40;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 10; }),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 2; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.25; }),
+  });
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({"c0", "c1"}, {"tdigest_agg(c2)"})
+                  .planNode();
+  auto digests = split(AssertQueryBuilder(plan).copyResults(pool()), 2);
+
+  // Each group of c1 merges 5 digests of 4 values each.
+  std::vector<std::vector<std::optional<double>>> quantiles;
+  for (auto group = 0; group < 2; ++group) {
+    std::vector<double> values;
+    for (auto row = group; row < kSize; row += 2) {
+      values.push_back(row * 0.25);
+    }
+    auto expected = expectedQuantiles(values);
+    quantiles.emplace_back(expected.begin(), expected.end());
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>({0, 1}),
+      makeNullableArrayVector(quantiles),
+  });
+  testAggregations(
+      digests, {"c1"}, {"merge(a0)"}, {"c1", quantilesSql()}, {expected});
+}
+
+TEST_F(TDigestAggregateTest, allNulls) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({1, 1, 2}),
+      makeNullableFlatVector<double>({std::nullopt, std::nullopt, 1.0}),
+  });
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeNullableFlatVector<double>({std::nullopt, 1.0}),
+  });
+  testAggregations(
+      {data},
+      {"c0"},
+      {"tdigest_agg(c1)"},
+      {"c0", "value_at_quantile(a0, 0.5)"},
+      {expected});
+}
+
+TEST_F(TDigestAggregateTest, invalidCompression) {
+  auto data = makeRowVector({
+      makeFlatVector<double>({1, 2, 3}),
+      makeFlatVector<int64_t>({1, 1, 1}),
+      makeFlatVector<double>({100, 100, 200}),
+  });
+  auto runAggregate = [&](const std::string& aggregate) {
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .singleAggregation({}, {aggregate})
+                    .planNode();
+    AssertQueryBuilder(plan).copyResults(pool());
+  };
+  VELOX_ASSERT_THROW(
+      runAggregate("tdigest_agg(c0, c1, 0.0)"),
+      "Compression factor must be positive");
+  VELOX_ASSERT_THROW(
+      runAggregate("tdigest_agg(c0, c1, 1001.0)"),
+      "Compression factor must be at most 1000");
+  VELOX_ASSERT_THROW(
+      runAggregate("tdigest_agg(c0, c1, c2)"),
+      "Compression factor must be constant for all input rows");
+  VELOX_ASSERT_THROW(
+      runAggregate("tdigest_agg(c0, c1 - 1)"), "Weight must be positive");
+}
+
+} // namespace
+} // namespace facebook::velox::aggregate::test
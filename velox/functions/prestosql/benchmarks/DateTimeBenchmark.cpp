@@ -124,6 +124,27 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Evaluates 'expression' on timestamps between 2000 and 2030 with the
+  // session time zone set to 'timeZone'.
+  void runInTimeZone(
+      const std::string& expression,
+      const std::string& timeZone) {
+    folly::BenchmarkSuspender suspender;
+    setTimezone(timeZone);
+    setAdjustTimestampToTimezone("true");
+
+    constexpr int64_t kBegin = 946'684'800; // 2000-01-01
+    constexpr int64_t kEnd = 1'893'456'000; // 2030-01-01
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<Timestamp>(
+        10'000, [&](auto row) {
+          return Timestamp(kBegin + (row * 94'677'211L) % (kEnd - kBegin), 0);
+        })});
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -197,6 +218,40 @@ BENCHMARK(second) {
   DateTimeBenchmark benchmark;
   benchmark.run("second");
 }
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(hourUtc) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("hour(c0)", "UTC");
+}
+
+BENCHMARK(hourLosAngeles) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("hour(c0)", "America/Los_Angeles");
+}
+
+BENCHMARK(truncDayLosAngeles) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("date_trunc('day', c0)", "America/Los_Angeles");
+}
+
+BENCHMARK(formatDateTimeLosAngeles) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone(
+      "format_datetime(c0, 'yyyy-MM-dd HH:mm')", "America/Los_Angeles");
+}
+
+BENCHMARK(castToDateLosAngeles) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone("cast(c0 as date)", "America/Los_Angeles");
+}
+
+BENCHMARK(toUnixtimeLosAngeles) {
+  DateTimeBenchmark benchmark;
+  benchmark.runInTimeZone(
+      "to_unixtime(cast(c0 as timestamp with time zone))",
+      "America/Los_Angeles");
+}
 } // namespace
 
 int main(int argc, char** argv) {
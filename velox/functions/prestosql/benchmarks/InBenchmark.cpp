@@ -43,6 +43,28 @@ VectorPtr fastIn(
   return result;
 }
 
+/// Reference implementation of IN for strings using F14FastSet.
+VectorPtr fastInStrings(
+    const folly::F14FastSet<std::string>& inSet,
+    const VectorPtr& data) {
+  const auto numRows = data->size();
+  auto result = std::static_pointer_cast<FlatVector<bool>>(
+      BaseVector::create(BOOLEAN(), numRows, data->pool()));
+  auto rawResults = result->mutableRawValues<int32_t>();
+
+  auto rawData = data->asUnchecked<FlatVector<StringView>>()->rawValues();
+  for (auto row = 0; row < numRows; ++row) {
+    bits::setBit(rawResults, row, inSet.contains(std::string(rawData[row])));
+  }
+
+  return result;
+}
+
+/// Returns a short code, e.g. "SKU0042".
+std::string makeCode(int32_t i) {
+  return fmt::format("SKU{:04d}", i);
+}
+
 class InBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   InBenchmark() : FunctionBenchmarkBase() {
@@ -73,6 +95,49 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Strings drawn from twice as many codes as there are in the IN-list, so
+  // that about half of the rows match.
+  RowVectorPtr makeStringData(size_t numValues) {
+    return vectorMaker_.rowVector({vectorMaker_.flatVector<std::string>(
+        1'000,
+        [&](auto row) { return makeCode((row * 7919) % (2 * numValues)); })});
+  }
+
+  void runStrings(size_t numValues) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeStringData(numValues);
+
+    std::ostringstream inList;
+    inList << "'" << makeCode(0) << "'";
+    for (auto i = 1; i < numValues; ++i) {
+      inList << ", '" << makeCode(i * 2) << "'";
+    }
+
+    auto sql = fmt::format("c0 IN ({})", inList.str());
+    auto exprSet = compileExpression(sql, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
+  void runFastStrings(size_t numValues) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeStringData(numValues);
+
+    folly::F14FastSet<std::string> inSet;
+    inSet.reserve(numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      inSet.insert(makeCode(i * 2));
+    }
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < 1000; i++) {
+      cnt += fastInStrings(inSet, data->childAt(0))->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 1000; i++) {
@@ -126,6 +191,36 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(fastInStrings10) {
+  InBenchmark benchmark;
+  benchmark.runFastStrings(10);
+}
+
+BENCHMARK_RELATIVE(inStrings10) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10);
+}
+
+BENCHMARK(fastInStrings1K) {
+  InBenchmark benchmark;
+  benchmark.runFastStrings(1'000);
+}
+
+BENCHMARK_RELATIVE(inStrings1K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(1'000);
+}
+
+BENCHMARK(fastInStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runFastStrings(10'000);
+}
+
+BENCHMARK_RELATIVE(inStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10'000);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
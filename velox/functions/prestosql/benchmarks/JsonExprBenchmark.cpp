@@ -21,6 +21,7 @@
 #include <folly/init/Init.h>
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/JsonExtractScalars.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/JsonExtractor.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -198,6 +199,19 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     registerFunction<JsonSizeFunction, int64_t, Json, Varchar>({"json_size"});
     registerFunction<FollyJsonSizeFunction, int64_t, Json, Varchar>(
         {"folly_json_size"});
+
+    static const bool kRewriteRegistered = [] {
+      exec::registerStatefulVectorFunction(
+          "$internal$json_extract_scalars",
+          jsonExtractScalarsSignatures(),
+          makeJsonExtractScalars);
+      registerJsonExtractScalarAt("$internal$json_extract_scalar_at");
+      exec::registerExpressionSetRewrite([](const auto& exprs) {
+        return rewriteJsonExtractScalars("", exprs);
+      });
+      return true;
+    }();
+    folly::doNotOptimizeAway(kRewriteRegistered);
   }
 
   std::string prepareData(int jsonSize) {
@@ -253,6 +267,38 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates json_extract_scalar for 'numPaths' different paths on the same
+  // column in one ExprSet. If 'shareParse' is false, disables the rewrite
+  // that parses each document once for all paths.
+  void runWithJsonExtractScalars(
+      int iter,
+      int vectorSize,
+      const std::string& json,
+      int numPaths,
+      bool shareParse) {
+    folly::BenchmarkSuspender suspender;
+
+    auto rowVector = vectorMaker_.rowVector({makeJsonData(json, vectorSize)});
+    std::vector<core::TypedExprPtr> exprs;
+    for (auto i = 0; i < numPaths; ++i) {
+      auto untyped = parse::parseExpr(
+          fmt::format("json_extract_scalar(c0, '$.key[{}].k1')", i), options_);
+      exprs.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+
+    std::vector<exec::ExpressionSetRewrite> rewrites;
+    if (!shareParse) {
+      std::swap(rewrites, exec::expressionSetRewrites());
+    }
+    exec::ExprSet exprSet(exprs, &execCtx_);
+    if (!shareParse) {
+      std::swap(rewrites, exec::expressionSetRewrites());
+    }
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
   void runWithJsonContains(
       int iter,
       int vectorSize,
@@ -367,6 +413,22 @@ void SIMDJsonExtract(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "json_extract", json, "$.key[*].k1");
 }
 
+void JsonExtractScalarsOneAtATime(int iter, int vectorSize, int numPaths) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(1000);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalars(iter, vectorSize, json, numPaths, false);
+}
+
+void JsonExtractScalarsSharedParse(int iter, int vectorSize, int numPaths) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(1000);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalars(iter, vectorSize, json, numPaths, true);
+}
+
 void FollyJsonSize(int iter, int vectorSize, int jsonSize) {
   folly::BenchmarkSuspender suspender;
   JsonBenchmark benchmark;
@@ -607,6 +669,27 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(JsonExtractScalarsOneAtATime, 1_path, 100, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(JsonExtractScalarsSharedParse, 1_path, 100, 1);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(JsonExtractScalarsOneAtATime, 2_paths, 100, 2);
+BENCHMARK_RELATIVE_NAMED_PARAM(JsonExtractScalarsSharedParse, 2_paths, 100, 2);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(JsonExtractScalarsOneAtATime, 5_paths, 100, 5);
+BENCHMARK_RELATIVE_NAMED_PARAM(JsonExtractScalarsSharedParse, 5_paths, 100, 5);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(JsonExtractScalarsOneAtATime, 10_paths, 100, 10);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    JsonExtractScalarsSharedParse,
+    10_paths,
+    100,
+    10);
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 } // namespace facebook::velox::functions::prestosql
 
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Measures lambda functions applied to nested arrays and lambdas that capture
+// columns of the enclosing scope. Captures of the innermost lambda are aligned
+// with its rows by every enclosing lambda.
+class LambdaBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  LambdaBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerAllScalarFunctions();
+
+    VectorFuzzer::Options options;
+    options.vectorSize = 1'000;
+    options.containerLength = 10;
+    VectorFuzzer fuzzer(options, pool());
+
+    // c0: array(array(bigint)), c1: array(array(array(bigint))), c2 and c3:
+    // captured bigint columns, c4: array(bigint) where one array in 100 is
+    // 100 times longer than the others.
+    auto skewed = maker().arrayVector<int64_t>(
+        options.vectorSize,
+        [](auto row) { return row % 100 == 0 ? 1'000 : row % 10; },
+        [](auto row) { return row % 7; });
+    data_ = maker().rowVector({
+        fuzzer.fuzzFlat(ARRAY(ARRAY(BIGINT()))),
+        fuzzer.fuzzFlat(ARRAY(ARRAY(ARRAY(BIGINT())))),
+        maker().flatVector<int64_t>(
+            options.vectorSize, [](auto row) { return row % 17; }),
+        maker().flatVector<int64_t>(
+            options.vectorSize, [](auto row) { return row % 101; }),
+        skewed,
+    });
+  }
+
+  size_t run(const std::string& expression, size_t times) {
+    folly::BenchmarkSuspender suspender;
+    auto exprSet = compileExpression(expression, asRowType(data_->type()));
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < times; ++i) {
+      count += evaluate(exprSet, data_)->size();
+    }
+    return count;
+  }
+
+ private:
+  RowVectorPtr data_;
+};
+
+std::unique_ptr<LambdaBenchmark> benchmark;
+
+BENCHMARK_MULTI(nestedTransform, n) {
+  return benchmark->run(
+      "transform(c0, x -> transform(x, y -> y % 1000 + 1))", n);
+}
+
+BENCHMARK_MULTI(nestedTransformCapture, n) {
+  return benchmark->run(
+      "transform(c0, x -> transform(x, y -> y % 1000 * c2 + c3))", n);
+}
+
+BENCHMARK_MULTI(nestedTransformCapture3Levels, n) {
+  return benchmark->run(
+      "transform(c1, x -> transform(x, y -> "
+      "transform(y, z -> z % 1000 * c2 + c3)))",
+      n);
+}
+
+BENCHMARK_MULTI(nestedFilterCapture, n) {
+  return benchmark->run(
+      "transform(c0, x -> filter(x, y -> y % 3 = c2 % 3))", n);
+}
+
+BENCHMARK_MULTI(nestedReduceCapture, n) {
+  return benchmark->run(
+      "transform(c0, x -> reduce(x, c2, (s, y) -> s + y % 1000, s -> s))",
+      n);
+}
+
+BENCHMARK_MULTI(reduceSkewedSizes, n) {
+  return benchmark->run(
+      "reduce(c4, 0, (s, x) -> (s * 3 + x) % 1000003, s -> s)", n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+
+  benchmark = std::make_unique<LambdaBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
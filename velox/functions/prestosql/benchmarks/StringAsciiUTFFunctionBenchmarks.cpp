@@ -114,6 +114,40 @@ class StringAsciiUTFFunctionBenchmark
     doRun(exprSet, rowVector);
   }
 
+  enum class Encoding { kAscii, kMixed, kMultiByte };
+
+  // Evaluates 'expression' over strings of 200 characters in c0.
+  void runExpression(const std::string& expression, Encoding encoding) {
+    folly::BenchmarkSuspender suspender;
+
+    VectorFuzzer::Options opts;
+    switch (encoding) {
+      case Encoding::kAscii:
+        break;
+      case Encoding::kMixed:
+        opts.charEncodings = {
+            UTF8CharList::ASCII,
+            UTF8CharList::UNICODE_CASE_SENSITIVE,
+            UTF8CharList::EXTENDED_UNICODE};
+        break;
+      case Encoding::kMultiByte:
+        opts.charEncodings = {
+            UTF8CharList::EXTENDED_UNICODE,
+            UTF8CharList::MATHEMATICAL_SYMBOLS};
+        break;
+    }
+
+    opts.stringLength = 200;
+    opts.stringVariableLength = false;
+    opts.vectorSize = 10'000;
+    VectorFuzzer fuzzer(opts, execCtx_.pool());
+    auto rowVector = vectorMaker_.rowVector({fuzzer.fuzzFlat(VARCHAR())});
+    auto exprSet = compileExpression(expression, rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -123,6 +157,8 @@ class StringAsciiUTFFunctionBenchmark
   }
 };
 
+using Encoding = StringAsciiUTFFunctionBenchmark::Encoding;
+
 BENCHMARK(utfLower) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runUpperLower("lower", true);
@@ -172,6 +208,82 @@ BENCHMARK_RELATIVE(aciiRPad) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runLPadRPad("rpad", false);
 }
+BENCHMARK(multiByteLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("length(c0)", Encoding::kMultiByte);
+}
+
+BENCHMARK_RELATIVE(mixedLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("length(c0)", Encoding::kMixed);
+}
+
+BENCHMARK_RELATIVE(asciiLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("length(c0)", Encoding::kAscii);
+}
+
+BENCHMARK(multiByteSubStr) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("substr(c0, 100, 50)", Encoding::kMultiByte);
+}
+
+BENCHMARK_RELATIVE(mixedSubStr) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("substr(c0, 100, 50)", Encoding::kMixed);
+}
+
+BENCHMARK_RELATIVE(asciiSubStr) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("substr(c0, 100, 50)", Encoding::kAscii);
+}
+
+BENCHMARK(multiByteFromUtf8) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("from_utf8(to_utf8(c0))", Encoding::kMultiByte);
+}
+
+BENCHMARK_RELATIVE(mixedFromUtf8) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("from_utf8(to_utf8(c0))", Encoding::kMixed);
+}
+
+BENCHMARK_RELATIVE(asciiFromUtf8) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("from_utf8(to_utf8(c0))", Encoding::kAscii);
+}
+
+BENCHMARK(multiByteStrPos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression(
+      "strpos(c0, substr(c0, 150, 2))", Encoding::kMultiByte);
+}
+
+BENCHMARK_RELATIVE(mixedStrPos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("strpos(c0, substr(c0, 150, 2))", Encoding::kMixed);
+}
+
+BENCHMARK_RELATIVE(asciiStrPos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("strpos(c0, substr(c0, 150, 2))", Encoding::kAscii);
+}
+
+BENCHMARK(multiByteReverse) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("reverse(c0)", Encoding::kMultiByte);
+}
+
+BENCHMARK_RELATIVE(mixedReverse) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("reverse(c0)", Encoding::kMixed);
+}
+
+BENCHMARK_RELATIVE(asciiReverse) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runExpression("reverse(c0)", Encoding::kAscii);
+}
+
 } // namespace
 
 // Preliminary release run, before ascii optimization.
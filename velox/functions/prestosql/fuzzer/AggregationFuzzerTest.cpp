@@ -162,6 +162,7 @@ int main(int argc, char** argv) {
           {"approx_set", nullptr},
           {"approx_percentile",
            std::make_shared<ApproxPercentileResultVerifier>()},
+          {"tdigest_agg", nullptr},
           {"arbitrary", std::make_shared<ArbitraryResultVerifier>()},
           {"any_value", nullptr},
           {"array_agg", makeArrayVerifier()},
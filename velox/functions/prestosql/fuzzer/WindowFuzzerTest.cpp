@@ -130,6 +130,7 @@ int main(int argc, char** argv) {
           {"approx_set", nullptr},
           {"approx_percentile",
            std::make_shared<ApproxPercentileResultVerifier>()},
+          {"tdigest_agg", nullptr},
           {"approx_most_frequent", nullptr},
           {"merge", nullptr},
           // Semantically inconsistent functions
@@ -46,6 +46,12 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
   return *it.first->second;
 }
 
+/* static */ std::unique_ptr<SIMDJsonExtractor> SIMDJsonExtractor::create(
+    folly::StringPiece path) {
+  return std::unique_ptr<SIMDJsonExtractor>(
+      new SIMDJsonExtractor(folly::trimWhitespace(path).str()));
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
@@ -57,8 +57,14 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new, uncached extractor for the given JSON path. Use this when
+  /// the caller needs to hold on to several extractors at once, which the
+  /// bounded cache behind getInstance() does not guarantee. Throws if the path
+  /// is invalid.
+  static std::unique_ptr<SIMDJsonExtractor> create(folly::StringPiece path);
+
  private:
-  // Shouldn't instantiate directly - use getInstance().
+  // Shouldn't instantiate directly - use getInstance() or create().
   explicit SIMDJsonExtractor(const std::string& path) {
     if (!tokenize(path)) {
       VELOX_USER_FAIL("Invalid JSON path: {}", path);
@@ -127,6 +133,24 @@ simdjson::error_code SIMDJsonExtractor::extract(
   return consumer(input);
 };
 
+/// Same as simdJsonExtract below but for an already parsed document. Allows
+/// extracting multiple paths from one document by rewinding it between the
+/// calls.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, std::forward<TConsumer>(consumer));
+}
+
 /**
  * Extract element(s) from a JSON object using the given path.
  * @param json: A JSON object
@@ -152,15 +176,7 @@ simdjson::error_code simdJsonExtract(
     TConsumer&& consumer) {
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return simdJsonExtract(jsonDoc, extractor, std::forward<TConsumer>(consumer));
 }
 
 } // namespace facebook::velox::functions
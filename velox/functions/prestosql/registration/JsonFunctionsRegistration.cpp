@@ -15,6 +15,7 @@
  */
 
 #include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/JsonExtractScalars.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 
 namespace facebook::velox::functions {
@@ -31,6 +32,17 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
 
+  // Parses the JSON once for all json_extract_scalar calls on the same column
+  // in an ExprSet.
+  exec::registerStatefulVectorFunction(
+      "$internal$json_extract_scalars",
+      jsonExtractScalarsSignatures(),
+      makeJsonExtractScalars);
+  registerJsonExtractScalarAt("$internal$json_extract_scalar_at");
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalars(prefix, exprs);
+  });
+
   registerFunction<JsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
   registerFunction<JsonExtractFunction, Json, Varchar, Varchar>(
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -56,6 +57,15 @@ void registerMathOperators(const std::string& prefix = "") {
       IntervalDayTime,
       double>({prefix + "divide"});
   registerBinaryFloatingPoint<ModulusFunction>({prefix + "mod"});
+
+  exec::registerFusedArithmeticOp(
+      prefix + "plus", exec::FusedArithmeticOp::kPlus);
+  exec::registerFusedArithmeticOp(
+      prefix + "minus", exec::FusedArithmeticOp::kMinus);
+  exec::registerFusedArithmeticOp(
+      prefix + "multiply", exec::FusedArithmeticOp::kMultiply);
+  exec::registerFusedArithmeticOp(
+      prefix + "divide", exec::FusedArithmeticOp::kDivide);
 }
 
 } // namespace
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/Registerer.h"
+#include "velox/functions/lib/MultiPatternMatcher.h"
 #include "velox/functions/lib/Re2Functions.h"
 #include "velox/functions/prestosql/RegexpReplace.h"
 #include "velox/functions/prestosql/SplitPart.h"
@@ -165,6 +166,15 @@ void registerStringFunctions(const std::string& prefix) {
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
 
+  // Evaluates OR-lists of LIKE and regexp_like on the same column in one
+  // pass.
+  exec::registerStatefulVectorFunction(
+      "$internal$like_any", likeAnySignatures(), makeLikeAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteMultiPatternMatch(
+        prefix + "like", prefix + "regexp_like", "$internal$like_any", expr);
+  });
+
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar, int64_t>(
@@ -528,6 +528,70 @@ TEST_F(InPredicateTest, varchar) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(InPredicateTest, varcharManyValues) {
+  // Codes of 1 to 40 characters cover inline and out-of-line StringViews.
+  // Even codes are in the IN-list, odd ones are not.
+  auto makeCode = [](int32_t i) {
+    return fmt::format("{}{}", std::string(i % 37, 'x'), i);
+  };
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          size, [&](auto row) { return makeCode(row % 500); }),
+      makeFlatVector<std::string>(
+          size, [&](auto row) { return makeCode(row % 500); }, nullEvery(7)),
+  });
+
+  for (auto numValues : {3, 30, 250}) {
+    SCOPED_TRACE(fmt::format("numValues: {}", numValues));
+    std::vector<std::string> codes;
+    for (auto i = 0; i < numValues; ++i) {
+      codes.push_back(makeCode(i * 2));
+    }
+    std::vector<std::optional<StringView>> values;
+    for (const auto& code : codes) {
+      values.push_back(StringView(code));
+    }
+    values.push_back(StringView(""));
+    auto inList = getInList<StringView>(values, VARCHAR());
+
+    auto isInList = [&](vector_size_t row) {
+      const auto code = row % 500;
+      return code % 2 == 0 && code < numValues * 2;
+    };
+    auto result = evaluate<SimpleVector<bool>>(
+        makeInExpression("c0", inList, VARCHAR()), data);
+    assertEqualVectors(makeFlatVector<bool>(size, isInList), result);
+
+    result = evaluate<SimpleVector<bool>>(
+        makeInExpression("c1", inList, VARCHAR()), data);
+    assertEqualVectors(
+        makeFlatVector<bool>(size, isInList, nullEvery(7)), result);
+
+    // With a null in the IN-list misses are null.
+    values.push_back(std::nullopt);
+    inList = getInList<StringView>(values, VARCHAR());
+    result = evaluate<SimpleVector<bool>>(
+        makeInExpression("c0", inList, VARCHAR()), data);
+    assertEqualVectors(
+        makeFlatVector<bool>(
+            size,
+            [](auto /*row*/) { return true; },
+            [&](auto row) { return !isInList(row); }),
+        result);
+  }
+
+  // Empty strings and prefixes of values.
+  auto strings = makeRowVector({makeFlatVector<std::string>(
+      {"", "x", "xx", "xxxx0", "xxxx", "xxxxxxxxxxxxxxxxxxxxx21",
+       "xxxxxxxxxxxxxxxxxxxxx2"})});
+  auto result = evaluate<SimpleVector<bool>>(
+      "c0 IN ('', 'xx', 'xxxxxxxxxxxxxxxxxxxxx21', 'xxxxxxx')", strings);
+  assertEqualVectors(
+      makeFlatVector<bool>({true, false, true, false, false, true, false}),
+      result);
+}
+
 TEST_F(InPredicateTest, varcharConstant) {
   const vector_size_t size = 1'000;
   auto rowVector = makeRowVector(
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <gmock/gmock.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -235,6 +237,92 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, sharedParse) {
+  std::vector<std::optional<StringView>> json = {
+      R"({"a": 1, "b": "x", "c": {"d": true}, "e": [5]})",
+      R"({"a": [1, 2], "b": null, "c": {"d": "zzzzzzzzzzzzzzzzzzzz"}})",
+      std::nullopt,
+      "not json",
+      R"({"a": 1.5, "c": {"d": 1}, "b": "y")",
+      R"({"e": [1, 2], "b": "w", "a": "v"})",
+      R"([1, 2])",
+  };
+  auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(json, JSON()),
+      makeNullableFlatVector<StringView>(json, VARCHAR()),
+  });
+
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "concat(json_extract_scalar(c0, '$.c.d'), json_extract_scalar(c0, '$.a'))",
+      "json_extract_scalar(c0, '$.e[*]')",
+      "json_extract_scalar(c1, '$.b')",
+      "json_extract_scalar(c1, '$.c.d')",
+      "json_extract_scalar(c1, '$[0]')",
+  };
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  EXPECT_THAT(
+      exprSet->toString(),
+      ::testing::HasSubstr("$internal$json_extract_scalars"));
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+
+  // Each expression evaluated on its own with the rewrite disabled.
+  auto rewrites = std::move(exec::expressionSetRewrites());
+  exec::expressionSetRewrites().clear();
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+  exec::expressionSetRewrites() = std::move(rewrites);
+
+  auto valueAt = [&](size_t expr, vector_size_t row) {
+    const auto* result = results[expr]->as<SimpleVector<StringView>>();
+    return result->isNullAt(row)
+        ? std::nullopt
+        : std::make_optional<std::string>(result->valueAt(row));
+  };
+  EXPECT_EQ(valueAt(0, 0), "1");
+  EXPECT_EQ(valueAt(0, 1), std::nullopt);
+  EXPECT_EQ(valueAt(0, 5), "v");
+  EXPECT_EQ(valueAt(3, 0), "5");
+  EXPECT_EQ(valueAt(3, 5), std::nullopt);
+  EXPECT_EQ(valueAt(5, 1), "zzzzzzzzzzzzzzzzzzzz");
+}
+
+TEST_F(JsonExtractScalarTest, sharedParseRewrite) {
+  const auto type = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto compiled = [&](const std::vector<std::string>& exprs) {
+    return compileExpressions(exprs, type)->toString();
+  };
+
+  // A single path per column is not rewritten.
+  EXPECT_THAT(
+      compiled(
+          {"json_extract_scalar(c0, '$.a')",
+           "json_extract_scalar(c0, '$.a')",
+           "json_extract_scalar(c1, '$.b')"}),
+      ::testing::Not(::testing::HasSubstr("$internal$json_extract_scalars")));
+
+  // Invalid paths and calls inside lambdas are left as is.
+  EXPECT_THAT(
+      compiled(
+          {"json_extract_scalar(c0, '$.a')",
+           "json_extract_scalar(c0, '$.k1.')",
+           "transform(array[c0], x -> json_extract_scalar(x, '$.b'))"}),
+      ::testing::Not(::testing::HasSubstr("$internal$json_extract_scalars")));
+
+  EXPECT_THAT(
+      compiled(
+          {"json_extract_scalar(c0, '$.a')",
+           "upper(json_extract_scalar(c0, '$.b'))"}),
+      ::testing::HasSubstr("$internal$json_extract_scalars"));
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
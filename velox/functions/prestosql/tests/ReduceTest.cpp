@@ -293,6 +293,42 @@ TEST_F(ReduceTest, limit) {
       "reduce lambda function doesn't support arrays with more than");
 }
 
+// Arrays of very different sizes drop out of the evaluation at different
+// steps. Verify that the rows still being reduced get the right elements.
+TEST_F(ReduceTest, unevenArraySizes) {
+  vector_size_t size = 1'000;
+  auto sizeAt = [](auto row) { return (row * 37) % 101; };
+  auto input = makeRowVector({makeArrayVector<int64_t>(
+      size,
+      sizeAt,
+      [](auto row, auto index) { return row * index; },
+      nullEvery(13))});
+
+  auto expectedAt = [&](auto row) {
+    int64_t sum = 0;
+    for (auto i = 0; i < sizeAt(row); ++i) {
+      sum = (sum * 3 + row * i) % 1000003;
+    }
+    return sum;
+  };
+
+  const std::string expression =
+      "reduce(c0, 0, (s, x) -> (s * 3 + x) % 1000003, s -> s)";
+  auto result = evaluate(expression, input);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, expectedAt, nullEvery(13)), result);
+
+  // Evaluate on a subset of rows.
+  SelectivityVector rows(size);
+  for (auto row = 0; row < size; row += 3) {
+    rows.setValid(row, false);
+  }
+  rows.updateBounds();
+  result = evaluate(expression, input, rows);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, expectedAt, nullEvery(13)), result, rows);
+}
+
 TEST_F(ReduceTest, rewrites) {
   std::vector<std::optional<std::vector<std::optional<int64_t>>>> data;
   for (int i = 0; i < 20; ++i) {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/lib/TDigest.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+#include "velox/functions/prestosql/types/TDigestType.h"
+
+namespace facebook::velox {
+namespace {
+
+class TDigestFunctionsTest : public functions::test::FunctionBaseTest {
+ protected:
+  static std::string serialize(functions::tdigest::TDigest<>& digest) {
+    digest.compress();
+    std::string serialized(digest.serializedByteSize(), '\0');
+    digest.serialize(serialized.data());
+    return serialized;
+  }
+
+  std::optional<double> valueAtQuantile(
+      const std::optional<std::string>& digest,
+      const std::optional<double>& quantile) {
+    return evaluateOnce<double>(
+        "value_at_quantile(c0, c1)", {TDIGEST(), DOUBLE()}, digest, quantile);
+  }
+};
+
+TEST_F(TDigestFunctionsTest, valueAtQuantile) {
+  functions::tdigest::TDigest<> digest;
+  for (int i = 1; i <= 9; ++i) {
+    digest.add(i);
+  }
+  const auto serialized = serialize(digest);
+
+  EXPECT_EQ(valueAtQuantile(serialized, 0.0), 1);
+  EXPECT_EQ(valueAtQuantile(serialized, 0.5), 5);
+  EXPECT_EQ(valueAtQuantile(serialized, 1.0), 9);
+  EXPECT_EQ(valueAtQuantile(std::nullopt, 0.5), std::nullopt);
+  EXPECT_EQ(valueAtQuantile(serialized, std::nullopt), std::nullopt);
+
+  VELOX_ASSERT_THROW(
+      valueAtQuantile(serialized, 1.1),
+      "Quantile should be within bounds [0, 1], was: 1.1");
+  VELOX_ASSERT_THROW(
+      valueAtQuantile(serialized, -0.1),
+      "Quantile should be within bounds [0, 1], was: -0.1");
+}
+
+TEST_F(TDigestFunctionsTest, valueAtQuantileLarge) {
+  functions::tdigest::TDigest<> digest;
+  std::vector<double> values;
+  for (int i = 0; i < 100'000; ++i) {
+    values.push_back(i % 1'000 + i / 1'000 * 0.001);
+    digest.add(values.back());
+  }
+  std::sort(values.begin(), values.end());
+  const auto serialized = serialize(digest);
+  for (auto q : {0.001, 0.01, 0.5, 0.99, 0.999}) {
+    EXPECT_NEAR(
+        valueAtQuantile(serialized, q).value(), values[q * values.size()], 10)
+        << q;
+  }
+  EXPECT_EQ(valueAtQuantile(serialized, 0), values.front());
+  EXPECT_EQ(valueAtQuantile(serialized, 1), values.back());
+}
+
+TEST_F(TDigestFunctionsTest, valuesAtQuantiles) {
+  functions::tdigest::TDigest<> digest;
+  for (int i = 1; i <= 9; ++i) {
+    digest.add(i);
+  }
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {serialize(digest), std::nullopt}, TDIGEST()),
+  });
+
+  auto result = evaluate("values_at_quantiles(c0, ARRAY[0.0, 0.5, 1.0])", data);
+  auto expected = makeNullableArrayVector<double>({{{1, 5, 9}}, std::nullopt});
+  assertEqualVectors(expected, result);
+
+  VELOX_ASSERT_THROW(
+      evaluate("values_at_quantiles(c0, ARRAY[0.5, 1.5])", data),
+      "Quantile should be within bounds [0, 1], was: 1.5");
+  VELOX_ASSERT_THROW(
+      evaluate("values_at_quantiles(c0, ARRAY[0.5, null])", data),
+      "All quantiles should be non-null.");
+}
+
+TEST_F(TDigestFunctionsTest, malformed) {
+  functions::tdigest::TDigest<> digest;
+  for (int i = 1; i <= 9; ++i) {
+    digest.add(i);
+  }
+  const auto serialized = serialize(digest);
+
+  VELOX_ASSERT_USER_THROW(
+      valueAtQuantile(serialized.substr(0, 10), 0.5), "T-digest is too short");
+  VELOX_ASSERT_USER_THROW(
+      valueAtQuantile(serialized.substr(0, serialized.size() - 8), 0.5),
+      "T-digest size does not match the number of centroids");
+
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          {serialized.substr(0, serialized.size() - 1)}, TDIGEST()),
+  });
+  VELOX_ASSERT_USER_THROW(
+      evaluate("values_at_quantiles(c0, ARRAY[0.5])", data),
+      "T-digest size does not match the number of centroids");
+}
+
+} // namespace
+} // namespace facebook::velox
@@ -174,6 +174,82 @@ TEST_F(TransformTest, dictionaryWithDuplicates) {
   assertEqualVectors(expectedResult, result);
 }
 
+// Captures of a nested lambda are wrapped once per level of nesting. Verify
+// results with flat, dictionary-encoded and null-adding dictionary captures.
+TEST_F(TransformTest, nestedCaptures) {
+  auto array = makeNestedArrayVectorFromJson<int64_t>({
+      "[[1, 2], [3]]",
+      "[[4], [], [5, 6, 7]]",
+      "[]",
+      "[[8, 9]]",
+  });
+  const std::string expression =
+      "transform(c0, x -> transform(x, y -> y * c1 + cardinality(x) + c2))";
+
+  auto result = evaluate(
+      expression,
+      makeRowVector({
+          array,
+          makeFlatVector<int64_t>({10, 20, 30, 40}),
+          makeFlatVector<int64_t>({100, 200, 300, 400}),
+      }));
+  auto expected = makeNestedArrayVectorFromJson<int64_t>({
+      "[[112, 122], [131]]",
+      "[[281], [], [303, 323, 343]]",
+      "[]",
+      "[[722, 762]]",
+  });
+  assertEqualVectors(expected, result);
+
+  // Same captures as dictionaries over reversed values.
+  auto indices = makeIndicesInReverse(4);
+  result = evaluate(
+      expression,
+      makeRowVector({
+          array,
+          wrapInDictionary(
+              indices, 4, makeFlatVector<int64_t>({40, 30, 20, 10})),
+          wrapInDictionary(
+              indices, 4, makeFlatVector<int64_t>({400, 300, 200, 100})),
+      }));
+  assertEqualVectors(expected, result);
+
+  // A dictionary capture that adds nulls.
+  auto c1 = BaseVector::wrapInDictionary(
+      makeNulls({false, true, false, false}),
+      indices,
+      4,
+      makeFlatVector<int64_t>({40, 30, 20, 10}));
+  result = evaluate(
+      expression,
+      makeRowVector({
+          array,
+          c1,
+          makeFlatVector<int64_t>({100, 200, 300, 400}),
+      }));
+  expected = makeNestedArrayVectorFromJson<int64_t>({
+      "[[112, 122], [131]]",
+      "[[null], [], [null, null, null]]",
+      "[]",
+      "[[722, 762]]",
+  });
+  assertEqualVectors(expected, result);
+
+  // Three levels of nesting.
+  result = evaluate(
+      "transform(c0, x -> transform(x, y -> transform(sequence(1, y), "
+      "z -> z * c1 + c2)))",
+      makeRowVector({
+          makeNestedArrayVectorFromJson<int64_t>({"[[1, 2]]", "[[3]]"}),
+          makeFlatVector<int64_t>({10, 20}),
+          makeFlatVector<int64_t>({1, 2}),
+      }));
+  auto elements = makeArrayVectorFromJson<int64_t>(
+      {"[11]", "[11, 21]", "[22, 42, 62]"});
+  expected = makeArrayVector({0, 1}, makeArrayVector({0, 2}, elements));
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(TransformTest, try) {
   auto input = makeRowVector({
       makeArrayVector<int64_t>({
@@ -175,6 +175,51 @@ TEST_F(AggregateWindowTest, rangeNullsOrder) {
       {input}, "array_agg(c0)", overClause, frameClause, expected);
 }
 
+// Tests sliding frames wide enough to be computed from a segment tree over the
+// partition, mixed with narrow frames that aggregate each frame directly.
+TEST_F(AggregateWindowTest, wideSlidingFrames) {
+  auto input = {
+      makeSinglePartitionVector(500),
+      makeSinglePartitionVector(300),
+      makeSimpleVector(700)};
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 40 preceding and 60 following",
+      "rows between current row and 250 following",
+      "rows between 90 preceding and 50 preceding",
+      "rows between 3 preceding and 1 following",
+  };
+  auto aggregateFunctions = kAggregateFunctions;
+  aggregateFunctions.push_back("bool_or(c2 > 10)");
+  for (const auto& function : aggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, {kOverClauses[0], kOverClauses[6]}, frameClauses);
+  }
+}
+
+// The sum over the whole partition overflows but the sum of every frame fits.
+// The segment tree cannot merge its upper levels and must fall back to
+// aggregating the frames one by one.
+TEST_F(AggregateWindowTest, segmentTreeOverflow) {
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int64_t kValue = std::numeric_limits<int64_t>::max() / 64;
+  auto c0 = makeConstant<int64_t>(0, kSize);
+  auto c1 = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto c2 = makeConstant<int64_t>(kValue, kSize);
+  auto input = makeRowVector({c0, c1, c2});
+
+  auto expected = makeRowVector(
+      {c0, c1, c2, makeFlatVector<int64_t>(kSize, [&](auto row) {
+         return kValue * (std::min(row, 40) + 1);
+       })});
+  WindowTestBase::testWindowFunction(
+      {input},
+      "sum(c2)",
+      "partition by c0 order by c1",
+      "rows between 40 preceding and current row",
+      expected);
+}
+
 // Test for aggregates that return NULL as the default value for empty frames
 // against DuckDb.
 TEST_F(AggregateWindowTest, nullEmptyResult) {
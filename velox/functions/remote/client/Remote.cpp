@@ -16,6 +16,9 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <deque>
+
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
@@ -43,7 +46,10 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRowsPerRequest_(metadata.maxRowsPerRequest),
+        maxInflightRequests_(
+            std::max<uint32_t>(metadata.maxInflightRequests, 1)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +91,89 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    // Only selected rows are sent. If some rows below rows.end() are not
+    // selected, the input is compacted and 'selectedRows' maps positions in
+    // the compacted input back to rows of the batch.
+    const auto numRows = rows.countSelected();
+    std::vector<vector_size_t> selectedRows;
+    if (numRows < rows.end()) {
+      selectedRows.reserve(numRows);
+      rows.applyToSelected(
+          [&](vector_size_t row) { selectedRows.push_back(row); });
+      remoteRowVector = compact(remoteRowVector, selectedRows, context.pool());
+    }
+
+    const vector_size_t rowsPerRequest = maxRowsPerRequest_ > 0
+        ? std::min(maxRowsPerRequest_, numRows)
+        : numRows;
+    const bool singleRequest =
+        selectedRows.empty() && rowsPerRequest == numRows;
+    if (!singleRequest) {
+      context.ensureWritable(rows, outputType, result);
+    }
+
+    // Keeps up to 'maxInflightRequests_' requests outstanding. Responses are
+    // processed in the order the requests were sent.
+    std::deque<PendingRequest> pendingRequests;
+    for (vector_size_t offset = 0; offset < numRows; offset += rowsPerRequest) {
+      if (pendingRequests.size() >= maxInflightRequests_) {
+        processResponse(
+            pendingRequests.front(),
+            selectedRows,
+            outputType,
+            singleRequest,
+            context,
+            result);
+        pendingRequests.pop_front();
+      }
+      const auto size = std::min(rowsPerRequest, numRows - offset);
+      pendingRequests.push_back(
+          {offset,
+           size,
+           sendRequest(remoteRowVector, offset, size, outputType, context)});
+    }
+    for (auto& pendingRequest : pendingRequests) {
+      processResponse(
+          pendingRequest,
+          selectedRows,
+          outputType,
+          singleRequest,
+          context,
+          result);
+    }
+  }
+
+  // A request for rows [offset, offset + size) of the compacted input.
+  struct PendingRequest {
+    vector_size_t offset;
+    vector_size_t size;
+    folly::SemiFuture<remote::RemoteFunctionResponse> response;
+  };
+
+  // Returns a row vector with the values of 'rows' of 'input'.
+  static RowVectorPtr compact(
+      const RowVectorPtr& input,
+      const std::vector<vector_size_t>& rows,
+      memory::MemoryPool* pool) {
+    const vector_size_t size = rows.size();
+    auto indices = allocateIndices(size, pool);
+    std::copy(rows.begin(), rows.end(), indices->asMutable<vector_size_t>());
+    std::vector<VectorPtr> children;
+    children.reserve(input->childrenSize());
+    for (const auto& child : input->children()) {
+      children.push_back(
+          BaseVector::wrapInDictionary(nullptr, indices, size, child));
+    }
+    return std::make_shared<RowVector>(
+        pool, input->type(), BufferPtr{}, size, std::move(children));
+  }
+
+  folly::SemiFuture<remote::RemoteFunctionResponse> sendRequest(
+      const RowVectorPtr& input,
+      vector_size_t offset,
+      vector_size_t size,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,15 +183,30 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = size;
     requestInputs->pageFormat_ref() = serdeFormat_;
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    const auto slice = size == input->size()
+        ? input
+        : std::static_pointer_cast<RowVector>(input->slice(offset, size));
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(slice, size, *context.pool(), serde_.get());
 
+    return thriftClient_->semifuture_invokeFunction(request);
+  }
+
+  void processResponse(
+      PendingRequest& pendingRequest,
+      const std::vector<vector_size_t>& selectedRows,
+      const TypePtr& outputType,
+      bool singleRequest,
+      exec::EvalCtx& context,
+      VectorPtr& result) const {
+    remote::RemoteFunctionResponse remoteResponse;
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      remoteResponse = std::move(pendingRequest.response)
+                           .via(&eventBase_)
+                           .getVia(&eventBase_);
     } catch (const std::exception& e) {
       VELOX_FAIL(
           "Error while executing remote function '{}' at '{}': {}",
@@ -113,12 +215,32 @@ class RemoteFunction : public exec::VectorFunction {
           e.what());
     }
 
+    // Maps a row of the response to the row of the batch.
+    const auto offset = pendingRequest.offset;
+    auto toRow = [&](vector_size_t i) {
+      return selectedRows.empty() ? offset + i : selectedRows[offset + i];
+    };
+
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.get_result().get_payload(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
+    if (singleRequest) {
+      result = outputRowVector->childAt(0);
+    } else {
+      // Copies runs of consecutive rows at a time.
+      const auto& output = outputRowVector->childAt(0);
+      vector_size_t i = 0;
+      while (i < pendingRequest.size) {
+        vector_size_t end = i + 1;
+        while (end < pendingRequest.size && toRow(end) == toRow(i) + end - i) {
+          ++end;
+        }
+        result->copy(output.get(), toRow(i), i, end - i);
+        i = end;
+      }
+    }
 
     if (auto errorPayload = remoteResponse.get_result().errorPayload()) {
       auto errorsRowVector = IOBufToRowVector(
@@ -127,15 +249,15 @@ class RemoteFunction : public exec::VectorFunction {
           errorsRowVector->childAt(0)->asFlatVector<StringView>();
       VELOX_CHECK(errorsVector, "Should be convertible to flat vector");
 
-      SelectivityVector selectedRows(errorsRowVector->size());
-      selectedRows.applyToSelected([&](vector_size_t i) {
+      SelectivityVector errorRows(errorsRowVector->size());
+      errorRows.applyToSelected([&](vector_size_t i) {
         if (errorsVector->isNullAt(i)) {
           return;
         }
         try {
           throw std::runtime_error(errorsVector->valueAt(i));
         } catch (const std::exception& ex) {
-          context.setError(i, std::current_exception());
+          context.setError(toRow(i), std::current_exception());
         }
       });
     }
@@ -144,10 +266,13 @@ class RemoteFunction : public exec::VectorFunction {
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Driven by the evaluating thread while it waits for responses.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const vector_size_t maxRowsPerRequest_;
+  const uint32_t maxInflightRequests_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
@@ -30,6 +30,15 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Maximum number of rows sent in a single request. Batches with more
+  /// selected rows are split into several requests. 0 means no limit.
+  vector_size_t maxRowsPerRequest{0};
+
+  /// Maximum number of requests for one batch that are in flight at the same
+  /// time. A new request is only sent after the oldest outstanding one has
+  /// returned if this many are pending.
+  uint32_t maxInflightRequests{1};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
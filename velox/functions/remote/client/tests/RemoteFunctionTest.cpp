@@ -88,6 +88,15 @@ class RemoteFunctionTest
                                  .build()};
     registerRemoteFunction("remote_substr", substrSignatures, metadata);
 
+    // Splits batches into requests of at most 3 rows, up to 2 in flight.
+    RemoteVectorFunctionMetadata batchedMetadata = metadata;
+    batchedMetadata.maxRowsPerRequest = 3;
+    batchedMetadata.maxInflightRequests = 2;
+    registerRemoteFunction(
+        "remote_plus_batched", plusSignatures, batchedMetadata);
+    registerRemoteFunction(
+        "remote_divide_batched", divSignatures, batchedMetadata);
+
     // Registers the actual function under a different prefix. This is only
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
@@ -98,6 +107,10 @@ class RemoteFunctionTest
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
         {remotePrefix_ + ".remote_substr"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_batched"});
+    registerFunction<CheckedDivideFunction, double, double, double>(
+        {remotePrefix_ + ".remote_divide_batched"});
   }
 
   void initializeServer() {
@@ -218,6 +231,52 @@ TEST_P(RemoteFunctionTest, tryErrorCode) {
   ASSERT_EQ(results[0]->size(), 2);
 }
 
+TEST_P(RemoteFunctionTest, batched) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(10, folly::identity)});
+  auto results =
+      evaluate<SimpleVector<int64_t>>("remote_plus_batched(c0, c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(10, [](auto row) { return row * 2; }), results);
+
+  // Only the selected rows are sent. Rows 1, 3, 5, 7 and 9 go out in two
+  // requests.
+  results = evaluate<SimpleVector<int64_t>>(
+      "if(c0 % 2 = 1, remote_plus_batched(c0, c0), -1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          10, [](auto row) -> int64_t { return row % 2 == 1 ? row * 2 : -1; }),
+      results);
+}
+
+TEST_P(RemoteFunctionTest, batchedTryException) {
+  // Errors are reported for the rows of the batch they came from.
+  auto data = makeRowVector({
+      makeFlatVector<double>(10, [](auto row) { return row * 2; }),
+      makeFlatVector<double>(10, [](auto row) { return row % 4; }),
+  });
+  auto results = evaluate<SimpleVector<double>>(
+      "try(remote_divide_batched(c0, c1))", data);
+  auto expected = makeFlatVector<double>(
+      10,
+      [](auto row) { return row % 4 == 0 ? 0 : row * 2.0 / (row % 4); },
+      [](auto row) { return row % 4 == 0; });
+  assertEqualVectors(expected, results);
+
+  results = evaluate<SimpleVector<double>>(
+      "if(c0 > 6, try(remote_divide_batched(c0, c1)), -1.0)", data);
+  expected = makeFlatVector<double>(
+      10,
+      [](auto row) {
+        return row <= 3 ? -1 : row % 4 == 0 ? 0 : row * 2.0 / (row % 4);
+      },
+      [](auto row) { return row > 3 && row % 4 == 0; });
+  assertEqualVectors(expected, results);
+
+  VELOX_ASSERT_THROW(
+      evaluate<SimpleVector<double>>("remote_divide_batched(c0, c1)", data),
+      "division by zero");
+}
+
 TEST_P(RemoteFunctionTest, connectionError) {
   auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5});
   auto func = [&]() {
@@ -420,6 +420,208 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    vector_size_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  if (size == 0) {
+    return;
+  }
+
+  const bool contiguous = decoded_.isIdentityMapping();
+  std::vector<vector_size_t> indices(size);
+  for (auto row = 0; row < size; ++row) {
+    indices[row] = decoded_.index(offset + row);
+  }
+
+  // Position of the next field in each row. Fixed-width fields are at the same
+  // distance from the previous variable-width field in all rows, hence,
+  // 'positions' are advanced only after writing a variable-width field and
+  // 'fixedBytes' accumulates widths of fixed-width fields in between.
+  std::vector<size_t> positions(size);
+  for (auto row = 0; row < size; ++row) {
+    positions[row] = bufferOffsets[row] + rowNullBytes_;
+  }
+  int32_t fixedBytes = 0;
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidthColumn(
+          i,
+          indices.data(),
+          size,
+          contiguous,
+          bufferOffsets,
+          positions.data(),
+          fixedBytes,
+          buffer);
+      fixedBytes += child.valueBytes_;
+      continue;
+    }
+
+    for (auto row = 0; row < size; ++row) {
+      positions[row] += fixedBytes;
+      if (child.isNullAt(indices[row])) {
+        bits::setBit(
+            reinterpret_cast<uint8_t*>(buffer + bufferOffsets[row]), i, true);
+      } else {
+        positions[row] += child.serializeVariableWidth(
+            indices[row], buffer + positions[row]);
+      }
+    }
+    fixedBytes = 0;
+  }
+}
+
+void CompactRow::serializeFixedWidthColumn(
+    int32_t column,
+    const vector_size_t* indices,
+    vector_size_t numRows,
+    bool contiguous,
+    const size_t* bufferOffsets,
+    const size_t* positions,
+    int32_t positionOffset,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+
+  if (decoded_.mayHaveNulls()) {
+    if (contiguous) {
+      // Scan null flags a word at a time, skipping words with no nulls.
+      if (auto* nulls = decoded_.nulls()) {
+        const auto begin = indices[0];
+        bits::forEachUnsetBit(
+            nulls, begin, begin + numRows, [&](vector_size_t index) {
+              auto* rowNulls = reinterpret_cast<uint8_t*>(
+                  buffer + bufferOffsets[index - begin]);
+              bits::setBit(rowNulls, column, true);
+            });
+      }
+    } else {
+      for (auto row = 0; row < numRows; ++row) {
+        if (decoded_.isNullAt(indices[row])) {
+          bits::setBit(
+              reinterpret_cast<uint8_t*>(buffer + bufferOffsets[row]),
+              column,
+              true);
+        }
+      }
+    }
+  }
+
+  switch (valueBytes_) {
+    case 0:
+      // UNKNOWN values are always nulls.
+      break;
+    case 1:
+      if (typeKind_ == TypeKind::BOOLEAN) {
+        serializeFixedWidthValues<bool>(
+            indices, numRows, contiguous, positions, positionOffset, buffer);
+      } else {
+        serializeFixedWidthValues<int8_t>(
+            indices, numRows, contiguous, positions, positionOffset, buffer);
+      }
+      break;
+    case 2:
+      serializeFixedWidthValues<int16_t>(
+          indices, numRows, contiguous, positions, positionOffset, buffer);
+      break;
+    case 4:
+      serializeFixedWidthValues<int32_t>(
+          indices, numRows, contiguous, positions, positionOffset, buffer);
+      break;
+    case 8:
+      if (typeKind_ == TypeKind::TIMESTAMP) {
+        serializeFixedWidthValues<Timestamp>(
+            indices, numRows, contiguous, positions, positionOffset, buffer);
+      } else {
+        serializeFixedWidthValues<int64_t>(
+            indices, numRows, contiguous, positions, positionOffset, buffer);
+      }
+      break;
+    case 16:
+      serializeFixedWidthValues<int128_t>(
+          indices, numRows, contiguous, positions, positionOffset, buffer);
+      break;
+    default:
+      VELOX_UNREACHABLE("Unexpected value width: {}", valueBytes_);
+  }
+}
+
+template <typename T>
+void CompactRow::serializeFixedWidthValues(
+    const vector_size_t* indices,
+    vector_size_t numRows,
+    bool contiguous,
+    const size_t* positions,
+    int32_t positionOffset,
+    char* buffer) {
+  auto writeValue = [&](vector_size_t row, vector_size_t index) {
+    char* out = buffer + positions[row] + positionOffset;
+    if constexpr (std::is_same_v<T, bool>) {
+      *reinterpret_cast<bool*>(out) = decoded_.valueAt<bool>(index);
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      const auto micros = decoded_.valueAt<Timestamp>(index).toMicros();
+      memcpy(out, &micros, sizeof(int64_t));
+    } else {
+      // Fixed-size memcpy compiles to a single load and store.
+      const auto value = decoded_.valueAt<T>(index);
+      memcpy(out, &value, sizeof(T));
+    }
+  };
+
+  if (!decoded_.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      writeValue(row, indices[row]);
+    }
+    return;
+  }
+
+  if (contiguous) {
+    if (auto* nulls = decoded_.nulls()) {
+      const auto begin = indices[0];
+      bits::forEachSetBit(
+          nulls, begin, begin + numRows, [&](vector_size_t index) {
+            writeValue(index - begin, index);
+          });
+      return;
+    }
+  }
+
+  for (auto row = 0; row < numRows; ++row) {
+    if (!decoded_.isNullAt(indices[row])) {
+      writeValue(row, indices[row]);
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -528,10 +730,24 @@ VectorPtr deserializeFixedWidth(
 
   auto* rawNulls = nulls->as<uint64_t>();
 
-  for (auto i = 0; i < numRows; ++i) {
-    const bool isNull = bits::isBitNull(rawNulls, i);
-    readFixedWidthValue<T>(
-        isNull, data[i].data() + offsets[i], flatVector.get(), i);
+  if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, Timestamp>) {
+    for (auto i = 0; i < numRows; ++i) {
+      const bool isNull = bits::isBitNull(rawNulls, i);
+      readFixedWidthValue<T>(
+          isNull, data[i].data() + offsets[i], flatVector.get(), i);
+    }
+  } else {
+    // Values are stored in native layout. Copy them straight into the values
+    // buffer and attach the nulls only if there are any.
+    auto* rawValues = flatVector->mutableRawValues();
+    for (auto i = 0; i < numRows; ++i) {
+      if (!bits::isBitNull(rawNulls, i)) {
+        memcpy(&rawValues[i], data[i].data() + offsets[i], sizeof(T));
+      }
+    }
+    if (!bits::isAllSet(rawNulls, 0, numRows, bits::kNotNull)) {
+      flatVector->setNulls(nulls);
+    }
   }
 
   return flatVector;
@@ -36,6 +36,21 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Computes serialized sizes of rows in [offset, offset + size) and stores
+  /// them in 'sizes'. Walks one column at a time, which is cheaper than
+  /// calling 'rowSize' for each row of a wide row type.
+  void rowSizes(vector_size_t offset, vector_size_t size, vector_size_t* sizes);
+
+  /// Serializes rows in [offset, offset + size) one column at a time. Row
+  /// 'offset + i' is written at 'buffer + bufferOffsets[i]'. The row buffers
+  /// must be pre-sized using 'rowSizes' and set to all zeros. Produces the
+  /// same bytes as calling 'serialize' for each row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -64,6 +79,31 @@ class CompactRow {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes null flags and fixed-width values for 'numRows' rows of a single
+  /// column. 'indices' are the row numbers in this vector. Null flags are set
+  /// at bit 'column' of 'buffer + bufferOffsets[i]'. Values are written at
+  /// 'buffer + positions[i] + positionOffset'. If 'contiguous' is true,
+  /// 'indices' are consecutive starting at indices[0], which allows null flags
+  /// to be processed a word at a time.
+  void serializeFixedWidthColumn(
+      int32_t column,
+      const vector_size_t* indices,
+      vector_size_t numRows,
+      bool contiguous,
+      const size_t* bufferOffsets,
+      const size_t* positions,
+      int32_t positionOffset,
+      char* buffer);
+
+  template <typename T>
+  void serializeFixedWidthValues(
+      const vector_size_t* indices,
+      vector_size_t numRows,
+      bool contiguous,
+      const size_t* positions,
+      int32_t positionOffset,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
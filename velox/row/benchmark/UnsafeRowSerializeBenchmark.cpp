@@ -65,6 +65,28 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    const auto numRows = data->size();
+    std::vector<vector_size_t> sizes(numRows);
+    compact.rowSizes(0, numRows, sizes.data());
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    compact.serialize(0, numRows, offsets.data(), buffer->asMutable<char>());
+    folly::doNotOptimizeAway(buffer->as<char>());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -205,35 +227,40 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)       \
+  BENCHMARK(unsafe_serialize_##name) {        \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafe(rowType);       \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_##name) {       \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompact(rowType);      \
+  }                                           \
+                                              \
+  BENCHMARK(compact_batch_serialize_##name) { \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompactBatch(rowType); \
+  }                                           \
+                                              \
+  BENCHMARK(container_serialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeContainer(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_deserialize_##name) {      \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeUnsafe(rowType);     \
+  }                                           \
+                                              \
+  BENCHMARK(compact_deserialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeCompact(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(container_deserialize_##name) {   \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeContainer(rowType);  \
   }
 
 SERDE_BENCHMARKS(
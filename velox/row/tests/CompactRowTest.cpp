@@ -78,6 +78,33 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    testBatchSerialize(data, row, buffer);
+  }
+
+  // Verifies that column-at-a-time serialization produces the same sizes and
+  // bytes as serializing one row at a time into 'expected'.
+  void testBatchSerialize(
+      const RowVectorPtr& data,
+      CompactRow& row,
+      const BufferPtr& expected) {
+    const auto numRows = data->size();
+
+    std::vector<vector_size_t> sizes(numRows);
+    row.rowSizes(0, numRows, sizes.data());
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(sizes[i], row.rowSize(i)) << "Row " << i;
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+    ASSERT_EQ(totalSize, expected->size());
+
+    BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(0, numRows, offsets.data(), buffer->asMutable<char>());
+    ASSERT_EQ(0, memcmp(buffer->as<char>(), expected->as<char>(), totalSize));
   }
 };
 
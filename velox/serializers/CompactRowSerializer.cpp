@@ -41,20 +41,31 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
       Scratch& scratch) override {
     size_t totalSize = 0;
     row::CompactRow row(vector);
+
+    // Compute sizes of all rows first, then write one column at a time into
+    // the pre-sized row buffers.
+    vector_size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    rowSizes_.resize(numRows);
     if (auto fixedRowSize =
             row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
+      std::fill(rowSizes_.begin(), rowSizes_.end(), fixedRowSize.value());
     } else {
+      vector_size_t index = 0;
       for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
-        }
+        row.rowSizes(range.begin, range.size, rowSizes_.data() + index);
+        index += range.size;
       }
     }
 
+    rowOffsets_.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rowOffsets_[i] = totalSize + sizeof(TRowSize);
+      totalSize += rowSizes_[i] + sizeof(TRowSize);
+    }
+
     if (totalSize == 0) {
       return;
     }
@@ -63,16 +74,18 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write raw sizes. Need to be in big endian order.
+    for (auto i = 0; i < numRows; ++i) {
+      *(TRowSize*)(rawBuffer + rowOffsets_[i] - sizeof(TRowSize)) =
+          folly::Endian::big<TRowSize>(rowSizes_[i]);
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data.
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      row.serialize(
+          range.begin, range.size, rowOffsets_.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -94,6 +107,11 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
  private:
   memory::MemoryPool* const pool_;
   std::vector<BufferPtr> buffers_;
+
+  // Scratch space for sizes and buffer offsets of rows being appended. Reused
+  // across calls to 'append'.
+  std::vector<vector_size_t> rowSizes_;
+  std::vector<size_t> rowOffsets_;
 };
 
 // Read from the stream until the full row is concatenated.
@@ -23,6 +23,7 @@
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DictionaryVector.h"
@@ -3921,6 +3922,125 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
   SerdeOpts opts_;
 };
 
+// Chooses the codec for each page written by PrestoIterativeVectorSerializer
+// when PrestoOptions::adaptiveCompression is set. Keeps moving averages of the
+// compression ratio and CPU time per input byte for each candidate codec and
+// picks the one with the lowest estimated cost of CPU time plus bytes shipped.
+// Every kExplorePeriod pages one of the other candidates is tried so that the
+// estimates follow changes in the data.
+class AdaptiveCodecSelector {
+ public:
+  struct Candidate {
+    // Name used in runtime stats.
+    std::string name;
+    std::unique_ptr<folly::io::Codec> codec;
+    // Moving average of compressed / uncompressed size.
+    double ratio{1};
+    // Moving average of CPU time per uncompressed byte.
+    double nanosPerByte{0};
+    int64_t numPages{0};
+    int64_t inputBytes{0};
+    int64_t outputBytes{0};
+  };
+
+  explicit AdaptiveCodecSelector(float shipNanosPerByte)
+      : shipNanosPerByte_{shipNanosPerByte} {
+    addCandidate("none", folly::io::CodecType::NO_COMPRESSION);
+    addCandidate("lz4", folly::io::CodecType::LZ4_FRAME);
+    addCandidate("zstd1", folly::io::CodecType::ZSTD, 1);
+    addCandidate("zstd3", folly::io::CodecType::ZSTD, 3);
+  }
+
+  /// Returns the index of the candidate to use for the next page.
+  int32_t next() {
+    ++numPages_;
+    // Try every candidate once before relying on the estimates.
+    for (auto i = 0; i < candidates_.size(); ++i) {
+      if (candidates_[i].numPages == 0) {
+        return i;
+      }
+    }
+
+    const auto best = bestCandidate();
+    if (numPages_ % kExplorePeriod != 0 || candidates_.size() == 1) {
+      return best;
+    }
+    explore_ = (explore_ + 1) % candidates_.size();
+    if (explore_ == best) {
+      explore_ = (explore_ + 1) % candidates_.size();
+    }
+    return explore_;
+  }
+
+  /// Records the outcome of writing a page with candidate 'index'.
+  void update(
+      int32_t index,
+      int64_t inputBytes,
+      int64_t outputBytes,
+      uint64_t nanos) {
+    if (inputBytes == 0) {
+      return;
+    }
+    auto& candidate = candidates_[index];
+    const double ratio = static_cast<double>(outputBytes) / inputBytes;
+    const double nanosPerByte = static_cast<double>(nanos) / inputBytes;
+    if (candidate.numPages == 0) {
+      candidate.ratio = ratio;
+      candidate.nanosPerByte = nanosPerByte;
+    } else {
+      candidate.ratio += kDecay * (ratio - candidate.ratio);
+      candidate.nanosPerByte +=
+          kDecay * (nanosPerByte - candidate.nanosPerByte);
+    }
+    ++candidate.numPages;
+    candidate.inputBytes += inputBytes;
+    candidate.outputBytes += outputBytes;
+  }
+
+  Candidate& candidateAt(int32_t index) {
+    return candidates_[index];
+  }
+
+  const std::vector<Candidate>& candidates() const {
+    return candidates_;
+  }
+
+ private:
+  static constexpr int32_t kExplorePeriod = 16;
+  // Weight of the most recent page in the moving averages.
+  static constexpr double kDecay = 0.25;
+
+  void addCandidate(
+      const std::string& name,
+      folly::io::CodecType type,
+      int level = folly::io::COMPRESSION_LEVEL_DEFAULT) {
+    if (folly::io::hasCodec(type)) {
+      candidates_.push_back({name, folly::io::getCodec(type, level)});
+    }
+  }
+
+  int32_t bestCandidate() const {
+    int32_t best = 0;
+    double bestCost = std::numeric_limits<double>::max();
+    for (auto i = 0; i < candidates_.size(); ++i) {
+      const auto& candidate = candidates_[i];
+      const double cost =
+          candidate.nanosPerByte + candidate.ratio * shipNanosPerByte_;
+      if (cost < bestCost) {
+        bestCost = cost;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  const float shipNanosPerByte_;
+  std::vector<Candidate> candidates_;
+  int64_t numPages_{0};
+  // Index of the candidate tried last when exploring.
+  int32_t explore_{0};
+};
+
 class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
  public:
   PrestoIterativeVectorSerializer(
@@ -3931,6 +4051,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       : opts_(opts),
         streamArena_(streamArena),
         codec_(common::compressionKindToCodec(opts.compressionKind)) {
+    if (opts_.adaptiveCompression) {
+      codecSelector_ = std::make_unique<AdaptiveCodecSelector>(
+          opts_.adaptiveCompressionNanosPerByte);
+    }
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3975,9 +4099,17 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       dataSize += stream->serializedSize();
     }
 
-    auto compressedSize = needCompression(*codec_)
-        ? codec_->maxCompressedLength(dataSize)
-        : dataSize;
+    size_t compressedSize = dataSize;
+    if (codecSelector_) {
+      for (const auto& candidate : codecSelector_->candidates()) {
+        if (needCompression(*candidate.codec)) {
+          compressedSize = std::max<size_t>(
+              compressedSize, candidate.codec->maxCompressedLength(dataSize));
+        }
+      }
+    } else if (needCompression(*codec_)) {
+      compressedSize = codec_->maxCompressedLength(dataSize);
+    }
     return kHeaderSize + compressedSize;
   }
 
@@ -3986,7 +4118,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // checksum(8) | data
   void flush(OutputStream* out) override {
     constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-    if (!needCompression(*codec_)) {
+    if (codecSelector_) {
+      flushAdaptive(out);
+    } else if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
           numRows_,
@@ -4032,6 +4166,25 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
          {"compressionSkippedBytes",
           RuntimeCounter(
               stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+    if (codecSelector_) {
+      map.insert(
+          {"compressionNanos",
+           RuntimeCounter(
+               stats_.compressionNanos, RuntimeCounter::Unit::kNanos)});
+      for (const auto& candidate : codecSelector_->candidates()) {
+        if (candidate.numPages == 0) {
+          continue;
+        }
+        map.insert(
+            {fmt::format("compressionInputBytes.{}", candidate.name),
+             RuntimeCounter(
+                 candidate.inputBytes, RuntimeCounter::Unit::kBytes)});
+        map.insert(
+            {fmt::format("compressedBytes.{}", candidate.name),
+             RuntimeCounter(
+                 candidate.outputBytes, RuntimeCounter::Unit::kBytes)});
+      }
+    }
     return map;
   }
 
@@ -4043,6 +4196,34 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   }
 
  private:
+  // Writes the page with the codec chosen by 'codecSelector_' and feeds the
+  // measured size and time back into it.
+  void flushAdaptive(OutputStream* out) {
+    const auto index = codecSelector_->next();
+    auto& codec = *codecSelector_->candidateAt(index).codec;
+    uint64_t nanos = 0;
+    FlushSizes sizes;
+    {
+      NanosecondTimer timer(&nanos);
+      sizes = flushStreams(
+          streams_,
+          numRows_,
+          *streamArena_,
+          codec,
+          opts_.minCompressionRatio,
+          out);
+    }
+    codecSelector_->update(
+        index, sizes.uncompressedSize, sizes.compressedSize, nanos);
+    stats_.compressionNanos += nanos;
+    if (needCompression(codec)) {
+      stats_.compressionInputBytes += sizes.uncompressedSize;
+      stats_.compressedBytes += sizes.compressedSize;
+    } else {
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
+    }
+  }
+
   struct CompressionStats {
     // Number of times compression was not attempted.
     int32_t numCompressionSkipped{0};
@@ -4056,6 +4237,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     // Bytes for which compression was not attempted because of past
     // non-performance.
     int64_t compressionSkippedBytes{0};
+
+    // Time spent flushing pages with adaptive compression.
+    uint64_t compressionNanos{0};
   };
 
   const SerdeOpts opts_;
@@ -4068,6 +4252,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
+
+  // Set if 'opts_.adaptiveCompression' is true.
+  std::unique_ptr<AdaptiveCodecSelector> codecSelector_;
 };
 } // namespace
 
@@ -4182,8 +4369,11 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
+  // With adaptive compression the codec may change from page to page. Detect
+  // it from the frame header.
+  const auto codec = prestoOptions.adaptiveCompression
+      ? folly::io::getAutoUncompressionCodec()
+      : common::compressionKindToCodec(prestoOptions.compressionKind);
   auto const header = PrestoHeader::read(source);
 
   int64_t actualCheckSum = 0;
@@ -72,6 +72,19 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// If true, the iterative serializer picks the codec for each page among
+    /// none, LZ4 and ZSTD at a few levels based on the compression ratio and
+    /// CPU time measured on recent pages. 'compressionKind' is ignored on both
+    /// sides. Pages are compressed in self-describing frames and decompressed
+    /// using codec auto-detection, hence the producer and the consumer must
+    /// both enable this option. Not understood by Presto Java workers.
+    bool adaptiveCompression{false};
+
+    /// Used with 'adaptiveCompression'. Estimated cost in nanoseconds of
+    /// shipping one byte. Weighs CPU time spent compressing a page against
+    /// the bytes saved.
+    float adaptiveCompressionNanosPerByte{1.0};
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
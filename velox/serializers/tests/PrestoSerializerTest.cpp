@@ -1511,6 +1511,54 @@ INSTANTIATE_TEST_SUITE_P(
         common::CompressionKind::CompressionKind_LZ4,
         common::CompressionKind::CompressionKind_GZIP));
 
+TEST_F(PrestoSerializerTest, adaptiveCompression) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.adaptiveCompression = true;
+
+  // Repetitive strings compress well. Every candidate codec is tried on the
+  // first pages, then the cheapest one is used with periodic exploration.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<std::string>(
+          1'000,
+          [](auto row) {
+            return fmt::format("status=OK;region=us-east-{}", row % 3);
+          }),
+  });
+  auto rowType = asRowType(data->type());
+
+  std::ostringstream output;
+  StreamArena arena(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, data->size(), &arena, &options);
+  constexpr int32_t kNumPages = 40;
+  for (auto i = 0; i < kNumPages; ++i) {
+    serializer->append(data);
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    serializer->clear();
+  }
+
+  const auto stats = serializer->runtimeStats();
+  ASSERT_EQ(stats.count("compressionNanos"), 1);
+  ASSERT_EQ(stats.count("compressionInputBytes.none"), 1);
+  ASSERT_GT(stats.at("compressionInputBytes").value, 0);
+  ASSERT_LT(
+      stats.at("compressedBytes").value,
+      stats.at("compressionInputBytes").value);
+
+  const auto input = output.str();
+  auto byteStream = toByteStream(input);
+  for (auto i = 0; i < kNumPages; ++i) {
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, &options);
+    assertEqualVectors(data, result);
+  }
+  ASSERT_TRUE(byteStream->atEnd());
+}
+
 TEST_F(PrestoSerializerTest, deserializeSingleColumn) {
   // Verify that deserializeSingleColumn API can handle all supported types.
   static const size_t kPrestoPageHeaderBytes = 21;
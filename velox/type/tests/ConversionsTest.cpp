@@ -485,6 +485,60 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
         false,
         /*expectError*/ true);
 
+    // When TRUNCATE = false, strings of 8 or more digits and values at the
+    // limits of each type.
+    testConversion<std::string, int64_t>(
+        {
+            "12345678",
+            "-123456789",
+            "123456789012345678",
+            "-123456789012345678",
+            "9223372036854775807",
+            "-9223372036854775808",
+            "00000000000000000000001",
+            " 1234567812345678 ",
+        },
+        {
+            12345678,
+            -123456789,
+            123456789012345678,
+            -123456789012345678,
+            std::numeric_limits<int64_t>::max(),
+            std::numeric_limits<int64_t>::min(),
+            1,
+            1234567812345678,
+        },
+        /*truncate*/ false);
+    testConversion<std::string, int32_t>(
+        {"2147483647", "-2147483648"},
+        {std::numeric_limits<int32_t>::max(),
+         std::numeric_limits<int32_t>::min()},
+        /*truncate*/ false);
+    testConversion<std::string, int8_t>(
+        {"127", "-128", "-0"}, {127, -128, 0}, /*truncate*/ false);
+    testConversion<std::string, int64_t>(
+        {
+            "9223372036854775808",
+            "-9223372036854775809",
+            "12345678a",
+            "1234567/9",
+            "1234:678",
+            "-",
+            "--12345678",
+        },
+        {},
+        /*truncate*/ false,
+        false,
+        /*expectError*/ true);
+    testConversion<std::string, int32_t>(
+        {"2147483648", "-2147483649"},
+        {},
+        /*truncate*/ false,
+        false,
+        /*expectError*/ true);
+    testConversion<std::string, int8_t>(
+        {"128", "-129"}, {}, /*truncate*/ false, false, /*expectError*/ true);
+
     // When TRUNCATE = true.
     testConversion<std::string, int8_t>(
         {
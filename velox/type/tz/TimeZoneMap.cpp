@@ -330,13 +330,40 @@ TimeZone::seconds TimeZone::to_sys(
     TimeZone::seconds timestamp,
     TimeZone::TChoose choose) const {
   date::local_seconds timePoint{timestamp};
-  validateRange(date::sys_seconds{timestamp});
 
   if (tz_ == nullptr) {
+    validateRange(date::sys_seconds{timestamp});
     // We can ignore `choose` as time offset conversions are always linear.
     return (timePoint - offset_).time_since_epoch();
   }
 
+  const auto& table = transitions();
+  const int64_t local = timestamp.count();
+  if (local - table.maxAbsOffset >= kTransitionsBegin &&
+      local + table.maxAbsOffset < table.end) {
+    // A matching UTC time is at most 'maxAbsOffset' away from 'local'. It is
+    // ambiguous if two eras match and nonexistent if none does.
+    const auto first = table.find(local - table.maxAbsOffset);
+    const auto last = table.find(local + table.maxAbsOffset);
+    int64_t sys = 0;
+    int32_t numMatches = 0;
+    for (auto i = first; i <= last; ++i) {
+      const int64_t candidate = local - table.offsets[i];
+      const int64_t end =
+          i + 1 < table.begins.size() ? table.begins[i + 1] : table.end;
+      if (candidate >= table.begins[i] && candidate < end) {
+        if (numMatches == 0 || choose == TChoose::kLatest) {
+          sys = candidate;
+        }
+        ++numMatches;
+      }
+    }
+    if (numMatches == 1 || (numMatches > 1 && choose != TChoose::kFail)) {
+      return seconds(sys);
+    }
+  }
+
+  validateRange(date::sys_seconds{timestamp});
   if (choose == TimeZone::TChoose::kFail) {
     // By default, throws.
     return date::zoned_time{tz_, timePoint}.get_sys_time().time_since_epoch();
@@ -352,13 +379,67 @@ TimeZone::seconds TimeZone::to_sys(
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
   date::sys_seconds timePoint{timestamp};
-  validateRange(timePoint);
 
   // If this is an offset time zone.
   if (tz_ == nullptr) {
+    validateRange(timePoint);
     return (timePoint + offset_).time_since_epoch();
   }
+
+  const auto& table = transitions();
+  const int64_t sys = timestamp.count();
+  if (sys >= kTransitionsBegin && sys < table.end) {
+    return seconds(sys + table.offsets[table.find(sys)]);
+  }
+
+  validateRange(timePoint);
   return date::zoned_time{tz_, timePoint}.get_local_time().time_since_epoch();
 }
 
+const TimeZone::Transitions& TimeZone::transitions() const {
+  folly::call_once(transitionsOnce_, [&]() {
+    auto& table = transitions_;
+    date::sys_info info;
+    try {
+      info = tz_->get_info(date::sys_seconds{seconds{kTransitionsBegin}});
+    } catch (const std::invalid_argument&) {
+      // Leaves the table empty. All conversions go through external/date.
+      return;
+    }
+    table.begins.push_back(kTransitionsBegin);
+    table.offsets.push_back(info.offset.count());
+    table.end = std::min(info.end.time_since_epoch().count(), kTransitionsEnd);
+    while (table.end < kTransitionsEnd) {
+      try {
+        info = tz_->get_info(info.end);
+      } catch (const std::invalid_argument&) {
+        // The database doesn't cover times past 'end'.
+        break;
+      }
+      // Eras may differ only in the abbreviation or the DST flag.
+      if (info.offset.count() != table.offsets.back()) {
+        table.begins.push_back(info.begin.time_since_epoch().count());
+        table.offsets.push_back(info.offset.count());
+      }
+      table.end =
+          std::min(info.end.time_since_epoch().count(), kTransitionsEnd);
+    }
+    for (auto offset : table.offsets) {
+      table.maxAbsOffset = std::max(table.maxAbsOffset, std::abs(offset));
+    }
+    VELOX_CHECK_LE(
+        table.begins.size(), std::numeric_limits<uint16_t>::max() + 1);
+    uint16_t index = 0;
+    for (int64_t start = kTransitionsBegin; start < table.end;
+         start += int64_t{1} << Transitions::kBucketBits) {
+      while (index + 1 < table.begins.size() &&
+             table.begins[index + 1] <= start) {
+        ++index;
+      }
+      table.buckets.push_back(index);
+    }
+  });
+  return transitions_;
+}
+
 } // namespace facebook::velox::tz
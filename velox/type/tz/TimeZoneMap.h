@@ -17,7 +17,11 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+#include <folly/synchronization/CallOnce.h>
 
 namespace facebook::velox::date {
 class time_zone;
@@ -139,6 +143,14 @@ class TimeZone {
   /// susceptible to the error above.
   seconds to_local(seconds timestamp) const;
 
+  /// Both conversions use a table of the offset changes between
+  /// [kTransitionsBegin, kTransitionsEnd) UTC for named time zones, built on
+  /// first use. Timestamps outside of the range covered by the table,
+  /// nonexistent local times and, with TChoose::kFail, ambiguous local times go
+  /// through external/date.
+  static constexpr int64_t kTransitionsBegin{0}; // 1970-01-01
+  static constexpr int64_t kTransitionsEnd{4'102'444'800}; // 2100-01-01
+
   const std::string& name() const {
     return timeZoneName_;
   }
@@ -152,10 +164,47 @@ class TimeZone {
   }
 
  private:
+  // The UTC offsets of a named time zone in [kTransitionsBegin,
+  // kTransitionsEnd).
+  struct Transitions {
+    // Sorted UTC seconds at which 'offsets' change. The first entry is
+    // kTransitionsBegin.
+    std::vector<int64_t> begins;
+    // Offset in seconds from begins[i] until begins[i + 1] or 'end'.
+    std::vector<int64_t> offsets;
+    // End of the last era. Less than kTransitionsEnd if the time zone database
+    // doesn't cover the whole range, e.g. tzdata files that end in 2037.
+    int64_t end{kTransitionsBegin};
+    // Largest absolute value in 'offsets'.
+    int64_t maxAbsOffset{0};
+    // Index into 'begins' of the era containing the start of each
+    // 2^kBucketBits seconds long interval since kTransitionsBegin. Allows
+    // finding the era of a time with a lookup and a few comparisons.
+    std::vector<uint16_t> buckets;
+
+    // About 12 days, which leaves at most one transition in most buckets.
+    static constexpr int32_t kBucketBits{20};
+
+    // Returns the index into 'begins' of the era containing 'seconds', which
+    // must be in [kTransitionsBegin, end).
+    size_t find(int64_t seconds) const {
+      size_t index = buckets[(seconds - kTransitionsBegin) >> kBucketBits];
+      while (index + 1 < begins.size() && begins[index + 1] <= seconds) {
+        ++index;
+      }
+      return index;
+    }
+  };
+
+  const Transitions& transitions() const;
+
   const date::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable folly::once_flag transitionsOnce_;
+  mutable Transitions transitions_;
 };
 
 } // namespace facebook::velox::tz
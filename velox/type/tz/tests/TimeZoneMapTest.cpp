@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -152,6 +153,116 @@ TEST(TimeZoneMapTest, timePointBoundary) {
   VELOX_ASSERT_THROW(tz->to_sys(seconds{-1096193779200l - 86400l}), expected);
 }
 
+TEST(TimeZoneMapTest, transitions) {
+  // Converts 'ts' like to_sys() and to_local() did before the transition
+  // table, using external/date directly.
+  auto expectedToSys = [](const TimeZone* tz,
+                          seconds ts,
+                          TimeZone::TChoose choose) -> std::optional<int64_t> {
+    const date::local_seconds timePoint{ts};
+    try {
+      switch (choose) {
+        case TimeZone::TChoose::kFail:
+          return date::zoned_time{tz->tz(), timePoint}
+              .get_sys_time()
+              .time_since_epoch()
+              .count();
+        case TimeZone::TChoose::kEarliest:
+          return date::zoned_time{tz->tz(), timePoint, date::choose::earliest}
+              .get_sys_time()
+              .time_since_epoch()
+              .count();
+        case TimeZone::TChoose::kLatest:
+          return date::zoned_time{tz->tz(), timePoint, date::choose::latest}
+              .get_sys_time()
+              .time_since_epoch()
+              .count();
+      }
+    } catch (const std::exception&) {
+    }
+    return std::nullopt;
+  };
+
+  auto toSys = [](const TimeZone* tz,
+                  seconds ts,
+                  TimeZone::TChoose choose) -> std::optional<int64_t> {
+    try {
+      return tz->to_sys(ts, choose).count();
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  };
+
+  auto toLocal = [](const TimeZone* tz,
+                    seconds ts) -> std::optional<int64_t> {
+    try {
+      return tz->to_local(ts).count();
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  };
+
+  auto expectedToLocal = [](const TimeZone* tz,
+                            seconds ts) -> std::optional<int64_t> {
+    try {
+      return date::zoned_time{tz->tz(), date::sys_seconds{ts}}
+          .get_local_time()
+          .time_since_epoch()
+          .count();
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  };
+
+  // Zones with DST, half hour and 30 minute DST offsets, a date line change
+  // and no transitions after 1970.
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "America/St_Johns",
+        "Pacific/Apia",
+        "America/Sao_Paulo",
+        "Asia/Kolkata",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    ASSERT_NE(tz, nullptr);
+
+    // Checks times around each transition and the ends of the table.
+    std::vector<int64_t> times = {
+        TimeZone::kTransitionsBegin, TimeZone::kTransitionsEnd};
+    auto info = tz->tz()->get_info(
+        date::sys_seconds{seconds{TimeZone::kTransitionsBegin}});
+    while (info.end.time_since_epoch().count() < TimeZone::kTransitionsEnd) {
+      times.push_back(info.end.time_since_epoch().count());
+      try {
+        info = tz->tz()->get_info(info.end);
+      } catch (const std::invalid_argument&) {
+        break;
+      }
+    }
+
+    for (auto time : times) {
+      for (int64_t delta = -7'200; delta <= 7'200; delta += 600) {
+        for (auto ts : {time + delta - 1, time + delta, time + delta + 1}) {
+          EXPECT_EQ(expectedToLocal(tz, seconds{ts}), toLocal(tz, seconds{ts}))
+              << ts;
+          for (auto choose :
+               {TimeZone::TChoose::kFail,
+                TimeZone::TChoose::kEarliest,
+                TimeZone::TChoose::kLatest}) {
+            EXPECT_EQ(
+                expectedToSys(tz, seconds{ts}, choose),
+                toSys(tz, seconds{ts}, choose))
+                << ts;
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(TimeZoneMapTest, getTimeZoneName) {
   EXPECT_EQ("America/Los_Angeles", getTimeZoneName(1825));
   EXPECT_EQ("Europe/Moscow", getTimeZoneName(2079));